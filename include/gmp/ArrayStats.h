@@ -0,0 +1,81 @@
+#pragma once
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QString>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <vtkType.h>
+
+class vtkDataArray;
+
+namespace gmp {
+
+// Statistics of one data array. The scalar fields describe component 0;
+// the magnitude fields describe the tuple norm (|v| for one component).
+// The "value" of a tuple, used for arg_min/arg_max, is the scalar for
+// one-component arrays and the magnitude otherwise.
+struct ArrayStats {
+  bool has_data = false;
+  int components = 0;
+  vtkIdType tuples = 0;
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  double rms = 0.0;
+  double min_mag = 0.0;
+  double max_mag = 0.0;
+  double mean_mag = 0.0;
+  double rms_mag = 0.0;
+  vtkIdType arg_min = -1;
+  vtkIdType arg_max = -1;
+  double compute_ms = 0.0;
+
+  double value_min() const { return components > 1 ? min_mag : min; }
+  double value_max() const { return components > 1 ? max_mag : max; }
+};
+
+// One fused pass over the array: dispatched on its concrete type so the
+// inner loop reads contiguous memory, and split with vtkSMPTools.
+ArrayStats ComputeArrayStats(vtkDataArray* array);
+
+// Counts of the tuple value (as for arg_min/arg_max) in `bins` equal-width
+// bins over [lo, hi]. Values outside the range and NaNs are not counted.
+struct ArrayHistogram {
+  double lo = 0.0;
+  double hi = 0.0;
+  std::vector<qint64> counts;
+  qint64 counted = 0;
+  double compute_ms = 0.0;
+};
+
+// Same dispatch and vtkSMPTools split as ComputeArrayStats, with one count
+// vector per thread merged at the end.
+ArrayHistogram ComputeArrayHistogram(vtkDataArray* array, int bins, double lo,
+                                     double hi);
+
+// Memoized ComputeArrayStats per (array key, time step). An entry is reused
+// only while it refers to the same array object and modification time, so
+// a re-read step is recomputed; steps served from the step cache are not.
+class ArrayStatsCache {
+ public:
+  const ArrayStats& get(vtkDataArray* array, const QString& key, int step);
+  void clear();
+  std::size_t size() const { return entries_.size(); }
+  qint64 hits() const { return hits_; }
+
+ private:
+  struct Entry {
+    const vtkDataArray* array = nullptr;
+    vtkMTimeType mtime = 0;
+    ArrayStats stats;
+  };
+  std::map<std::pair<QString, int>, Entry> entries_;
+  qint64 hits_ = 0;
+};
+
+}  // namespace gmp
+
+#endif
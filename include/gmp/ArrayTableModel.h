@@ -0,0 +1,67 @@
+#pragma once
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+#include <vtkType.h>
+
+class vtkDataArray;
+
+namespace gmp {
+
+// Table over a vtkDataArray without copying it: column 0 is the tuple id,
+// then one column per component and, for vectors, the magnitude. Cells are
+// formatted when the view asks for them, so memory does not grow with the
+// tuple count. Sorting keeps a row -> tuple permutation built with a
+// parallel argsort.
+class ArrayTableModel : public QAbstractTableModel {
+  Q_OBJECT
+ public:
+  explicit ArrayTableModel(QObject* parent = nullptr);
+
+  // Keeps the current sort column and order, re-sorting the new array. Does
+  // nothing when the array, key and modification time are unchanged.
+  void set_array(vtkDataArray* array, const QString& key);
+  void clear();
+
+  vtkDataArray* array() const { return array_; }
+  const QString& key() const { return key_; }
+  // Tuple shown in `row`, and the row showing `tuple` (-1 if none).
+  vtkIdType tuple_at(int row) const;
+  int row_of(vtkIdType tuple) const;
+  double last_sort_ms() const { return sort_ms_; }
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation,
+                      int role = Qt::DisplayRole) const override;
+  void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+ signals:
+  void sorted(double ms);
+
+ private:
+  double value(vtkIdType tuple, int column) const;
+  void build_order();
+
+  vtkSmartPointer<vtkDataArray> array_;
+  QString key_;
+  vtkMTimeType mtime_ = 0;
+  int components_ = 0;
+  int rows_ = 0;
+  // Column 0 (tuple id) ascending means no permutation.
+  int sort_column_ = 0;
+  Qt::SortOrder sort_order_ = Qt::AscendingOrder;
+  std::vector<vtkIdType> order_;
+  double sort_ms_ = 0.0;
+};
+
+}  // namespace gmp
+
+#endif
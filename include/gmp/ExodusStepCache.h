@@ -0,0 +1,143 @@
+#pragma once
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QObject>
+#include <QString>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+
+class QThread;
+class vtkDataObject;
+class vtkExodusIIReader;
+class vtkPolyData;
+
+namespace gmp {
+
+// Serializes Exodus file access. The HDF5 library behind netCDF-4 is not
+// guaranteed to be thread-safe, so every reader Update/UpdateInformation in
+// the process holds this lock, even on separate readers.
+std::mutex& ExodusIoMutex();
+
+// Block and array statuses of a reader, replayed onto a second reader of the
+// same file so both produce the same surface.
+struct ExodusReadSpec {
+  struct Status {
+    int type = 0;
+    int index = 0;
+    int status = 0;
+    bool operator==(const Status& o) const {
+      return type == o.type && index == o.index && status == o.status;
+    }
+  };
+  struct ArrayStatus {
+    int type = 0;
+    std::string name;
+    int status = 0;
+    bool operator==(const ArrayStatus& o) const {
+      return type == o.type && name == o.name && status == o.status;
+    }
+  };
+
+  QString path;
+  std::vector<Status> objects;
+  std::vector<ArrayStatus> arrays;
+
+  static ExodusReadSpec Capture(vtkExodusIIReader* reader,
+                                const QString& path);
+  void apply(vtkExodusIIReader* reader) const;
+  bool operator==(const ExodusReadSpec& o) const {
+    return path == o.path && objects == o.objects && arrays == o.arrays;
+  }
+  bool operator!=(const ExodusReadSpec& o) const { return !(*this == o); }
+};
+
+// Opens `spec.path` with the statuses of `spec`. The caller holds
+// ExodusIoMutex().
+vtkSmartPointer<vtkExodusIIReader> OpenExodusReader(const ExodusReadSpec& spec);
+
+// Value of the global variable `name` in a reader output, NaN if absent.
+// Globals sit on the field data of the multiblock or of its blocks,
+// depending on the VTK version. Vector globals give their magnitude.
+double ExodusGlobalValue(vtkDataObject* output, const char* name);
+
+// Reads one time step through `reader` and returns a standalone copy of its
+// surface. The caller holds ExodusIoMutex().
+vtkSmartPointer<vtkPolyData> ReadExodusSurface(vtkExodusIIReader* reader,
+                                               double time);
+
+// Bounded least-recently-used cache of Exodus surfaces per time step. A
+// background thread with its own reader prefetches steps ahead of the
+// slider's direction of travel and a few behind it. Entry sizes are the
+// whole surface, geometry included, since every step holds its own copy.
+class ExodusStepCache : public QObject {
+  Q_OBJECT
+ public:
+  explicit ExodusStepCache(QObject* parent = nullptr);
+  ~ExodusStepCache() override;
+
+  // Drops every entry and points the prefetcher at `spec` and `times`.
+  void reset(const ExodusReadSpec& spec, const std::vector<double>& times);
+  void clear();
+  void set_budget_bytes(qint64 bytes);
+  void set_prefetch_depth(int steps);
+
+  // Surface of `step`, or null on a miss. Counts towards the hit rate.
+  vtkSmartPointer<vtkPolyData> lookup(int step);
+  // Same as lookup() but leaves the hit rate and recency alone.
+  vtkSmartPointer<vtkPolyData> peek(int step) const;
+  // Stores a surface the caller read itself.
+  void insert(int step, vtkPolyData* surface);
+  // Replaces the prefetch queue with steps around `step`, favouring
+  // `direction` (+1 forward, -1 backward, 0 both ways).
+  void prefetch(int step, int direction);
+
+  QString stats_text() const;
+
+ signals:
+  void step_ready(int step);
+
+ private:
+  struct Entry {
+    vtkSmartPointer<vtkPolyData> surface;
+    qint64 bytes = 0;
+    std::list<int>::iterator lru;
+  };
+
+  void worker_loop();
+  void insert_locked(int step, vtkPolyData* surface);
+  void evict_locked();
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::map<int, Entry> entries_;
+  // Most recently used first.
+  std::list<int> lru_;
+  std::deque<int> queue_;
+  ExodusReadSpec spec_;
+  std::vector<double> times_;
+  // Bumped by reset(); the worker drops reads started for an older one.
+  std::uint64_t generation_ = 0;
+  qint64 budget_ = 1024LL * 1024 * 1024;
+  qint64 used_ = 0;
+  int depth_ = 8;
+  qint64 hits_ = 0;
+  qint64 misses_ = 0;
+  qint64 prefetched_ = 0;
+  double read_ms_total_ = 0.0;
+  qint64 reads_ = 0;
+  bool stop_ = false;
+  QThread* thread_ = nullptr;
+};
+
+}  // namespace gmp
+
+#endif
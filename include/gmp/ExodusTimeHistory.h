@@ -0,0 +1,86 @@
+#pragma once
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QObject>
+#include <QString>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vtkType.h>
+
+#include "gmp/ExodusStepCache.h"
+
+class QThread;
+
+namespace gmp {
+
+// One value per time step: a nodal or element array at a surface point or
+// cell of the viewer (as probed), or a global variable.
+struct TimeHistoryRequest {
+  enum class Source { Point, Cell, Global };
+
+  ExodusReadSpec spec;
+  std::vector<double> times;
+  Source source = Source::Point;
+  std::string array;
+  // Point or cell id on the viewer's surface; unused for globals.
+  vtkIdType id = -1;
+  QString label;
+};
+
+// Values are the scalar, or the magnitude for multi-component arrays.
+// `step_ms` is the extraction cost of each step after `setup_ms` spent
+// opening the file and locating the probed entity.
+struct TimeHistory {
+  bool ok = false;
+  QString error;
+  QString label;
+  std::vector<double> times;
+  std::vector<double> values;
+  std::vector<double> step_ms;
+  double setup_ms = 0.0;
+  double total_ms = 0.0;
+  qint64 file_bytes = 0;
+
+  QString cost_text() const;
+};
+
+// Extracts a time history in one pass on a background thread with its own
+// reader, so the viewer's reader and the UI pipeline stay on the current
+// step. Only the requested array is enabled on that reader. A probed surface
+// entity is mapped once to its block and local id through the global id
+// arrays; every later step reads the blocks without rebuilding the surface.
+class ExodusTimeHistory : public QObject {
+  Q_OBJECT
+ public:
+  explicit ExodusTimeHistory(QObject* parent = nullptr);
+  ~ExodusTimeHistory() override;
+
+  // Cancels a running pass (its result is dropped) and starts `request`.
+  void start(const TimeHistoryRequest& request);
+  void cancel();
+  // Cancels and forgets the last result, e.g. when another file is opened.
+  void clear();
+  bool running() const { return thread_ != nullptr; }
+  const TimeHistory& result() const { return result_; }
+
+ signals:
+  // Emitted from the worker thread; connect with a queued connection.
+  void progress(int done, int total);
+  void finished();
+
+ private:
+  struct Pass;
+
+  QThread* thread_ = nullptr;
+  // Bumped by start(); a finished thread from an older pass is ignored.
+  quint64 generation_ = 0;
+  std::shared_ptr<Pass> pass_;
+  TimeHistory result_;
+};
+
+}  // namespace gmp
+
+#endif
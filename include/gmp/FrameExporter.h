@@ -0,0 +1,93 @@
+#pragma once
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <vtkSmartPointer.h>
+
+#include "gmp/ExodusStepCache.h"
+
+class QThread;
+class QTimer;
+class vtkActor;
+class vtkDataSetMapper;
+class vtkRenderWindow;
+class vtkRenderer;
+class vtkScalarBarActor;
+class vtkWindowToImageFilter;
+
+namespace gmp {
+
+// Writes every time step of an Exodus result to a PNG sequence without
+// touching the on-screen view. Four stages run concurrently, joined by
+// bounded queues:
+//   read   - a thread with its own reader (or the step cache, if it already
+//            has the step),
+//   filter - a thread applying the deformation warp,
+//   render - an offscreen window on the GUI thread, since OpenGL contexts
+//            are not shared with workers,
+//   encode - a pool of PNG writers.
+class FrameExporter : public QObject {
+  Q_OBJECT
+ public:
+  // The encode queue holds two full-size frames per encoder.
+  static constexpr int kMaxEncoders = 4;
+
+  struct Options {
+    ExodusReadSpec spec;
+    std::vector<double> times;
+    QString directory;
+    QString prefix = "frame";
+    // Empty for no deformation.
+    QString warp_vector;
+    double warp_scale = 1.0;
+    int width = 800;
+    int height = 600;
+    int encoders = 2;
+  };
+
+  explicit FrameExporter(QObject* parent = nullptr);
+  ~FrameExporter() override;
+
+  // Copies camera, background, colouring and the scalar bar from the given
+  // scene; the viewer keeps using its own. `cache` may be null.
+  bool start(const Options& options, vtkRenderer* scene,
+             vtkDataSetMapper* mapper, vtkActor* actor,
+             vtkScalarBarActor* scalar_bar, ExodusStepCache* cache);
+  void cancel();
+  bool running() const { return running_; }
+
+ signals:
+  void progress(int done, int total);
+  void finished(bool ok, const QString& summary);
+
+ private:
+  struct Pipeline;
+
+  void render_tick();
+  void finish(bool ok, const QString& reason);
+  void join_workers();
+
+  std::shared_ptr<Pipeline> pipeline_;
+  std::vector<QThread*> workers_;
+  QTimer* render_timer_ = nullptr;
+  QElapsedTimer clock_;
+  bool running_ = false;
+
+  vtkSmartPointer<vtkRenderWindow> window_;
+  vtkSmartPointer<vtkRenderer> renderer_;
+  vtkSmartPointer<vtkDataSetMapper> mapper_;
+  vtkSmartPointer<vtkActor> actor_;
+  vtkSmartPointer<vtkScalarBarActor> scalar_bar_;
+  vtkSmartPointer<vtkWindowToImageFilter> grab_;
+};
+
+}  // namespace gmp
+
+#endif
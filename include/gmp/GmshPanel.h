@@ -3,9 +3,15 @@
 #include <QWidget>
 #include <QString>
 #include <QStringList>
+#include <QByteArray>
 #include <QVariantMap>
 #include <vector>
 
+#include "gmp/ImportJob.h"
+#include "gmp/MeshCache.h"
+#include "gmp/MeshJob.h"
+#include "gmp/MeshStats.h"
+
 class QCheckBox;
 class QComboBox;
 class QDoubleSpinBox;
@@ -13,8 +19,10 @@ class QSpinBox;
 class QLineEdit;
 class QPlainTextEdit;
 class QLabel;
+class QProgressBar;
 class QPushButton;
 class QTableWidget;
+class QThread;
 
 namespace gmp {
 
@@ -24,6 +32,9 @@ class GmshPanel : public QWidget {
  explicit GmshPanel(QWidget* parent = nullptr);
   ~GmshPanel() override;
 
+  // True while a mesh job runs or is queued behind a geometry import.
+  bool mesh_job_running() const;
+
  public slots:
   void generate_mesh();
   void set_mesh_generation_dim(int dim);
@@ -40,12 +51,16 @@ class GmshPanel : public QWidget {
   void boundary_groups(const QStringList& names);
   void volume_groups(const QStringList& names);
   void physical_group_selected(int dim, int tag);
+  // Emitted on the GUI thread once a mesh job ends, after mesh_written.
+  void mesh_generation_finished(bool ok);
 
  private slots:
   void on_open_geometry();
   void on_clear_model();
   void on_pick_output();
   void on_generate();
+  void on_cancel_generate();
+  void on_scaling_probe();
   void on_export_geometry();
   void on_entity_size_apply();
   void on_entity_size_clear();
@@ -68,7 +83,12 @@ class GmshPanel : public QWidget {
 
  private:
   void ensure_gmsh();
+  // Starts a background import; the model is replaced once it finishes.
   bool import_geometry(const QString& path, bool auto_mesh);
+  void on_import_job_finished();
+  void on_import_entities(int dim, const QList<int>& tags);
+  // True while any job owns gmsh; the GUI thread must not call into it.
+  bool gmsh_busy() const;
   void update_entity_summary();
   void update_entity_list();
   void update_physical_group_list();
@@ -101,6 +121,16 @@ class GmshPanel : public QWidget {
   std::vector<std::pair<int, int>> resolve_occ_dim_tags(
       int dim_filter, const std::vector<DimTagToken>& tokens) const;
   void append_log(const QString& text);
+  MeshJobSpec current_mesh_job_spec() const;
+  bool start_mesh_job(const MeshJobSpec& spec);
+  void on_mesh_job_finished();
+  void start_next_probe_run();
+  void report_scaling_probe();
+  void set_mesh_job_busy(bool busy);
+  void record_model_op(const QString& op);
+  QString mesh_cache_key(const MeshJobSpec& spec) const;
+  void finish_from_mesh_cache(const MeshJobSpec& spec,
+                              const MeshCache::Entry& entry);
 
   QLineEdit* geo_path_ = nullptr;
   QLabel* entity_summary_ = nullptr;
@@ -183,9 +213,35 @@ class GmshPanel : public QWidget {
   QComboBox* algo3d_ = nullptr;
   QCheckBox* recombine_ = nullptr;
   QSpinBox* smoothing_ = nullptr;
+  QSpinBox* mesh_threads_ = nullptr;
+  QCheckBox* parallel_algorithms_ = nullptr;
+  QCheckBox* mesh_cache_enabled_ = nullptr;
+  QSpinBox* mesh_cache_limit_ = nullptr;
 
   QLineEdit* output_path_ = nullptr;
   QPlainTextEdit* log_ = nullptr;
+  QProgressBar* mesh_progress_ = nullptr;
+  QPushButton* mesh_cancel_ = nullptr;
+  std::vector<QWidget*> mesh_locked_widgets_;
+  QThread* mesh_thread_ = nullptr;
+  MeshJob* mesh_job_ = nullptr;
+  MeshJobSpec probe_spec_;
+  std::vector<int> probe_pending_;
+  std::vector<MeshJobResult> probe_results_;
+  QThread* import_thread_ = nullptr;
+  ImportJob* import_job_ = nullptr;
+  // Tags streamed by the running import, shown before the model is usable.
+  std::vector<int> import_entities_[4];
+  // A generate request (auto mesh or explicit) waiting for the import.
+  bool generate_queued_ = false;
+  // Counts and quality of the current mesh, refreshed by each mesh job.
+  MeshStatsCache mesh_stats_;
+  // Identifies the model for the mesh cache: the imported file's hash plus
+  // every edit made since.
+  QByteArray geometry_source_;
+  QStringList model_history_;
+  MeshCache mesh_cache_;
+  QString pending_cache_key_;
   QSet<QLineEdit*> entity_inputs_;
   QLineEdit* active_entity_input_ = nullptr;
   bool gmsh_ready_ = false;
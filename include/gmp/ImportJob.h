@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <cstddef>
+
+namespace gmp {
+
+struct ImportJobResult {
+  bool ok = false;
+  bool canceled = false;
+  QString error;
+  QString path;
+  // File extension plus content hash, used as the mesh cache geometry key.
+  QByteArray geometry_source;
+  int entity_counts[4] = {0, 0, 0, 0};
+};
+
+// Loads a geometry file into gmsh on a dedicated thread, like MeshJob. OCC
+// formats are imported without synchronizing, so the import and the model
+// synchronization are separate phases. Entity tags are streamed back in
+// chunks once the model is synchronized. Cancellation is honoured between
+// phases and leaves an empty model behind.
+class ImportJob : public QObject {
+  Q_OBJECT
+ public:
+  enum Phase { Hash, Read, Synchronize, Entities };
+
+  explicit ImportJob(const QString& path, QObject* parent = nullptr);
+
+  void cancel();
+  bool cancel_requested() const;
+
+  const ImportJobResult& result() const { return result_; }
+
+  static QString phase_label(int phase);
+
+ public slots:
+  void run();
+
+ signals:
+  void log_line(const QString& text);
+  void progress(int phase, int step, int total);
+  void entities_ready(int dim, const QList<int>& tags);
+  void finished();
+
+ private:
+  void drain_log();
+
+  QString path_;
+  ImportJobResult result_;
+  std::atomic<bool> cancel_{false};
+  std::size_t log_seen_ = 0;
+};
+
+}  // namespace gmp
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class QThread;
+
+namespace gmp {
+
+struct JobLogHit {
+  qint64 line = 0;
+  QString text;
+};
+
+// Log of one job. Every line is appended to a file; memory holds the last
+// `window_lines` lines plus one byte offset per line, so tail() and line()
+// cost the same however long the run is. Lines older than the window are
+// read back from the file through the offset index.
+class JobLog : public QObject {
+  Q_OBJECT
+ public:
+  JobLog(const QString& path, int window_lines, QObject* parent = nullptr);
+  ~JobLog() override;
+
+  bool is_open() const { return file_.isOpen(); }
+  QString path() const { return file_.fileName(); }
+  QString error() const { return file_.errorString(); }
+
+  void append(const QStringList& lines);
+  void append(const QString& line) { append(QStringList{line}); }
+
+  qint64 line_count() const { return static_cast<qint64>(offsets_.size()); }
+  qint64 bytes() const { return end_; }
+  QString line(qint64 index) const;
+  // `count` lines starting at `first`, clamped to the log.
+  QStringList lines(qint64 first, qint64 count) const;
+  QStringList tail(int count) const;
+
+  // Case-insensitive substring search over the whole file on a background
+  // thread; a new search cancels the previous one. At most `max_hits` hits
+  // are reported through search_finished().
+  void start_search(const QString& needle, int max_hits = 1000);
+  void cancel_search();
+
+  // Last `count` lines of a log file without an index, reading backwards
+  // from its end. For logs of earlier jobs.
+  static QStringList ReadTail(const QString& path, int count);
+
+ signals:
+  void search_finished(const QString& needle, const QVector<gmp::JobLogHit>& hits,
+                       bool truncated, double ms);
+
+ private:
+  struct Search;
+
+  QStringList read_range(qint64 first, qint64 count) const;
+
+  mutable QFile file_;
+  // Start offset of every line; line i ends at offsets_[i + 1] (or end_).
+  std::vector<qint64> offsets_;
+  qint64 end_ = 0;
+  std::deque<QString> window_;
+  std::size_t window_lines_ = 0;
+
+  QThread* search_thread_ = nullptr;
+  std::shared_ptr<Search> search_;
+};
+
+}  // namespace gmp
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QObject>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QString>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "gmp/JobLog.h"
+#include "gmp/MooseProgress.h"
+#include "gmp/RunSpec.h"
+#include "gmp/RunnerFactory.h"
+
+namespace gmp {
+
+// A run as handed to JobQueue::submit().
+struct QueuedJob {
+  RunSpec spec;
+  RunnerKind kind = RunnerKind::kLocal;
+  // Cores the run occupies while it runs (MPI ranks times threads).
+  int cores = 1;
+  // Higher starts first when the queue is in priority order.
+  int priority = 0;
+  // File the job's JobLog writes to.
+  QString log_path;
+};
+
+// Runs jobs concurrently within a core budget. Waiting jobs are ordered by
+// submission (FIFO) or by priority, then submission; the first one starts
+// as soon as its cores fit next to the running jobs. It is never
+// overtaken by narrower jobs behind it, so a wide job cannot starve. A job
+// wider than the whole budget runs once nothing else is running. Each job
+// has its own Runner, JobLog and MooseProgress; the log and progress of
+// the last few finished jobs are kept as well.
+class JobQueue : public QObject {
+  Q_OBJECT
+ public:
+  enum class Order { Fifo, Priority };
+
+  explicit JobQueue(QObject* parent = nullptr);
+  ~JobQueue() override;
+
+  void set_core_budget(int cores);
+  int core_budget() const { return budget_; }
+  void set_order(Order order);
+  Order order() const { return order_; }
+  // See Runner::set_output_watch(); applies to jobs started afterwards.
+  void set_output_watch(const QRegularExpression& pattern, int group);
+
+  // Queues `job` and returns its id. Scheduling runs from the event loop,
+  // so the caller can announce the id before job_started() arrives.
+  int submit(const QueuedJob& job);
+  // Stops a running job or drops a waiting one.
+  void cancel(int id);
+  void cancel_all();
+
+  // cancel() or cancel_all() was called while the job was running; stays
+  // set after it finishes.
+  bool cancel_requested(int id) const;
+  bool is_running(int id) const { return running_.count(id) > 0; }
+  bool is_waiting(int id) const;
+  int running_count() const { return static_cast<int>(running_.size()); }
+  int waiting_count() const { return static_cast<int>(waiting_.size()); }
+  int cores_in_use() const { return in_use_; }
+  // Ids of the running jobs, oldest first.
+  std::vector<int> running_ids() const;
+
+  // Log and parsed progress of a running or recently finished job.
+  JobLog* log(int id) const;
+  const MooseProgress* progress(int id) const;
+
+ signals:
+  void job_started(int id);
+  void job_output(int id, const gmp::OutputBatch& batch);
+  // The job's MooseProgress finished at least one more step.
+  void job_progress(int id);
+  void job_finished(int id, int exit_code, QProcess::ExitStatus status);
+  // A waiting job was cancelled before it started.
+  void job_dropped(int id);
+  // Running or waiting counts, or the cores in use, changed.
+  void load_changed();
+
+ private:
+  struct Job;
+
+  void schedule();
+  void start(std::unique_ptr<Job> job);
+  void finish(int id, int exit_code, QProcess::ExitStatus status);
+  const Job* find(int id) const;
+
+  int budget_ = 1;
+  Order order_ = Order::Fifo;
+  QRegularExpression watch_pattern_;
+  int watch_group_ = 0;
+  int next_id_ = 1;
+  int in_use_ = 0;
+  bool schedule_posted_ = false;
+  std::vector<std::unique_ptr<Job>> waiting_;
+  std::map<int, std::unique_ptr<Job>> running_;
+  std::deque<std::unique_ptr<Job>> finished_;
+};
+
+}  // namespace gmp
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <QHash>
 #include <QMainWindow>
+#include <QStringList>
 #include <QVariantMap>
+#include <memory>
+#include <vector>
 
 class QPlainTextEdit;
 class QAction;
@@ -16,6 +20,7 @@ class QString;
 class QLabel;
 class QMenu;
 class QTableWidget;
+class QTimer;
 
 namespace gmp {
 
@@ -23,11 +28,15 @@ class MoosePanel;
 class VtkViewer;
 class PropertyEditor;
 class GmshPanel;
+class PlotWidget;
+class SweepDialog;
+struct MooseStep;
 
 class MainWindow : public QMainWindow {
   Q_OBJECT
  public:
  explicit MainWindow(QWidget* parent = nullptr);
+  ~MainWindow() override;
 
  private:
   void build_menu();
@@ -67,6 +76,38 @@ class MainWindow : public QMainWindow {
   int append_job_row(const QString& name, const QVariantMap& params);
   void update_job_row(int row, const QString& name, const QVariantMap& params);
   void update_job_detail(int row);
+  // Job table row of a queued or running job; -1 when it has none.
+  int job_row(int job_id) const;
+  // Queue id of the row's job while the MOOSE panel still holds its log
+  // and progress in memory, else 0. Rows loaded from a project never match.
+  int live_job_id(int row) const;
+  void refresh_running_durations();
+  void show_job_log();
+  // Parsed solver steps of a job row: live for the running job, otherwise
+  // from the progress CSV written when it finished.
+  std::vector<MooseStep> job_progress_steps(int row) const;
+  void update_progress_plot(int row);
+  void export_job_progress();
+  // Parameter sweep: cases are prepared one at a time (tree parameters and
+  // mesh settings applied, mesh generated once per distinct mesh, input
+  // synced and written to the case directory), then queued as batch jobs,
+  // at most max_parallel at once.
+  void show_sweep_dialog();
+  QStringList sweep_targets() const;
+  // Tree item of a "<root>/<item>/<key>" target.
+  QTreeWidgetItem* sweep_item(const QString& target) const;
+  void start_sweep();
+  void cancel_sweep();
+  void prepare_sweep_cases();
+  // True while waiting for the mesh; false once `key` has a mesh or failed.
+  bool start_sweep_mesh(const QString& key, const QVariantMap& overrides);
+  void finish_sweep_preparation();
+  void dispatch_sweep_cases();
+  void on_sweep_job_started(const QVariantMap& info);
+  void on_sweep_job_finished(const QVariantMap& info);
+  void read_sweep_results(std::size_t pos);
+  void update_sweep_status();
+  void maybe_finish_sweep();
   QString build_block_from_root(QTreeWidgetItem* root,
                                 const QString& block_name,
                                 const QString& default_type,
@@ -93,6 +134,8 @@ class MainWindow : public QMainWindow {
   VtkViewer* viewer_ = nullptr;
   QTableWidget* job_table_ = nullptr;
   QPlainTextEdit* job_detail_ = nullptr;
+  QComboBox* progress_metric_ = nullptr;
+  PlotWidget* progress_plot_ = nullptr;
   QListWidget* results_list_ = nullptr;
   QPlainTextEdit* results_preview_ = nullptr;
   QComboBox* results_type_filter_ = nullptr;
@@ -110,10 +153,17 @@ class MainWindow : public QMainWindow {
   QLabel* project_status_label_ = nullptr;
   QLabel* dirty_status_label_ = nullptr;
   QLabel* workflow_status_label_ = nullptr;
-  QTreeWidgetItem* active_job_item_ = nullptr;
-  int active_job_row_ = -1;
+  // Jobs tree items of queued and running jobs by queue id.
+  QHash<int, QTreeWidgetItem*> job_items_;
+  QTimer* job_clock_ = nullptr;
   MoosePanel* moose_panel_ = nullptr;
   GmshPanel* gmsh_panel_ = nullptr;
+  struct SweepRun;
+  std::unique_ptr<SweepRun> sweep_;
+  // A sweep's own mesh job is running; its meshes stay out of the viewer,
+  // the MOOSE panel and the model tree.
+  bool sweep_meshing_ = false;
+  SweepDialog* sweep_dialog_ = nullptr;
 
   QMenu* recent_menu_ = nullptr;
   QAction* action_new_ = nullptr;
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <map>
+
+namespace gmp {
+
+// On-disk cache of generated .msh files keyed by a hash of the geometry
+// source and the mesh settings. Entries are evicted least recently used
+// first once the total size exceeds the limit. The index lives next to the
+// meshes as index.json.
+class MeshCache {
+ public:
+  struct Entry {
+    QString file;
+    qint64 bytes = 0;
+    qint64 last_used = 0;
+    int dim = 0;
+    QStringList boundary_names;
+    QStringList volume_names;
+  };
+
+  explicit MeshCache(const QString& dir = DefaultDir());
+
+  static QString DefaultDir();
+  // SHA-256 of a file's contents; empty when it cannot be read.
+  static QByteArray HashFile(const QString& path);
+  // Key for a model state: `geometry` identifies the source (file hash plus
+  // edit history), `settings` is the gmsh_settings() map.
+  static QString MakeKey(const QByteArray& geometry,
+                         const QVariantMap& settings);
+
+  void set_limit_bytes(qint64 limit);
+  qint64 limit_bytes() const { return limit_; }
+
+  // Counts a hit or miss. On a hit the entry becomes most recently used and
+  // `out->file` is the absolute path of the cached mesh.
+  bool lookup(const QString& key, Entry* out);
+  // Copies `mesh_path` into the cache under `key`, then evicts to the limit.
+  bool insert(const QString& key, const QString& mesh_path, int dim,
+              const QStringList& boundary_names,
+              const QStringList& volume_names);
+  void clear();
+
+  QString stats_text() const;
+
+ private:
+  void load();
+  void save() const;
+  void evict();
+  qint64 total_bytes() const;
+
+  QString dir_;
+  qint64 limit_ = 1024LL * 1024 * 1024;
+  std::map<QString, Entry> entries_;
+  qint64 hits_ = 0;
+  qint64 misses_ = 0;
+};
+
+}  // namespace gmp
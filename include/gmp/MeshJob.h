@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "gmp/MeshStats.h"
+
+namespace gmp {
+
+// Snapshot of the Mesh panel controls taken on the GUI thread. The job never
+// touches widgets.
+struct MeshJobSpec {
+  bool build_sample_box = false;
+  double size_x = 1.0;
+  double size_y = 1.0;
+  double size_z = 1.0;
+  double mesh_size = 0.2;
+  int requested_dim = -1;
+  int order = 1;
+  int msh_version = 2;
+  int high_order_opt = 0;
+  int algo2d = 2;
+  int algo3d = 1;
+  bool recombine = false;
+  int smoothing = 10;
+  bool optimize = false;
+  // Drives General.NumThreads and Mesh.MaxNumThreads1D/2D/3D.
+  int num_threads = 1;
+  // With num_threads > 1, swap serial algorithms for thread-capable ones.
+  bool prefer_parallel_algorithms = true;
+  // Scaling probe run: mesh and count only, nothing is written.
+  bool probe = false;
+  QString output_path;
+};
+
+// 2D and 3D algorithms a job for `spec` meshes with: the requested ones, or
+// thread-capable replacements with prefer_parallel_algorithms and more than
+// one thread.
+std::pair<int, int> ResolveMeshAlgorithms(const MeshJobSpec& spec);
+
+struct MeshJobResult {
+  bool ok = false;
+  bool canceled = false;
+  QString error;
+  QString output_path;
+  int dim = 0;
+  bool built_sample_box = false;
+  bool probe = false;
+  int threads = 1;
+  // Wall time of the 1D..optimize phases.
+  qint64 mesh_ms = 0;
+  std::size_t node_count = 0;
+  std::size_t element_count = 0;
+  QStringList boundary_names;
+  QStringList volume_names;
+  // Per-entity counts and quality; empty for probe runs.
+  MeshStatsCache stats;
+};
+
+// Runs mesh generation on a dedicated thread. gmsh is a process-wide
+// singleton, so the owner must not call into gmsh until finished() fires.
+// Phases are 1D..dim, optimize, write and report; the gmsh log is drained
+// after each phase and cancellation is honoured between phases.
+class MeshJob : public QObject {
+  Q_OBJECT
+ public:
+  enum Phase { Setup, Mesh1D, Mesh2D, Mesh3D, Optimize, Write, Report };
+
+  explicit MeshJob(const MeshJobSpec& spec, QObject* parent = nullptr);
+
+  // Thread-safe; takes effect at the next phase boundary.
+  void cancel();
+  bool cancel_requested() const;
+
+  // Valid after finished().
+  const MeshJobResult& result() const { return result_; }
+
+  static QString phase_label(int phase);
+
+ public slots:
+  void run();
+
+ signals:
+  void log_line(const QString& text);
+  void progress(int phase, int step, int total);
+  void finished();
+
+ private:
+  void drain_log();
+
+  MeshJobSpec spec_;
+  MeshJobResult result_;
+  std::atomic<bool> cancel_{false};
+  std::size_t log_seen_ = 0;
+};
+
+}  // namespace gmp
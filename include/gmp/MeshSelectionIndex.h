@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gmp {
+
+// Sorted cell-id lists of a preview grid keyed by its integer cell arrays:
+// phys_dim, (phys_dim, phys_id), elem_type and (entity_dim, entity_tag).
+// Built once per mesh; a filter is then an intersection of a few lists
+// instead of a chain of threshold passes over the whole grid.
+class MeshSelectionIndex {
+ public:
+  using CellId = std::uint32_t;
+
+  // A negative field leaves that key unrestricted.
+  struct Query {
+    int dim = -1;
+    int phys_id = -1;
+    int elem_type = -1;
+    int entity_dim = -1;
+    int entity_tag = -1;
+    // Single cell, as stored in the cell_id array.
+    long long cell = -1;
+
+    bool unrestricted() const;
+    bool operator==(const Query& other) const;
+    bool operator!=(const Query& other) const { return !(*this == other); }
+  };
+
+  // Arrays hold one value per cell. Lists are filled with a counting sort,
+  // split over `threads` workers.
+  void build(const int* phys_dim, const int* phys_id, const int* elem_type,
+             const int* entity_dim, const int* entity_tag, std::size_t cells,
+             int threads);
+  void clear();
+
+  bool empty() const { return cells_ == 0; }
+  std::size_t cell_count() const { return cells_; }
+  std::size_t memory_bytes() const;
+
+  // Writes the ascending ids matching every restricted key of `query`.
+  // Returns false for an unrestricted query, leaving `out` empty; the caller
+  // should then use the whole grid.
+  bool select(const Query& query, std::vector<CellId>* out) const;
+
+ private:
+  // One key space stored CSR-style: ids[offsets[k]..offsets[k+1]) are the
+  // cells of keys[k], ascending.
+  struct Lists {
+    std::vector<std::int64_t> keys;
+    std::vector<std::size_t> offsets;
+    std::vector<CellId> ids;
+
+    void build(const int* a, const int* b, std::size_t cells, int threads);
+    std::pair<const CellId*, const CellId*> find(int a, int b) const;
+  };
+
+  Lists dim_;
+  Lists group_;
+  Lists type_;
+  Lists entity_;
+  std::size_t cells_ = 0;
+};
+
+}  // namespace gmp
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QString>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace gmp {
+
+// minSICN histogram: ten bins over [0, 1]; negative (inverted) elements are
+// counted separately.
+struct MeshQualityHistogram {
+  static constexpr int kBins = 10;
+
+  std::size_t count = 0;
+  std::size_t inverted = 0;
+  double min = 0.0;
+  double max = 0.0;
+  double sum = 0.0;
+  std::array<std::size_t, kBins> bins{};
+
+  void add(double q);
+  void merge(const MeshQualityHistogram& other);
+  double mean() const;
+  QString summary() const;
+  QString bins_text() const;
+};
+
+struct MeshEntityStats {
+  std::size_t element_count = 0;
+  // Empty for 0D/1D entities.
+  MeshQualityHistogram quality;
+};
+
+// Keyed by (dim, entity tag). Groups are aggregated from their entities, so
+// editing physical groups never invalidates the cache.
+using MeshStatsCache = std::map<std::pair<int, int>, MeshEntityStats>;
+
+// Element count of one entity from gmsh's per-type metadata; no element or
+// node data is fetched.
+std::size_t CountEntityElements(int dim, int tag);
+
+// Fills `cache` with counts for every meshed entity and minSICN histograms
+// for 2D/3D entities. Quality is evaluated once per element type, split
+// across `threads` gmsh tasks. Must run on the thread that owns gmsh.
+bool ComputeMeshStats(int threads, MeshStatsCache* cache,
+                      QString* error = nullptr);
+
+// Sums the cached entities of a group. Returns false when an entity is
+// missing or its cached count no longer matches the current mesh.
+bool AggregateGroupStats(const MeshStatsCache& cache, int dim,
+                         const std::vector<int>& entity_tags,
+                         MeshEntityStats* out);
+
+}  // namespace gmp
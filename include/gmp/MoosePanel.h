@@ -8,11 +8,13 @@
 #include <QVariantMap>
 #include <QMap>
 
+#include "gmp/JobQueue.h"
 #include "gmp/Runner.h"
 #include "gmp/RunnerFactory.h"
 
 class QCheckBox;
 class QComboBox;
+class QLabel;
 class QLineEdit;
 class QPlainTextEdit;
 class QPushButton;
@@ -26,11 +28,31 @@ class MoosePanel : public QWidget {
   explicit MoosePanel(QWidget* parent = nullptr);
   ~MoosePanel() override = default;
 
+  // Log and parsed solver steps of a running or recently finished job;
+  // null for unknown ids.
+  JobLog* job_log(int id) const { return queue_->log(id); }
+  const MooseProgress* progress(int id) const { return queue_->progress(id); }
+  // Job whose output the panel's log view shows; 0 before the first run.
+  int followed_job() const { return followed_job_; }
+  bool is_job_active(int id) const {
+    return queue_->is_running(id) || queue_->is_waiting(id);
+  }
+  // Queues an existing input file with the panel's executable, MPI and
+  // runner settings, running in `workdir`. `extra_info` is merged into the
+  // job_queued() map; a true "batch" entry keeps the job's results out of
+  // exodus_ready(). Returns the job id, or 0 if nothing was queued.
+  int submit_input(const QString& input_path, const QString& workdir,
+                   const QVariantMap& extra_info = {});
+
  signals:
   void exodus_ready(const QString& path);
   void exodus_history(const QStringList& paths);
+  // Every job map carries its queue id under "job_id".
+  void job_queued(const QVariantMap& info);
   void job_started(const QVariantMap& info);
   void job_finished(const QVariantMap& info);
+  // MooseProgress::summary() of a running job, after each finished step.
+  void job_progress(const QVariantMap& summary);
 
  public slots:
   void set_mesh_path(const QString& path);
@@ -47,7 +69,10 @@ class MoosePanel : public QWidget {
   void set_template_by_key(const QString& key, bool apply_now = true);
   void run_job();
   void check_input();
+  // Stops the followed job.
   void stop_job();
+  void cancel_job(int id);
+  void stop_all_jobs();
   QString log_text() const;
   QString log_tail(int max_lines) const;
 
@@ -65,9 +90,10 @@ class MoosePanel : public QWidget {
 
  private:
   void append_log(const QString& text);
-  void handle_output(const QString& text);
-  void flush_output();
-  void set_running(bool running);
+  void handle_output(int id, const OutputBatch& batch);
+  void on_job_started(int id);
+  void on_job_finished(int id, int code, QProcess::ExitStatus status);
+  void update_queue_status();
   QString template_generated_mesh() const;
   QString template_file_mesh(const QString& mesh_path) const;
   QString template_tm_generated_mesh() const;
@@ -84,10 +110,13 @@ class MoosePanel : public QWidget {
   QString pick_latest_exodus(const QStringList& files) const;
   QStringList collect_exodus_files(const QStringList& dirs) const;
   void run_task(bool check_only);
+  int submit(const QString& input_path, const QString& workdir,
+             bool check_only, const QVariantMap& extra_info);
   QString upsert_block(const QString& input,
                        const QString& block_name,
                        const QString& block_text) const;
-  QString resolve_exodus_path(const QString& token) const;
+  QString resolve_exodus_path(const QString& token,
+                              const QString& workdir) const;
   void maybe_emit_exodus(const QString& path);
   void load_settings();
   void save_settings() const;
@@ -111,10 +140,18 @@ class MoosePanel : public QWidget {
   QPushButton* run_btn_ = nullptr;
   QPushButton* check_btn_ = nullptr;
   QPushButton* stop_btn_ = nullptr;
+  QPushButton* stop_all_btn_ = nullptr;
+  QLabel* output_rate_ = nullptr;
+  QSpinBox* core_budget_ = nullptr;
+  QComboBox* queue_order_ = nullptr;
+  QSpinBox* job_priority_ = nullptr;
+  QLabel* queue_status_ = nullptr;
 
-  std::unique_ptr<Runner> runner_;
+  JobQueue* queue_ = nullptr;
+  // job_queued() info of jobs not finished yet.
+  QMap<int, QVariantMap> jobs_;
+  int followed_job_ = 0;
   QStringList boundary_names_;
-  QString output_buffer_;
   QString last_exodus_;
 };
 
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <limits>
+#include <vector>
+
+namespace gmp {
+
+// One MOOSE time step (or one steady solve) as read from the console.
+struct MooseStep {
+  int step = 0;
+  double time = std::numeric_limits<double>::quiet_NaN();
+  double dt = std::numeric_limits<double>::quiet_NaN();
+  int nonlinear_its = 0;
+  int linear_its = 0;
+  double initial_residual = std::numeric_limits<double>::quiet_NaN();
+  double final_residual = std::numeric_limits<double>::quiet_NaN();
+  // From the step header to its convergence line, as the output arrived.
+  double wall_s = std::numeric_limits<double>::quiet_NaN();
+  bool converged = false;
+};
+
+// Incremental parser for MOOSE console output. Lines are fed in order as
+// the runner delivers them; each finished step ("Solve Converged!" or
+// "Solve Did NOT Converge!") becomes one MooseStep. Only lines whose first
+// character can start a recognised message are looked at further, so the
+// cost per line is a few character compares for ordinary output.
+class MooseProgress {
+ public:
+  void clear();
+  // True when at least one step finished during this call.
+  bool feed(const QStringList& lines);
+
+  const std::vector<MooseStep>& steps() const { return steps_; }
+  // "steps", "failed_steps", "steps_per_s", "avg_nl_its", "avg_linear_its"
+  // and "last_residual", in the key/value form job params use.
+  QVariantMap summary() const;
+
+  static bool WriteCsv(const std::vector<MooseStep>& steps, const QString& path,
+                       QString* error = nullptr);
+  static std::vector<MooseStep> ReadCsv(const QString& path);
+
+ private:
+  void feed_line(const QString& raw);
+  void open_step(int step);
+  void close_step(bool converged);
+
+  std::vector<MooseStep> steps_;
+  MooseStep current_;
+  bool open_ = false;
+  bool finished_ = false;
+  QElapsedTimer clock_;
+  qint64 first_step_ms_ = -1;
+  qint64 step_start_ms_ = 0;
+  qint64 last_close_ms_ = 0;
+};
+
+}  // namespace gmp
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <QString>
+
+namespace gmp {
+
+struct MshElementType {
+  int type = 0;
+  int dim = 0;
+  int num_nodes = 0;
+  int num_primary = 0;
+  const char* name = "";
+};
+
+// Static properties of the gmsh element types the reader understands.
+// Returns false for types outside the table.
+bool LookupMshElementType(int type, MshElementType* info);
+
+struct MshFileFormat {
+  double version = 0.0;
+  bool binary = false;
+  int data_size = 8;
+};
+
+// One run of elements sharing entity, type and physical tag. `nodes` holds
+// `count * type.num_nodes` gmsh node tags.
+struct MshElementBlock {
+  int entity_dim = 0;
+  int entity_tag = 0;
+  int phys_id = 0;
+  MshElementType type;
+  const std::size_t* tags = nullptr;
+  const std::size_t* nodes = nullptr;
+  std::size_t count = 0;
+};
+
+// Receives sections in file order. Pointers passed to the callbacks are only
+// valid for the duration of the call.
+class MshVisitor {
+ public:
+  virtual ~MshVisitor() = default;
+
+  virtual void format(const MshFileFormat& fmt) { (void)fmt; }
+  virtual void physical_name(int dim, int tag, const QString& name) {
+    (void)dim;
+    (void)tag;
+    (void)name;
+  }
+  virtual void entity(int dim, int tag, const std::vector<int>& phys_tags) {
+    (void)dim;
+    (void)tag;
+    (void)phys_tags;
+  }
+  virtual void nodes_begin(std::size_t total) { (void)total; }
+  virtual void node_block(const std::size_t* tags, const double* xyz,
+                          std::size_t count) {
+    (void)tags;
+    (void)xyz;
+    (void)count;
+  }
+  virtual void elements_begin(std::size_t total) { (void)total; }
+  virtual void element_block(const MshElementBlock& block) { (void)block; }
+};
+
+struct MshReadOptions {
+  // When false, only the format, physical names and (MSH 4) entities are
+  // reported. $Nodes/$Elements are skipped, and parsing stops as soon as
+  // those header sections have been seen.
+  bool read_mesh = true;
+};
+
+struct MshPhysicalGroup {
+  int dim = 0;
+  int tag = 0;
+  QString name;
+};
+
+struct MshHeaderInfo {
+  MshFileFormat format;
+  // Named groups plus any group referenced from $Entities, sorted by
+  // (dim, tag).
+  std::vector<MshPhysicalGroup> physical_groups;
+  // Highest entity dimension from $Entities, or -1 when the file has none
+  // (MSH 2).
+  int max_entity_dim = -1;
+};
+
+// Returns the physical names and entity dimensions of a mesh file. The scan
+// jumps over $Nodes/$Elements using their declared sizes where the format
+// allows and stops once the header sections are known. Results are cached
+// per path and invalidated when the file size or mtime changes.
+bool ScanMshHeader(const QString& path, MshHeaderInfo* info,
+                   QString* error = nullptr);
+
+// Streams a Gmsh MSH 2.2 or 4.1 file (ASCII or binary) through `visitor`
+// without touching the gmsh API. The file is memory-mapped.
+bool ReadMsh(const QString& path, MshVisitor& visitor,
+             const MshReadOptions& options = MshReadOptions(),
+             QString* error = nullptr);
+
+}  // namespace gmp
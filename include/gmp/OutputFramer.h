@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTimer>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class QIODevice;
+
+namespace gmp {
+
+// Lines framed since the previous batch. `lines` are trimmed and non-empty;
+// `matches` holds the watch-pattern captures found in them, in order.
+struct OutputBatch {
+  QStringList lines;
+  QStringList matches;
+  qint64 total_lines = 0;
+  double lines_per_second = 0.0;
+};
+
+// Turns a process output stream into batches of lines. Bytes are read from
+// the device straight into a fixed ring buffer on the owner's thread; a
+// worker thread splits them into lines, decodes UTF-8 and runs the watch
+// pattern, so the owner's thread only copies bytes and appends batches. A
+// timer delivers at most one batch per interval. When the ring is full the
+// rest stays in the device until the worker catches up.
+class OutputFramer : public QObject {
+  Q_OBJECT
+ public:
+  explicit OutputFramer(QObject* parent = nullptr);
+  ~OutputFramer() override;
+
+  // Lines matching `pattern` report capture `group` in OutputBatch::matches.
+  // Set before attach().
+  void set_watch_pattern(const QRegularExpression& pattern, int group);
+  // Reads `device` on readyRead until flush().
+  void attach(QIODevice* device);
+  // Drains the device and the ring, frames a trailing line without a
+  // newline and delivers the final batch synchronously.
+  void flush();
+
+ signals:
+  void batch_ready(const gmp::OutputBatch& batch);
+
+ private:
+  // Copies what fits from the device into the ring; false when it is full.
+  bool pump();
+  void deliver();
+  void worker_loop();
+  // Worker side: splits one contiguous span of the ring.
+  void frame(const char* data, qint64 size, OutputBatch* out);
+  void add_line(const char* data, qint64 size, OutputBatch* out);
+
+  QIODevice* device_ = nullptr;
+  QTimer timer_;
+  std::vector<char> ring_;
+  QRegularExpression watch_;
+  int watch_group_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable drained_;
+  // Monotonic byte positions; ring index is position % ring_.size().
+  qint64 head_ = 0;
+  qint64 tail_ = 0;
+  OutputBatch pending_;
+  bool stop_ = false;
+  // Owned by the worker; read by flush() only once the ring is empty.
+  QByteArray carry_;
+
+  bool stalled_ = false;
+  qint64 total_lines_ = 0;
+  qint64 window_lines_ = 0;
+  double rate_ = 0.0;
+  QElapsedTimer rate_clock_;
+  std::thread worker_;
+};
+
+}  // namespace gmp
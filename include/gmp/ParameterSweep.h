@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <vector>
+
+namespace gmp {
+
+// One swept quantity. `target` is "<root>/<item>/<key>" for a parameter of
+// a model tree item, or "gmsh/<key>" for a GmshPanel::gmsh_settings() key.
+struct SweepFactor {
+  QString target;
+  QStringList values;
+
+  bool is_mesh() const { return target.startsWith("gmsh/"); }
+  QString key() const { return target.section('/', -1); }
+};
+
+enum class SweepDesign {
+  // Every combination of the factor values.
+  FullFactorial,
+  // Case i takes the i-th value of every factor; all lists have one length.
+  Paired,
+};
+
+struct SweepCase {
+  // 1-based, as shown and used in the case directory names.
+  int index = 0;
+  // One value per factor, in factor order.
+  QStringList values;
+  // Equal for cases whose mesh factors agree; empty without mesh factors.
+  QString mesh_key;
+  QString status;
+  int job_id = 0;
+  QString workdir;
+  QString input;
+  QString exodus;
+  // Global variable name -> final value (double).
+  QVariantMap results;
+};
+
+// "a, b, c" lists values as given; "start:stop:count" spaces `count`
+// numbers evenly from start to stop.
+QStringList ParseSweepValues(const QString& text, QString* error = nullptr);
+
+std::vector<SweepCase> ExpandSweep(const std::vector<SweepFactor>& factors,
+                                   SweepDesign design,
+                                   QString* error = nullptr);
+
+// One row per case: index, factor values, status, job, globals, Exodus file.
+bool WriteSweepCsv(const QString& path, const std::vector<SweepFactor>& factors,
+                   const QStringList& globals,
+                   const std::vector<SweepCase>& cases,
+                   QString* error = nullptr);
+
+// Values of the named global variables at the last time step of `exodus`.
+// Names missing from the file (or all of them, without the VTK viewer) are
+// looked up in the last row of the MOOSE CSV output next to it. Blocking;
+// call from a worker thread.
+QVariantMap ReadFinalGlobals(const QString& exodus, const QStringList& names,
+                             QString* error = nullptr);
+
+}  // namespace gmp
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QString>
+#include <QWidget>
+#include <vector>
+
+namespace gmp {
+
+// Minimal painter-based 2D plot for the viewer's Plot tab: either a
+// histogram or one line series with an optional vertical marker. Series
+// wider than the widget are reduced to a min/max pair per pixel column
+// before drawing, so repaint cost follows the widget width.
+class PlotWidget : public QWidget {
+  Q_OBJECT
+ public:
+  explicit PlotWidget(QWidget* parent = nullptr);
+
+  // One bar per count, spanning [lo, hi] on the x axis.
+  void set_histogram(const std::vector<qint64>& counts, double lo, double hi,
+                     const QString& title);
+  // Line through (x[i], y[i]); NaN values break the line.
+  void set_series(const std::vector<double>& x, const std::vector<double>& y,
+                  const QString& title);
+  // Vertical line at `x` on a series plot, e.g. the current time. NaN hides
+  // it.
+  void set_marker(double x);
+  // Replaces the plot with a centred message.
+  void set_message(const QString& text);
+
+  QSize sizeHint() const override;
+  QSize minimumSizeHint() const override;
+
+ protected:
+  void paintEvent(QPaintEvent* event) override;
+
+ private:
+  enum class Kind { Message, Histogram, Series };
+
+  Kind kind_ = Kind::Message;
+  QString title_;
+  QString message_;
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  double lo_ = 0.0;
+  double hi_ = 0.0;
+  double marker_;
+};
+
+}  // namespace gmp
@@ -2,7 +2,9 @@
 
 #include <QObject>
 #include <QProcess>
+#include <QRegularExpression>
 
+#include "gmp/OutputFramer.h"
 #include "gmp/RunSpec.h"
 
 namespace gmp {
@@ -16,11 +18,23 @@ class Runner : public QObject {
   virtual void start(const RunSpec& spec) = 0;
   virtual void stop() = 0;
 
+  // Output lines matching `pattern` report capture `group` in
+  // OutputBatch::matches. Call before start().
+  void set_output_watch(const QRegularExpression& pattern, int group) {
+    watch_pattern_ = pattern;
+    watch_group_ = group;
+  }
+
  signals:
   void started();
+  // Emitted after the last output batch.
   void finished(int exit_code, QProcess::ExitStatus exit_status);
-  void std_out(const QString& text);
-  void std_err(const QString& text);
+  // Complete lines of the merged stdout/stderr stream, batched.
+  void output(const gmp::OutputBatch& batch);
+
+ protected:
+  QRegularExpression watch_pattern_;
+  int watch_group_ = 0;
 };
 
 }  // namespace gmp
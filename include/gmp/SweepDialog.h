@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QDialog>
+#include <QStringList>
+#include <vector>
+
+#include "gmp/ParameterSweep.h"
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QSpinBox;
+class QTableWidget;
+
+namespace gmp {
+
+// Sweep definition and results. The dialog only collects the definition
+// and shows the cases; MainWindow generates and runs them.
+class SweepDialog : public QDialog {
+  Q_OBJECT
+ public:
+  explicit SweepDialog(QWidget* parent = nullptr);
+
+  // Parameters offered in the picker ("<root>/<item>/<key>", "gmsh/<key>").
+  void set_targets(const QStringList& targets);
+  // Replaces the output directory unless the user chose one.
+  void set_default_dir(const QString& dir);
+  void set_output_dir(const QString& dir);
+
+  // Parses the factor table; empty with `error` set if a row is invalid.
+  std::vector<SweepFactor> factors(QString* error = nullptr) const;
+  SweepDesign design() const;
+  int max_parallel() const;
+  QStringList globals() const;
+  QString output_dir() const;
+
+  // One row per case: factor values, status, job, globals, Exodus file.
+  void show_cases(const std::vector<SweepFactor>& factors,
+                  const QStringList& globals,
+                  const std::vector<SweepCase>& cases);
+  void update_case(const SweepCase& c);
+  void set_status(const QString& text);
+  void set_running(bool running);
+
+ signals:
+  void start_requested();
+  void cancel_requested();
+
+ private slots:
+  void on_add_factor();
+  void on_remove_factor();
+  void on_pick_dir();
+  void on_export_csv();
+
+ private:
+  QComboBox* target_ = nullptr;
+  QLineEdit* values_ = nullptr;
+  QTableWidget* factor_table_ = nullptr;
+  QComboBox* design_ = nullptr;
+  QSpinBox* max_parallel_ = nullptr;
+  QLineEdit* globals_ = nullptr;
+  QLineEdit* dir_ = nullptr;
+  QPushButton* start_btn_ = nullptr;
+  QPushButton* cancel_btn_ = nullptr;
+  QPushButton* export_btn_ = nullptr;
+  QLabel* status_ = nullptr;
+  QTableWidget* results_ = nullptr;
+  QString default_dir_;
+
+  // What the results table shows, kept for the CSV export.
+  std::vector<SweepFactor> shown_factors_;
+  QStringList shown_globals_;
+  std::vector<SweepCase> cases_;
+};
+
+}  // namespace gmp
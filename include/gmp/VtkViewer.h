@@ -3,20 +3,22 @@
 #include <QWidget>
 #include <QString>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QSet>
 #include <QVariantMap>
 
 class QLabel;
 class QCheckBox;
 class QComboBox;
 class QDoubleSpinBox;
-class QPlainTextEdit;
 class QSlider;
 class QPushButton;
 class QTimer;
 class QSpinBox;
 class QFileSystemWatcher;
 class QListWidget;
-class QTableWidget;
+class QTableView;
+class QThread;
 
 #ifdef GMP_ENABLE_VTK_VIEWER
 class QVTKOpenGLNativeWidget;
@@ -30,7 +32,7 @@ class vtkVertexGlyphFilter;
 class vtkShrinkFilter;
 class vtkOutlineFilter;
 class vtkAxesActor;
-class vtkThreshold;
+class vtkExtractCells;
 class vtkPlane;
 class vtkCutter;
 class vtkDataSetMapper;
@@ -41,23 +43,45 @@ class vtkLookupTable;
 class vtkCellPicker;
 class vtkCallbackCommand;
 class vtkWarpVector;
+class vtkPolyData;
+class vtkTextActor;
+class vtkDataSet;
+class vtkDataArray;
+class vtkStaticCellLocator;
+class vtkStaticPointLocator;
 
 #include <vtkSmartPointer.h>
+#include <vtkType.h>
+#include <cstdint>
+#include <memory>
 #include <vector>
+
+#include "gmp/ArrayStats.h"
+#include "gmp/MeshSelectionIndex.h"
 #endif
 
 namespace gmp {
 
+class PlotWidget;
+#ifdef GMP_ENABLE_VTK_VIEWER
+class ArrayTableModel;
+class ExodusStepCache;
+class ExodusTimeHistory;
+class FrameExporter;
+#endif
+
 class VtkViewer : public QWidget {
   Q_OBJECT
  public:
   explicit VtkViewer(QWidget* parent = nullptr);
-  ~VtkViewer() override = default;
+  ~VtkViewer() override;
 
  public slots:
   void set_exodus_file(const QString& path);
   void set_exodus_history(const QStringList& paths);
   bool save_screenshot(const QString& path);
+  // Starts a background PNG-sequence export of every time step.
+  bool export_frames(const QString& directory);
   void set_mesh_file(const QString& path);
   void set_mesh_group_filter(int dim, int tag);
   void set_mesh_entity_filter(int dim, int tag);
@@ -71,6 +95,7 @@ class VtkViewer : public QWidget {
 signals:
   void mesh_group_picked(int dim, int tag);
   void mesh_entity_picked(int dim, int tag);
+  void log_message(const QString& text);
 
  private slots:
   void on_time_changed(int index);
@@ -89,6 +114,15 @@ signals:
   void refresh_time_only();
   void refresh_from_disk();
   void update_time_steps_from_reader(bool keep_index);
+  void load_time_step();
+  void read_exodus_array_info();
+  void apply_exodus_selection();
+  void update_block_list();
+  void on_block_item_changed();
+  bool sync_exodus_array_status();
+  void update_step_cache_info();
+  void set_playing(bool playing);
+  void on_play_tick();
   void populate_arrays();
   void apply_representation();
   void apply_lookup_table();
@@ -102,6 +136,11 @@ signals:
   void apply_mesh_visuals();
   void handle_pick(int x, int y);
   void update_selection_pipeline();
+  void handle_hover(int x, int y);
+  void probe_at(int x, int y);
+  void schedule_locator_build();
+  void start_locator_build();
+  void on_locator_build_finished();
   void update_scene_extras();
   void apply_view_preset(int preset);
   void update_array_list();
@@ -109,7 +148,19 @@ signals:
   void update_deformation_pipeline();
   void update_vector_tab();
   void update_plot_view();
+  // Global variables of the open file offered as time-history sources.
+  void update_history_sources();
+  void start_time_history();
+  void on_time_history_finished();
   void update_table_view();
+  // Scrolls the table to the tuple with the smallest/largest value.
+  void jump_to_table_extreme(bool maximum);
+  void schedule_lod_build();
+  void start_lod_build();
+  void on_lod_build_finished();
+  void on_render_event(bool start);
+  void set_lod_level(int level);
+  void update_lod_overlay();
 
   QString current_file_;
   QLabel* file_label_ = nullptr;
@@ -134,6 +185,7 @@ signals:
   QCheckBox* mesh_scalar_bar_ = nullptr;
   QCheckBox* pick_enable_ = nullptr;
   QComboBox* pick_mode_ = nullptr;
+  QCheckBox* pick_hover_ = nullptr;
   QPushButton* pick_clear_ = nullptr;
   QLabel* pick_info_ = nullptr;
   QCheckBox* show_axes_ = nullptr;
@@ -160,8 +212,19 @@ signals:
   QPushButton* output_pick_ = nullptr;
   QComboBox* array_filter_ = nullptr;
   QListWidget* array_list_ = nullptr;
+  QCheckBox* lazy_arrays_ = nullptr;
+  QListWidget* block_list_ = nullptr;
+  QPushButton* block_all_ = nullptr;
+  QPushButton* block_none_ = nullptr;
+  QLabel* block_info_ = nullptr;
+  // Selected Exodus blocks and sets as "E:", "N:" or "S:" plus the object
+  // name; empty means the reader defaults (all blocks, no sets).
+  QStringList exodus_selection_;
+  // Array keys ("P:name"/"C:name") that stay loaded with lazy loading on.
+  QSet<QString> pinned_arrays_;
   QCheckBox* probe_enable_ = nullptr;
   QComboBox* probe_mode_ = nullptr;
+  QCheckBox* probe_follow_ = nullptr;
   QPushButton* probe_clear_ = nullptr;
   QLabel* probe_info_ = nullptr;
   QCheckBox* deform_enable_ = nullptr;
@@ -171,17 +234,50 @@ signals:
   QCheckBox* vector_auto_sync_deform_ = nullptr;
   QPushButton* vector_apply_to_deform_ = nullptr;
   QLabel* vector_info_ = nullptr;
- QPlainTextEdit* plot_view_ = nullptr;
+  PlotWidget* plot_view_ = nullptr;
   QString cached_plot_text_;
   QString cached_plot_stats_;
+  QComboBox* plot_mode_ = nullptr;
+  QSpinBox* plot_bins_ = nullptr;
   QPushButton* plot_refresh_btn_ = nullptr;
   QLabel* plot_stats_ = nullptr;
-  QTableWidget* table_view_ = nullptr;
+  QComboBox* plot_source_ = nullptr;
+  QPushButton* plot_extract_btn_ = nullptr;
+  QLabel* plot_history_info_ = nullptr;
+  QTableView* table_view_ = nullptr;
   QString cached_table_text_;
   QString cached_table_stats_;
+  // Rows copied into the text snapshot; the view itself shows every tuple.
   QSpinBox* table_rows_spin_ = nullptr;
   QPushButton* table_refresh_btn_ = nullptr;
+  QPushButton* table_min_btn_ = nullptr;
+  QPushButton* table_max_btn_ = nullptr;
   QLabel* table_stats_ = nullptr;
+  QCheckBox* lod_enable_ = nullptr;
+  QSpinBox* lod_face_threshold_ = nullptr;
+  QDoubleSpinBox* lod_min_fps_ = nullptr;
+  QTimer* lod_timer_ = nullptr;
+  QThread* lod_thread_ = nullptr;
+  QTimer* locator_timer_ = nullptr;
+  QThread* locator_thread_ = nullptr;
+  QSpinBox* step_cache_mb_ = nullptr;
+  QSpinBox* step_prefetch_ = nullptr;
+  QLabel* step_cache_info_ = nullptr;
+  QPushButton* play_btn_ = nullptr;
+  QDoubleSpinBox* play_fps_ = nullptr;
+  QCheckBox* play_loop_ = nullptr;
+  QPushButton* export_btn_ = nullptr;
+  QLabel* play_info_ = nullptr;
+  QTimer* play_timer_ = nullptr;
+  // Playback runs on wall-clock time: frame play_origin_ + elapsed * fps is
+  // due on each tick, and frames that are not ready by then are skipped.
+  // Positions are unwrapped; the slider shows position % step count.
+  QElapsedTimer play_clock_;
+  qint64 play_origin_ = 0;
+  qint64 play_position_ = 0;
+  qint64 play_shown_ = 0;
+  qint64 play_dropped_ = 0;
+  qint64 play_last_shown_ms_ = 0;
 
 #ifdef GMP_ENABLE_VTK_VIEWER
   QVTKOpenGLNativeWidget* vtk_widget_ = nullptr;
@@ -212,22 +308,54 @@ signals:
   vtkSmartPointer<vtkRenderer> renderer_;
   vtkSmartPointer<vtkExodusIIReader> reader_;
   vtkSmartPointer<vtkCompositeDataGeometryFilter> geom_;
+  // Surface of the current time step, fed to mapper_ or warp_filter_. Filled
+  // from step_cache_ or, on a miss, from geom_.
+  vtkSmartPointer<vtkPolyData> time_surface_;
+  ExodusStepCache* step_cache_ = nullptr;
+  // Result arrays the file declares, loaded or not. With lazy loading only
+  // the colour array, the deformation vector and pinned arrays are read.
+  struct ExodusArray {
+    QString key;
+    int type = 0;
+    int index = 0;
+    int components = 1;
+  };
+  std::vector<ExodusArray> exodus_arrays_;
+  FrameExporter* exporter_ = nullptr;
+  ArrayTableModel* table_model_ = nullptr;
+  ExodusTimeHistory* history_ = nullptr;
+  // Last successful probe, the default time-history source.
+  vtkIdType probe_id_ = -1;
+  bool probe_is_point_ = true;
+  QString probe_array_;
+  int last_time_index_ = -1;
   vtkSmartPointer<vtkUnstructuredGrid> mesh_grid_;
   vtkSmartPointer<vtkDataSetSurfaceFilter> mesh_geom_;
   vtkSmartPointer<vtkShrinkFilter> mesh_shrink_filter_;
-  vtkSmartPointer<vtkThreshold> mesh_dim_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_group_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_type_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_entity_dim_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_entity_tag_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_select_dim_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_select_group_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_select_cell_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_select_entity_dim_threshold_;
-  vtkSmartPointer<vtkThreshold> mesh_select_entity_tag_threshold_;
-  vtkSmartPointer<vtkDataSetSurfaceFilter> mesh_select_geom_;
-  vtkSmartPointer<vtkDataSetMapper> mesh_select_mapper_;
-  vtkSmartPointer<vtkActor> mesh_select_actor_;
+  // Cell lists of mesh_grid_ per filter key. The combo filters are an
+  // intersection over it feeding mesh_extract_.
+  MeshSelectionIndex mesh_index_;
+  vtkSmartPointer<vtkExtractCells> mesh_extract_;
+  MeshSelectionIndex::Query mesh_filter_query_;
+  bool mesh_filter_applied_ = false;
+  // Pick and hover highlights: a shallow copy of the rendered surface whose
+  // ghost array hides every cell outside the query, drawn over actor_.
+  struct MeshHighlight {
+    vtkSmartPointer<vtkDataSet> data;
+    vtkSmartPointer<vtkDataSetMapper> mapper;
+    vtkSmartPointer<vtkActor> actor;
+    vtkDataSet* source = nullptr;
+    vtkMTimeType source_mtime = 0;
+    MeshSelectionIndex::Query query;
+    bool masked = false;
+  };
+  MeshHighlight mesh_select_;
+  MeshHighlight mesh_hover_;
+  // Re-masks `highlight` for `query` over mapper_'s current input. Returns
+  // true when something visible changed.
+  bool update_highlight(MeshHighlight* highlight,
+                        const MeshSelectionIndex::Query& query,
+                        const double color[3]);
   vtkSmartPointer<vtkPlane> mesh_slice_plane_;
   vtkSmartPointer<vtkCutter> mesh_slice_cutter_;
   vtkSmartPointer<vtkDataSetMapper> mapper_;
@@ -243,7 +371,45 @@ signals:
   vtkSmartPointer<vtkAxesActor> axes_actor_;
   vtkSmartPointer<vtkCellPicker> picker_;
   vtkSmartPointer<vtkCallbackCommand> pick_callback_;
+  vtkSmartPointer<vtkCallbackCommand> hover_callback_;
   vtkSmartPointer<vtkWarpVector> warp_filter_;
+  // Decimated proxies of the rendered surface, finest first. While the
+  // camera moves actor_ is switched to lod_mapper_ showing one of them.
+  struct LodBuild;
+  std::shared_ptr<LodBuild> lod_build_;
+  std::vector<vtkSmartPointer<vtkPolyData>> lod_levels_;
+  vtkSmartPointer<vtkPolyDataMapper> lod_mapper_;
+  vtkSmartPointer<vtkTextActor> lod_text_;
+  vtkSmartPointer<vtkCallbackCommand> render_callback_;
+  // Identity of the mapper input the proxies were built from.
+  vtkDataSet* lod_source_ = nullptr;
+  vtkMTimeType lod_source_mtime_ = 0;
+  vtkIdType lod_full_faces_ = 0;
+  double lod_full_render_s_ = 0.0;
+  double lod_last_render_s_ = 0.0;
+  int lod_level_ = 0;
+  bool lod_rebuild_pending_ = false;
+  // Point and cell locators over a snapshot of the rendered surface, built
+  // off the GUI thread. They stay valid while the geometry signature of
+  // mapper_'s input matches, e.g. across time steps without deformation.
+  struct LocatorBuild;
+  std::shared_ptr<LocatorBuild> locator_build_;
+  vtkSmartPointer<vtkStaticPointLocator> point_locator_;
+  vtkSmartPointer<vtkStaticCellLocator> cell_locator_;
+  vtkDataSet* locator_source_ = nullptr;
+  vtkMTimeType locator_source_mtime_ = 0;
+  std::uint64_t locator_signature_ = 0;
+  double locator_tolerance_ = 0.0;
+  bool locator_rebuild_pending_ = false;
+  // Cell of mapper_'s input under a display position, or -1; `pos` is the
+  // world hit point.
+  vtkIdType pick_cell(int x, int y, double pos[3]);
+  // True when the locators match mapper_'s input. Schedules a rebuild when
+  // they do not.
+  bool locator_current();
+  // Memoized statistics of the arrays shown in the Vector/Plot/Table tabs.
+  ArrayStatsCache array_stats_;
+  const ArrayStats& array_stats(vtkDataArray* array, const QString& key);
   bool first_render_ = true;
   bool pipeline_ready_ = false;
   bool actor_added_ = false;
@@ -0,0 +1,313 @@
+#include "gmp/ArrayStats.h"
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include <vtkArrayDispatch.h>
+#include <vtkDataArray.h>
+#include <vtkDataArrayRange.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+struct Partial {
+  double min = kInf;
+  double max = -kInf;
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  double min_mag = kInf;
+  double max_mag = -kInf;
+  double sum_mag = 0.0;
+  double sum_sq_mag = 0.0;
+  double value_min = kInf;
+  double value_max = -kInf;
+  vtkIdType arg_min = -1;
+  vtkIdType arg_max = -1;
+
+  void merge(const Partial& o) {
+    min = std::min(min, o.min);
+    max = std::max(max, o.max);
+    sum += o.sum;
+    sum_sq += o.sum_sq;
+    min_mag = std::min(min_mag, o.min_mag);
+    max_mag = std::max(max_mag, o.max_mag);
+    sum_mag += o.sum_mag;
+    sum_sq_mag += o.sum_sq_mag;
+    // Ties go to the lower tuple id so the result does not depend on how
+    // the range was split.
+    if (o.arg_min >= 0 &&
+        (arg_min < 0 || o.value_min < value_min ||
+         (o.value_min == value_min && o.arg_min < arg_min))) {
+      value_min = o.value_min;
+      arg_min = o.arg_min;
+    }
+    if (o.arg_max >= 0 &&
+        (arg_max < 0 || o.value_max > value_max ||
+         (o.value_max == value_max && o.arg_max < arg_max))) {
+      value_max = o.value_max;
+      arg_max = o.arg_max;
+    }
+  }
+};
+
+template <typename ArrayT>
+class StatsKernel {
+ public:
+  StatsKernel(ArrayT* array, int components)
+      : array_(array), components_(components) {}
+
+  void Initialize() { partials_.Local() = Partial(); }
+
+  void operator()(vtkIdType begin, vtkIdType end) {
+    Partial& p = partials_.Local();
+    const auto values = vtk::DataArrayValueRange(
+        array_, begin * components_, end * components_);
+    if (components_ == 1) {
+      vtkIdType id = begin;
+      for (const auto raw : values) {
+        const double v = static_cast<double>(raw);
+        const double a = std::abs(v);
+        p.min = std::min(p.min, v);
+        p.max = std::max(p.max, v);
+        p.sum += v;
+        p.sum_sq += v * v;
+        p.min_mag = std::min(p.min_mag, a);
+        p.max_mag = std::max(p.max_mag, a);
+        p.sum_mag += a;
+        if (v < p.value_min) {
+          p.value_min = v;
+          p.arg_min = id;
+        }
+        if (v > p.value_max) {
+          p.value_max = v;
+          p.arg_max = id;
+        }
+        ++id;
+      }
+      p.sum_sq_mag = p.sum_sq;
+      return;
+    }
+    auto it = values.begin();
+    for (vtkIdType id = begin; id < end; ++id) {
+      const double v0 = static_cast<double>(*it);
+      double sq = 0.0;
+      for (int c = 0; c < components_; ++c, ++it) {
+        const double v = static_cast<double>(*it);
+        sq += v * v;
+      }
+      const double m = std::sqrt(sq);
+      p.min = std::min(p.min, v0);
+      p.max = std::max(p.max, v0);
+      p.sum += v0;
+      p.sum_sq += v0 * v0;
+      p.min_mag = std::min(p.min_mag, m);
+      p.max_mag = std::max(p.max_mag, m);
+      p.sum_mag += m;
+      p.sum_sq_mag += sq;
+      if (m < p.value_min) {
+        p.value_min = m;
+        p.arg_min = id;
+      }
+      if (m > p.value_max) {
+        p.value_max = m;
+        p.arg_max = id;
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  Partial combine() {
+    Partial total;
+    for (auto it = partials_.begin(); it != partials_.end(); ++it) {
+      total.merge(*it);
+    }
+    return total;
+  }
+
+ private:
+  ArrayT* array_;
+  int components_;
+  vtkSMPThreadLocal<Partial> partials_;
+};
+
+struct StatsWorker {
+  Partial result;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array) {
+    StatsKernel<ArrayT> kernel(array, array->GetNumberOfComponents());
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), kernel);
+    result = kernel.combine();
+  }
+};
+
+template <typename ArrayT>
+class HistogramKernel {
+ public:
+  HistogramKernel(ArrayT* array, int components, int bins, double lo,
+                  double hi)
+      : array_(array),
+        components_(components),
+        bins_(bins),
+        lo_(lo),
+        hi_(hi),
+        scale_(hi > lo ? bins / (hi - lo) : 0.0) {}
+
+  void Initialize() { counts_.Local().assign(bins_, 0); }
+
+  void operator()(vtkIdType begin, vtkIdType end) {
+    std::vector<qint64>& counts = counts_.Local();
+    const auto values = vtk::DataArrayValueRange(
+        array_, begin * components_, end * components_);
+    auto it = values.begin();
+    for (vtkIdType id = begin; id < end; ++id) {
+      double v = 0.0;
+      if (components_ == 1) {
+        v = static_cast<double>(*it);
+        ++it;
+      } else {
+        double sq = 0.0;
+        for (int c = 0; c < components_; ++c, ++it) {
+          const double x = static_cast<double>(*it);
+          sq += x * x;
+        }
+        v = std::sqrt(sq);
+      }
+      // NaN fails both comparisons and is skipped here.
+      if (!(v >= lo_ && v <= hi_)) {
+        continue;
+      }
+      const int bin = std::min(bins_ - 1, static_cast<int>((v - lo_) * scale_));
+      ++counts[bin];
+    }
+  }
+
+  void Reduce() {}
+
+  std::vector<qint64> combine() {
+    std::vector<qint64> total(bins_, 0);
+    for (auto it = counts_.begin(); it != counts_.end(); ++it) {
+      for (int b = 0; b < bins_; ++b) {
+        total[b] += (*it)[b];
+      }
+    }
+    return total;
+  }
+
+ private:
+  ArrayT* array_;
+  int components_;
+  int bins_;
+  double lo_;
+  double hi_;
+  double scale_;
+  vtkSMPThreadLocal<std::vector<qint64>> counts_;
+};
+
+struct HistogramWorker {
+  int bins = 1;
+  double lo = 0.0;
+  double hi = 0.0;
+  std::vector<qint64> result;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array) {
+    HistogramKernel<ArrayT> kernel(array, array->GetNumberOfComponents(), bins,
+                                   lo, hi);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), kernel);
+    result = kernel.combine();
+  }
+};
+
+}  // namespace
+
+namespace gmp {
+
+ArrayStats ComputeArrayStats(vtkDataArray* array) {
+  ArrayStats stats;
+  if (!array || array->GetNumberOfTuples() <= 0 ||
+      array->GetNumberOfComponents() <= 0) {
+    return stats;
+  }
+  QElapsedTimer timer;
+  timer.start();
+  StatsWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(array, worker)) {
+    // Unusual array types go through the virtual vtkDataArray API.
+    worker(array);
+  }
+  const Partial& p = worker.result;
+  const double n = static_cast<double>(array->GetNumberOfTuples());
+  stats.has_data = true;
+  stats.components = array->GetNumberOfComponents();
+  stats.tuples = array->GetNumberOfTuples();
+  stats.min = p.min;
+  stats.max = p.max;
+  stats.mean = p.sum / n;
+  stats.rms = std::sqrt(p.sum_sq / n);
+  stats.min_mag = p.min_mag;
+  stats.max_mag = p.max_mag;
+  stats.mean_mag = p.sum_mag / n;
+  stats.rms_mag = std::sqrt(p.sum_sq_mag / n);
+  stats.arg_min = p.arg_min;
+  stats.arg_max = p.arg_max;
+  stats.compute_ms = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+  return stats;
+}
+
+ArrayHistogram ComputeArrayHistogram(vtkDataArray* array, int bins, double lo,
+                                     double hi) {
+  ArrayHistogram histogram;
+  histogram.lo = lo;
+  histogram.hi = hi;
+  if (!array || bins <= 0 || array->GetNumberOfTuples() <= 0 ||
+      array->GetNumberOfComponents() <= 0 || !(hi >= lo)) {
+    return histogram;
+  }
+  QElapsedTimer timer;
+  timer.start();
+  HistogramWorker worker;
+  worker.bins = bins;
+  worker.lo = lo;
+  worker.hi = hi;
+  if (!vtkArrayDispatch::Dispatch::Execute(array, worker)) {
+    worker(array);
+  }
+  histogram.counts = std::move(worker.result);
+  for (const qint64 count : histogram.counts) {
+    histogram.counted += count;
+  }
+  histogram.compute_ms = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+  return histogram;
+}
+
+const ArrayStats& ArrayStatsCache::get(vtkDataArray* array, const QString& key,
+                                       int step) {
+  Entry& entry = entries_[std::make_pair(key, step)];
+  if (array && entry.array == array && entry.mtime == array->GetMTime()) {
+    ++hits_;
+    return entry.stats;
+  }
+  entry.array = array;
+  entry.mtime = array ? array->GetMTime() : 0;
+  entry.stats = ComputeArrayStats(array);
+  return entry.stats;
+}
+
+void ArrayStatsCache::clear() {
+  entries_.clear();
+  hits_ = 0;
+}
+
+}  // namespace gmp
+
+#endif
@@ -0,0 +1,218 @@
+#include "gmp/ArrayTableModel.h"
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QElapsedTimer>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <utility>
+
+#include <vtkArrayDispatch.h>
+#include <vtkDataArray.h>
+#include <vtkDataArrayRange.h>
+#include <vtkSMPTools.h>
+
+namespace {
+
+using KeyedTuple = std::pair<double, vtkIdType>;
+
+// Fills (sort key, tuple id) for one table column: 0 is the tuple id,
+// 1..components a component, components + 1 the magnitude.
+struct SortKeyFill {
+  std::vector<KeyedTuple>* out = nullptr;
+  int column = 0;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array) {
+    const auto tuples = vtk::DataArrayTupleRange(array);
+    const int comps = static_cast<int>(tuples.GetTupleSize());
+    const vtkIdType count = std::min<vtkIdType>(
+        static_cast<vtkIdType>(out->size()), tuples.size());
+    vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType t = begin; t < end; ++t) {
+        const auto tuple = tuples[t];
+        double key = static_cast<double>(t);
+        if (column >= 1 && column <= comps) {
+          key = static_cast<double>(tuple[column - 1]);
+        } else if (column > comps) {
+          double sq = 0.0;
+          for (const auto v : tuple) {
+            const double d = static_cast<double>(v);
+            sq += d * d;
+          }
+          key = std::sqrt(sq);
+        }
+        (*out)[static_cast<std::size_t>(t)] = {key, t};
+      }
+    });
+  }
+};
+
+}  // namespace
+
+namespace gmp {
+
+ArrayTableModel::ArrayTableModel(QObject* parent)
+    : QAbstractTableModel(parent) {}
+
+void ArrayTableModel::set_array(vtkDataArray* array, const QString& key) {
+  const vtkMTimeType mtime = array ? array->GetMTime() : 0;
+  if (array == array_.GetPointer() && key == key_ && mtime == mtime_) {
+    return;
+  }
+  beginResetModel();
+  array_ = array;
+  key_ = key;
+  mtime_ = mtime;
+  components_ = array ? array->GetNumberOfComponents() : 0;
+  rows_ = array ? static_cast<int>(std::min<vtkIdType>(
+                      array->GetNumberOfTuples(), INT_MAX))
+                : 0;
+  if (sort_column_ >= columnCount()) {
+    sort_column_ = 0;
+    sort_order_ = Qt::AscendingOrder;
+  }
+  build_order();
+  endResetModel();
+}
+
+void ArrayTableModel::clear() {
+  set_array(nullptr, QString());
+}
+
+vtkIdType ArrayTableModel::tuple_at(int row) const {
+  if (row < 0 || row >= rows_) {
+    return -1;
+  }
+  return order_.empty() ? row : order_[static_cast<std::size_t>(row)];
+}
+
+int ArrayTableModel::row_of(vtkIdType tuple) const {
+  if (tuple < 0 || tuple >= rows_) {
+    return -1;
+  }
+  if (order_.empty()) {
+    return static_cast<int>(tuple);
+  }
+  const auto it = std::find(order_.begin(), order_.end(), tuple);
+  return it == order_.end() ? -1 : static_cast<int>(it - order_.begin());
+}
+
+int ArrayTableModel::rowCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : rows_;
+}
+
+int ArrayTableModel::columnCount(const QModelIndex& parent) const {
+  if (parent.isValid() || !array_) {
+    return 0;
+  }
+  return 1 + components_ + (components_ > 1 ? 1 : 0);
+}
+
+double ArrayTableModel::value(vtkIdType tuple, int column) const {
+  if (column == 0) {
+    return static_cast<double>(tuple);
+  }
+  if (column <= components_) {
+    return array_->GetComponent(tuple, column - 1);
+  }
+  double sq = 0.0;
+  for (int c = 0; c < components_; ++c) {
+    const double v = array_->GetComponent(tuple, c);
+    sq += v * v;
+  }
+  return std::sqrt(sq);
+}
+
+QVariant ArrayTableModel::data(const QModelIndex& index, int role) const {
+  if (!index.isValid() || !array_) {
+    return QVariant();
+  }
+  if (role == Qt::TextAlignmentRole) {
+    return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+  }
+  if (role != Qt::DisplayRole) {
+    return QVariant();
+  }
+  const vtkIdType tuple = tuple_at(index.row());
+  if (tuple < 0) {
+    return QVariant();
+  }
+  if (index.column() == 0) {
+    return QString::number(tuple);
+  }
+  return QString::number(value(tuple, index.column()), 'g', 6);
+}
+
+QVariant ArrayTableModel::headerData(int section, Qt::Orientation orientation,
+                                     int role) const {
+  if (role != Qt::DisplayRole || orientation != Qt::Horizontal) {
+    return QAbstractTableModel::headerData(section, orientation, role);
+  }
+  if (section == 0) {
+    return QString("Index");
+  }
+  if (section <= components_) {
+    return QString("C%1").arg(section - 1);
+  }
+  return QString("Magnitude");
+}
+
+void ArrayTableModel::sort(int column, Qt::SortOrder order) {
+  if (!array_ || column < 0 || column >= columnCount()) {
+    return;
+  }
+  beginResetModel();
+  sort_column_ = column;
+  sort_order_ = order;
+  build_order();
+  endResetModel();
+  emit sorted(sort_ms_);
+}
+
+void ArrayTableModel::build_order() {
+  order_.clear();
+  sort_ms_ = 0.0;
+  if (!array_ || rows_ == 0 ||
+      (sort_column_ == 0 && sort_order_ == Qt::AscendingOrder)) {
+    return;
+  }
+  QElapsedTimer timer;
+  timer.start();
+  std::vector<KeyedTuple> keyed(static_cast<std::size_t>(rows_));
+  SortKeyFill fill;
+  fill.out = &keyed;
+  fill.column = sort_column_;
+  if (!vtkArrayDispatch::Dispatch::Execute(array_.GetPointer(), fill)) {
+    fill(array_.GetPointer());
+  }
+  // NaN sorts last in both orders; equal keys keep tuple order.
+  const bool descending = sort_order_ == Qt::DescendingOrder;
+  vtkSMPTools::Sort(keyed.begin(), keyed.end(),
+                    [descending](const KeyedTuple& a, const KeyedTuple& b) {
+                      const bool a_nan = std::isnan(a.first);
+                      const bool b_nan = std::isnan(b.first);
+                      if (a_nan != b_nan) {
+                        return b_nan;
+                      }
+                      if (!a_nan && a.first != b.first) {
+                        return descending ? a.first > b.first
+                                          : a.first < b.first;
+                      }
+                      return a.second < b.second;
+                    });
+  order_.resize(keyed.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(keyed.size()),
+                   [&](vtkIdType begin, vtkIdType end) {
+                     for (vtkIdType i = begin; i < end; ++i) {
+                       order_[static_cast<std::size_t>(i)] =
+                           keyed[static_cast<std::size_t>(i)].second;
+                     }
+                   });
+  sort_ms_ = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+}
+
+}  // namespace gmp
+
+#endif
@@ -0,0 +1,355 @@
+#include "gmp/ExodusStepCache.h"
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <vtkCompositeDataGeometryFilter.h>
+#include <vtkCompositeDataIterator.h>
+#include <vtkCompositeDataSet.h>
+#include <vtkDataArray.h>
+#include <vtkExodusIIReader.h>
+#include <vtkFieldData.h>
+#include <vtkPolyData.h>
+
+namespace {
+
+constexpr int kObjectTypes[] = {
+    vtkExodusIIReader::ELEM_BLOCK, vtkExodusIIReader::FACE_BLOCK,
+    vtkExodusIIReader::EDGE_BLOCK, vtkExodusIIReader::NODE_SET,
+    vtkExodusIIReader::SIDE_SET,   vtkExodusIIReader::EDGE_SET,
+    vtkExodusIIReader::FACE_SET,   vtkExodusIIReader::ELEM_SET};
+
+constexpr int kArrayTypes[] = {
+    vtkExodusIIReader::NODAL,      vtkExodusIIReader::GLOBAL,
+    vtkExodusIIReader::ELEM_BLOCK, vtkExodusIIReader::FACE_BLOCK,
+    vtkExodusIIReader::EDGE_BLOCK, vtkExodusIIReader::NODE_SET,
+    vtkExodusIIReader::SIDE_SET,   vtkExodusIIReader::EDGE_SET,
+    vtkExodusIIReader::FACE_SET,   vtkExodusIIReader::ELEM_SET};
+
+// Each step's surface comes out of its own geometry filter run, so the
+// points and cells are counted along with the attribute arrays.
+qint64 surface_bytes(vtkPolyData* surface) {
+  return static_cast<qint64>(surface->GetActualMemorySize()) * 1024;
+}
+
+// First tuple of `name` in `fd`; the magnitude for vector arrays.
+double FirstTuple(vtkFieldData* fd, const char* name) {
+  vtkDataArray* array = fd ? fd->GetArray(name) : nullptr;
+  if (!array || array->GetNumberOfTuples() < 1) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  const int comps = array->GetNumberOfComponents();
+  if (comps == 1) {
+    return array->GetComponent(0, 0);
+  }
+  double sq = 0.0;
+  for (int c = 0; c < comps; ++c) {
+    const double v = array->GetComponent(0, c);
+    sq += v * v;
+  }
+  return std::sqrt(sq);
+}
+
+}  // namespace
+
+namespace gmp {
+
+std::mutex& ExodusIoMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+ExodusReadSpec ExodusReadSpec::Capture(vtkExodusIIReader* reader,
+                                       const QString& path) {
+  ExodusReadSpec spec;
+  spec.path = path;
+  if (!reader) {
+    return spec;
+  }
+  for (int type : kObjectTypes) {
+    const int count = reader->GetNumberOfObjects(type);
+    for (int i = 0; i < count; ++i) {
+      spec.objects.push_back({type, i, reader->GetObjectStatus(type, i)});
+    }
+  }
+  for (int type : kArrayTypes) {
+    const int count = reader->GetNumberOfObjectArrays(type);
+    for (int i = 0; i < count; ++i) {
+      const char* name = reader->GetObjectArrayName(type, i);
+      if (name) {
+        spec.arrays.push_back(
+            {type, name, reader->GetObjectArrayStatus(type, i)});
+      }
+    }
+  }
+  return spec;
+}
+
+void ExodusReadSpec::apply(vtkExodusIIReader* reader) const {
+  if (!reader) {
+    return;
+  }
+  for (const Status& s : objects) {
+    if (s.index < reader->GetNumberOfObjects(s.type)) {
+      reader->SetObjectStatus(s.type, s.index, s.status);
+    }
+  }
+  for (const ArrayStatus& a : arrays) {
+    reader->SetObjectArrayStatus(a.type, a.name.c_str(), a.status);
+  }
+}
+
+vtkSmartPointer<vtkExodusIIReader> OpenExodusReader(
+    const ExodusReadSpec& spec) {
+  auto reader = vtkSmartPointer<vtkExodusIIReader>::New();
+  reader->SetFileName(spec.path.toUtf8().constData());
+  reader->UpdateInformation();
+  spec.apply(reader);
+  return reader;
+}
+
+double ExodusGlobalValue(vtkDataObject* output, const char* name) {
+  double value = FirstTuple(output ? output->GetFieldData() : nullptr, name);
+  auto* composite = vtkCompositeDataSet::SafeDownCast(output);
+  if (!std::isnan(value) || !composite) {
+    return value;
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> it;
+  it.TakeReference(composite->NewIterator());
+  for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextItem()) {
+    vtkDataObject* block = it->GetCurrentDataObject();
+    value = FirstTuple(block ? block->GetFieldData() : nullptr, name);
+    if (!std::isnan(value)) {
+      return value;
+    }
+  }
+  return value;
+}
+
+vtkSmartPointer<vtkPolyData> ReadExodusSurface(vtkExodusIIReader* reader,
+                                               double time) {
+  auto geom = vtkSmartPointer<vtkCompositeDataGeometryFilter>::New();
+  geom->SetInputConnection(reader->GetOutputPort());
+  geom->UpdateTimeStep(time);
+  auto surface = vtkSmartPointer<vtkPolyData>::New();
+  surface->ShallowCopy(geom->GetOutput());
+  return surface;
+}
+
+ExodusStepCache::ExodusStepCache(QObject* parent) : QObject(parent) {
+  thread_ = QThread::create([this]() { worker_loop(); });
+  thread_->start(QThread::LowPriority);
+}
+
+ExodusStepCache::~ExodusStepCache() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    queue_.clear();
+  }
+  wake_.notify_all();
+  // At most one step read is in flight.
+  thread_->wait();
+  delete thread_;
+}
+
+void ExodusStepCache::reset(const ExodusReadSpec& spec,
+                            const std::vector<double>& times) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  lru_.clear();
+  queue_.clear();
+  used_ = 0;
+  spec_ = spec;
+  times_ = times;
+  ++generation_;
+  hits_ = 0;
+  misses_ = 0;
+  prefetched_ = 0;
+  read_ms_total_ = 0.0;
+  reads_ = 0;
+}
+
+void ExodusStepCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  lru_.clear();
+  queue_.clear();
+  used_ = 0;
+  ++generation_;
+}
+
+void ExodusStepCache::set_budget_bytes(qint64 bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = std::max<qint64>(0, bytes);
+  evict_locked();
+}
+
+void ExodusStepCache::set_prefetch_depth(int steps) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  depth_ = std::max(0, steps);
+}
+
+vtkSmartPointer<vtkPolyData> ExodusStepCache::lookup(int step) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(step);
+  if (it == entries_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  lru_.splice(lru_.begin(), lru_, it->second.lru);
+  return it->second.surface;
+}
+
+vtkSmartPointer<vtkPolyData> ExodusStepCache::peek(int step) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(step);
+  return it == entries_.end() ? nullptr : it->second.surface;
+}
+
+void ExodusStepCache::insert(int step, vtkPolyData* surface) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  insert_locked(step, surface);
+}
+
+void ExodusStepCache::insert_locked(int step, vtkPolyData* surface) {
+  if (!surface || budget_ <= 0 || entries_.count(step)) {
+    return;
+  }
+  Entry entry;
+  entry.surface = surface;
+  entry.bytes = surface_bytes(surface);
+  lru_.push_front(step);
+  entry.lru = lru_.begin();
+  used_ += entry.bytes;
+  entries_.emplace(step, std::move(entry));
+  evict_locked();
+}
+
+void ExodusStepCache::evict_locked() {
+  while (used_ > budget_ && !lru_.empty()) {
+    const int victim = lru_.back();
+    lru_.pop_back();
+    auto it = entries_.find(victim);
+    if (it != entries_.end()) {
+      used_ -= it->second.bytes;
+      entries_.erase(it);
+    }
+  }
+}
+
+void ExodusStepCache::prefetch(int step, int direction) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_.clear();
+  const int count = static_cast<int>(times_.size());
+  if (depth_ <= 0 || budget_ <= 0 || count == 0) {
+    return;
+  }
+  // Do not queue more than about half the budget, or the prefetcher evicts
+  // the steps it just read.
+  int ahead = depth_;
+  if (!entries_.empty()) {
+    const qint64 average = std::max<qint64>(
+        1, used_ / static_cast<qint64>(entries_.size()));
+    ahead = static_cast<int>(
+        std::min<qint64>(ahead, std::max<qint64>(1, budget_ / 2 / average)));
+  }
+  const int behind = direction == 0 ? ahead : std::max(1, ahead / 4);
+  const int forward = direction < 0 ? -1 : 1;
+  auto enqueue = [&](int s) {
+    if (s >= 0 && s < count && !entries_.count(s)) {
+      queue_.push_back(s);
+    }
+  };
+  for (int i = 1; i <= std::max(ahead, behind); ++i) {
+    if (i <= ahead) {
+      enqueue(step + forward * i);
+    }
+    if (i <= behind) {
+      enqueue(step - forward * i);
+    }
+  }
+  lock.unlock();
+  wake_.notify_one();
+}
+
+QString ExodusStepCache::stats_text() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const qint64 lookups = hits_ + misses_;
+  const double rate =
+      lookups > 0 ? 100.0 * static_cast<double>(hits_) / lookups : 0.0;
+  QString text = QString("Cache: hits %1% (%2/%3) | %4 steps, %5/%6 MB")
+                     .arg(rate, 0, 'f', 0)
+                     .arg(hits_)
+                     .arg(lookups)
+                     .arg(entries_.size())
+                     .arg(static_cast<double>(used_) / 1048576.0, 0, 'f', 0)
+                     .arg(static_cast<double>(budget_) / 1048576.0, 0, 'f', 0);
+  if (reads_ > 0) {
+    text += QString(" | prefetched %1, %2 ms/step")
+                .arg(prefetched_)
+                .arg(read_ms_total_ / static_cast<double>(reads_), 0, 'f', 1);
+  }
+  return text;
+}
+
+void ExodusStepCache::worker_loop() {
+  vtkSmartPointer<vtkExodusIIReader> reader;
+  std::uint64_t reader_generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (stop_) {
+      break;
+    }
+    const int step = queue_.front();
+    queue_.pop_front();
+    if (entries_.count(step) ||
+        step >= static_cast<int>(times_.size())) {
+      continue;
+    }
+    const std::uint64_t generation = generation_;
+    const double time = times_[static_cast<std::size_t>(step)];
+    ExodusReadSpec spec;
+    if (!reader || reader_generation != generation) {
+      spec = spec_;
+    }
+    lock.unlock();
+
+    QElapsedTimer timer;
+    timer.start();
+    vtkSmartPointer<vtkPolyData> surface;
+    {
+      std::lock_guard<std::mutex> io(ExodusIoMutex());
+      if (!reader || reader_generation != generation) {
+        // A reset may mean the file grew or the statuses changed; reopen.
+        reader = OpenExodusReader(spec);
+        reader_generation = generation;
+      }
+      surface = ReadExodusSurface(reader, time);
+    }
+    const double ms = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+
+    lock.lock();
+    if (generation != generation_ || !surface) {
+      continue;
+    }
+    insert_locked(step, surface);
+    ++prefetched_;
+    ++reads_;
+    read_ms_total_ += ms;
+    lock.unlock();
+    emit step_ready(step);
+    lock.lock();
+  }
+}
+
+}  // namespace gmp
+
+#endif
@@ -0,0 +1,277 @@
+#include "gmp/ExodusTimeHistory.h"
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include <vtkCellData.h>
+#include <vtkCompositeDataGeometryFilter.h>
+#include <vtkCompositeDataIterator.h>
+#include <vtkCompositeDataSet.h>
+#include <vtkDataArray.h>
+#include <vtkDataSet.h>
+#include <vtkExodusIIReader.h>
+#include <vtkFieldData.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+
+namespace gmp {
+
+struct ExodusTimeHistory::Pass {
+  TimeHistoryRequest request;
+  TimeHistory result;
+  std::atomic<bool> cancel{false};
+};
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+double TupleValue(vtkDataArray* array, vtkIdType id) {
+  if (!array || id < 0 || id >= array->GetNumberOfTuples()) {
+    return kNaN;
+  }
+  const int comps = array->GetNumberOfComponents();
+  if (comps == 1) {
+    return array->GetComponent(id, 0);
+  }
+  double sq = 0.0;
+  for (int c = 0; c < comps; ++c) {
+    const double v = array->GetComponent(id, c);
+    sq += v * v;
+  }
+  return std::sqrt(sq);
+}
+
+// The viewer's statuses with every array off except the requested one.
+ExodusReadSpec NarrowSpec(const TimeHistoryRequest& request) {
+  using Source = TimeHistoryRequest::Source;
+  const int type = request.source == Source::Point ? vtkExodusIIReader::NODAL
+                   : request.source == Source::Cell
+                       ? vtkExodusIIReader::ELEM_BLOCK
+                       : vtkExodusIIReader::GLOBAL;
+  ExodusReadSpec spec = request.spec;
+  for (ExodusReadSpec::ArrayStatus& a : spec.arrays) {
+    a.status = a.type == type && a.name == request.array ? 1 : 0;
+  }
+  return spec;
+}
+
+vtkSmartPointer<vtkCompositeDataIterator> Leaves(vtkDataObject* output) {
+  auto* composite = vtkCompositeDataSet::SafeDownCast(output);
+  if (!composite) {
+    return nullptr;
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> it;
+  it.TakeReference(composite->NewIterator());
+  return it;
+}
+
+vtkDataSet* LeafAt(vtkDataObject* output, unsigned int flat_index) {
+  auto it = Leaves(output);
+  if (!it) {
+    return nullptr;
+  }
+  for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextItem()) {
+    if (it->GetCurrentFlatIndex() == flat_index) {
+      return vtkDataSet::SafeDownCast(it->GetCurrentDataObject());
+    }
+  }
+  return nullptr;
+}
+
+// Block (flat index) and local id of the entity with global id `gid`.
+bool LocateGlobalId(vtkDataObject* output, bool point, const char* id_name,
+                    vtkIdType gid, unsigned int* flat_index,
+                    vtkIdType* local) {
+  auto it = Leaves(output);
+  if (!it) {
+    return false;
+  }
+  for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextItem()) {
+    auto* block = vtkDataSet::SafeDownCast(it->GetCurrentDataObject());
+    if (!block) {
+      continue;
+    }
+    vtkFieldData* fd = point ? static_cast<vtkFieldData*>(block->GetPointData())
+                             : static_cast<vtkFieldData*>(block->GetCellData());
+    vtkDataArray* ids = fd ? fd->GetArray(id_name) : nullptr;
+    if (!ids) {
+      continue;
+    }
+    const vtkIdType count = ids->GetNumberOfTuples();
+    for (vtkIdType i = 0; i < count; ++i) {
+      if (static_cast<vtkIdType>(ids->GetComponent(i, 0)) == gid) {
+        *flat_index = it->GetCurrentFlatIndex();
+        *local = i;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+double ElapsedMs(const QElapsedTimer& timer) {
+  return static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+}
+
+}  // namespace
+
+QString TimeHistory::cost_text() const {
+  if (step_ms.empty()) {
+    return QString("setup %1 ms").arg(setup_ms, 0, 'f', 1);
+  }
+  double sum = 0.0;
+  double worst = 0.0;
+  for (const double ms : step_ms) {
+    sum += ms;
+    worst = std::max(worst, ms);
+  }
+  return QString("%1 steps in %2 ms (setup %3 ms, %4 ms/step, max %5 ms) | "
+                 "file %6 MB")
+      .arg(step_ms.size())
+      .arg(total_ms, 0, 'f', 0)
+      .arg(setup_ms, 0, 'f', 1)
+      .arg(sum / static_cast<double>(step_ms.size()), 0, 'f', 2)
+      .arg(worst, 0, 'f', 2)
+      .arg(static_cast<double>(file_bytes) / 1048576.0, 0, 'f', 1);
+}
+
+ExodusTimeHistory::ExodusTimeHistory(QObject* parent) : QObject(parent) {}
+
+ExodusTimeHistory::~ExodusTimeHistory() {
+  cancel();
+}
+
+void ExodusTimeHistory::cancel() {
+  if (!thread_) {
+    return;
+  }
+  // The pass checks the flag between steps, so this waits for one read.
+  pass_->cancel = true;
+  thread_->wait();
+  delete thread_;
+  thread_ = nullptr;
+  pass_.reset();
+}
+
+void ExodusTimeHistory::clear() {
+  cancel();
+  result_ = TimeHistory();
+}
+
+void ExodusTimeHistory::start(const TimeHistoryRequest& request) {
+  cancel();
+  auto pass = std::make_shared<Pass>();
+  pass->request = request;
+  pass_ = pass;
+  const quint64 generation = ++generation_;
+  thread_ = QThread::create([this, pass]() {
+    using Source = TimeHistoryRequest::Source;
+    const TimeHistoryRequest& req = pass->request;
+    TimeHistory& out = pass->result;
+    QElapsedTimer total;
+    total.start();
+    out.label = req.label;
+    out.file_bytes = QFileInfo(req.spec.path).size();
+    if (req.times.empty()) {
+      out.error = "No time steps";
+      return;
+    }
+    const bool global = req.source == Source::Global;
+    const bool point = req.source == Source::Point;
+    const char* id_name = point ? vtkExodusIIReader::GetGlobalNodeIdArrayName()
+                                : vtkExodusIIReader::GetGlobalElementIdArrayName();
+
+    vtkSmartPointer<vtkExodusIIReader> reader;
+    unsigned int flat_index = 0;
+    vtkIdType local = -1;
+    {
+      std::lock_guard<std::mutex> io(ExodusIoMutex());
+      reader = OpenExodusReader(NarrowSpec(req));
+      if (!global) {
+        // Map the surface id to a block-local id once; the steps below then
+        // read the blocks directly instead of re-extracting the surface.
+        reader->SetGenerateGlobalNodeIdArray(point ? 1 : 0);
+        reader->SetGenerateGlobalElementIdArray(point ? 0 : 1);
+        auto geom = vtkSmartPointer<vtkCompositeDataGeometryFilter>::New();
+        geom->SetInputConnection(reader->GetOutputPort());
+        geom->UpdateTimeStep(req.times.front());
+        vtkPolyData* surface = geom->GetOutput();
+        vtkFieldData* fd =
+            point ? static_cast<vtkFieldData*>(surface->GetPointData())
+                  : static_cast<vtkFieldData*>(surface->GetCellData());
+        vtkDataArray* ids = fd ? fd->GetArray(id_name) : nullptr;
+        if (!ids || req.id < 0 || req.id >= ids->GetNumberOfTuples()) {
+          out.error = "Probed id is not on the surface";
+          return;
+        }
+        const auto gid = static_cast<vtkIdType>(ids->GetComponent(req.id, 0));
+        if (!LocateGlobalId(reader->GetOutputDataObject(0), point, id_name,
+                            gid, &flat_index, &local)) {
+          out.error = QString("Global id %1 not found").arg(gid);
+          return;
+        }
+      }
+    }
+    out.setup_ms = ElapsedMs(total);
+
+    const std::size_t count = req.times.size();
+    out.times.reserve(count);
+    out.values.reserve(count);
+    out.step_ms.reserve(count);
+    for (std::size_t s = 0; s < count; ++s) {
+      if (pass->cancel) {
+        return;
+      }
+      QElapsedTimer step;
+      step.start();
+      double value = kNaN;
+      {
+        // Per step, so the viewer's own reads interleave with the pass.
+        std::lock_guard<std::mutex> io(ExodusIoMutex());
+        reader->UpdateTimeStep(req.times[s]);
+        vtkDataObject* output = reader->GetOutputDataObject(0);
+        if (global) {
+          value = ExodusGlobalValue(output, req.array.c_str());
+        } else if (vtkDataSet* block = LeafAt(output, flat_index)) {
+          vtkFieldData* fd =
+              point ? static_cast<vtkFieldData*>(block->GetPointData())
+                    : static_cast<vtkFieldData*>(block->GetCellData());
+          value = TupleValue(fd ? fd->GetArray(req.array.c_str()) : nullptr,
+                             local);
+        }
+      }
+      out.step_ms.push_back(ElapsedMs(step));
+      out.times.push_back(req.times[s]);
+      out.values.push_back(value);
+      if ((s & 15) == 15 || s + 1 == count) {
+        emit progress(static_cast<int>(s + 1), static_cast<int>(count));
+      }
+    }
+    out.ok = true;
+    out.total_ms = ElapsedMs(total);
+  });
+  connect(thread_, &QThread::finished, this, [this, generation]() {
+    if (generation != generation_ || !thread_) {
+      return;
+    }
+    result_ = std::move(pass_->result);
+    thread_->deleteLater();
+    thread_ = nullptr;
+    pass_.reset();
+    emit finished();
+  });
+  thread_->start(QThread::LowPriority);
+}
+
+}  // namespace gmp
+
+#endif
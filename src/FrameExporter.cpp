@@ -0,0 +1,405 @@
+#include "gmp/FrameExporter.h"
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+
+#include <QDir>
+#include <QThread>
+#include <QTimer>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkDataObject.h>
+#include <vtkDataSetMapper.h>
+#include <vtkExodusIIReader.h>
+#include <vtkImageData.h>
+#include <vtkPNGWriter.h>
+#include <vtkPolyData.h>
+#include <vtkProperty.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkScalarBarActor.h>
+#include <vtkWarpVector.h>
+#include <vtkWindowToImageFilter.h>
+
+namespace {
+
+// Bounded hand-off between two stages. close() lets the consumer drain what
+// is left; abort() drops everything and releases both sides.
+template <typename T>
+class StageQueue {
+ public:
+  explicit StageQueue(std::size_t capacity) : capacity_(capacity) {}
+
+  // Blocks while full. False once aborted.
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock,
+                   [this]() { return aborted_ || items_.size() < capacity_; });
+    if (aborted_) {
+      return false;
+    }
+    items_.push_back(std::move(item));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  // Blocks while empty. False once closed and drained, or aborted.
+  bool pop(T* item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(
+        lock, [this]() { return aborted_ || closed_ || !items_.empty(); });
+    if (aborted_ || items_.empty()) {
+      return false;
+    }
+    *item = std::move(items_.front());
+    items_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  bool try_pop(T* item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (aborted_ || items_.empty()) {
+      return false;
+    }
+    *item = std::move(items_.front());
+    items_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  bool full() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size() >= capacity_;
+  }
+
+  bool drained() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_ && items_.empty();
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+  }
+
+  void abort() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    aborted_ = true;
+    items_.clear();
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<T> items_;
+  std::size_t capacity_;
+  bool closed_ = false;
+  bool aborted_ = false;
+};
+
+struct Frame {
+  int step = 0;
+  vtkSmartPointer<vtkPolyData> surface;
+};
+
+struct Image {
+  int step = 0;
+  vtkSmartPointer<vtkImageData> image;
+};
+
+double per_frame_ms(qint64 ns, int frames) {
+  return frames > 0 ? static_cast<double>(ns) / 1.0e6 / frames : 0.0;
+}
+
+}  // namespace
+
+namespace gmp {
+
+struct FrameExporter::Pipeline {
+  Options options;
+  ExodusStepCache* cache = nullptr;
+  StageQueue<Frame> read_queue{4};
+  StageQueue<Frame> render_queue{4};
+  StageQueue<Image> encode_queue{4};
+  std::atomic<int> encoded{0};
+  std::atomic<int> failed{0};
+  std::atomic<qint64> read_ns{0};
+  std::atomic<qint64> filter_ns{0};
+  std::atomic<qint64> encode_ns{0};
+  // GUI thread only.
+  qint64 render_ns = 0;
+  int rendered = 0;
+
+  explicit Pipeline(const Options& o)
+      : options(o),
+        encode_queue(static_cast<std::size_t>(2 * o.encoders)) {}
+};
+
+FrameExporter::FrameExporter(QObject* parent) : QObject(parent) {
+  render_timer_ = new QTimer(this);
+  render_timer_->setInterval(0);
+  connect(render_timer_, &QTimer::timeout, this, &FrameExporter::render_tick);
+}
+
+FrameExporter::~FrameExporter() {
+  if (pipeline_) {
+    pipeline_->read_queue.abort();
+    pipeline_->render_queue.abort();
+    pipeline_->encode_queue.abort();
+  }
+  join_workers();
+}
+
+bool FrameExporter::start(const Options& options, vtkRenderer* scene,
+                          vtkDataSetMapper* mapper, vtkActor* actor,
+                          vtkScalarBarActor* scalar_bar,
+                          ExodusStepCache* cache) {
+  if (running_ || options.times.empty() || options.directory.isEmpty() ||
+      !scene || !mapper) {
+    return false;
+  }
+  if (!QDir().mkpath(options.directory)) {
+    return false;
+  }
+
+  window_ = vtkSmartPointer<vtkRenderWindow>::New();
+  window_->SetOffScreenRendering(1);
+  window_->SetSize(std::max(16, options.width), std::max(16, options.height));
+  renderer_ = vtkSmartPointer<vtkRenderer>::New();
+  renderer_->SetBackground(scene->GetBackground());
+  renderer_->SetBackground2(scene->GetBackground2());
+  renderer_->SetGradientBackground(scene->GetGradientBackground());
+  renderer_->GetActiveCamera()->DeepCopy(scene->GetActiveCamera());
+  window_->AddRenderer(renderer_);
+  mapper_ = vtkSmartPointer<vtkDataSetMapper>::New();
+  mapper_->ShallowCopy(mapper);
+  actor_ = vtkSmartPointer<vtkActor>::New();
+  actor_->SetMapper(mapper_);
+  if (actor) {
+    actor_->GetProperty()->DeepCopy(actor->GetProperty());
+  }
+  renderer_->AddActor(actor_);
+  scalar_bar_ = nullptr;
+  if (scalar_bar && scalar_bar->GetVisibility()) {
+    scalar_bar_ = vtkSmartPointer<vtkScalarBarActor>::New();
+    scalar_bar_->SetLookupTable(scalar_bar->GetLookupTable());
+    scalar_bar_->SetTitle(scalar_bar->GetTitle());
+    scalar_bar_->SetNumberOfLabels(scalar_bar->GetNumberOfLabels());
+    renderer_->AddViewProp(scalar_bar_);
+  }
+  grab_ = vtkSmartPointer<vtkWindowToImageFilter>::New();
+  grab_->SetInput(window_);
+  grab_->ReadFrontBufferOff();
+
+  Options clamped = options;
+  clamped.encoders = std::clamp(options.encoders, 1, kMaxEncoders);
+  auto p = std::make_shared<Pipeline>(clamped);
+  p->cache = cache;
+  pipeline_ = p;
+
+  auto spawn = [this](auto&& work) {
+    QThread* worker = QThread::create(std::forward<decltype(work)>(work));
+    worker->start();
+    workers_.push_back(worker);
+  };
+
+  spawn([p]() {
+    vtkSmartPointer<vtkExodusIIReader> reader;
+    const int total = static_cast<int>(p->options.times.size());
+    for (int step = 0; step < total; ++step) {
+      QElapsedTimer timer;
+      timer.start();
+      vtkSmartPointer<vtkPolyData> surface =
+          p->cache ? p->cache->peek(step) : nullptr;
+      if (!surface) {
+        std::lock_guard<std::mutex> io(ExodusIoMutex());
+        if (!reader) {
+          reader = OpenExodusReader(p->options.spec);
+        }
+        surface = ReadExodusSurface(reader, p->options.times[step]);
+      }
+      p->read_ns += timer.nsecsElapsed();
+      if (!p->read_queue.push({step, surface})) {
+        return;
+      }
+    }
+    p->read_queue.close();
+  });
+
+  spawn([p]() {
+    vtkSmartPointer<vtkWarpVector> warp;
+    if (!p->options.warp_vector.isEmpty()) {
+      warp = vtkSmartPointer<vtkWarpVector>::New();
+      warp->SetScaleFactor(p->options.warp_scale);
+      warp->SetInputArrayToProcess(
+          0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS,
+          p->options.warp_vector.toUtf8().constData());
+    }
+    Frame frame;
+    while (p->read_queue.pop(&frame)) {
+      if (warp) {
+        QElapsedTimer timer;
+        timer.start();
+        warp->SetInputData(frame.surface);
+        warp->Update();
+        auto warped = vtkSmartPointer<vtkPolyData>::New();
+        warped->ShallowCopy(warp->GetOutput());
+        frame.surface = warped;
+        p->filter_ns += timer.nsecsElapsed();
+      }
+      if (!p->render_queue.push(std::move(frame))) {
+        return;
+      }
+    }
+    p->render_queue.close();
+  });
+
+  const QDir dir(options.directory);
+  for (int i = 0; i < p->options.encoders; ++i) {
+    spawn([p, dir]() {
+      Image item;
+      while (p->encode_queue.pop(&item)) {
+        QElapsedTimer timer;
+        timer.start();
+        const QString path = dir.filePath(QString("%1_%2.png")
+                                              .arg(p->options.prefix)
+                                              .arg(item.step, 5, 10, QChar('0')));
+        auto writer = vtkSmartPointer<vtkPNGWriter>::New();
+        writer->SetFileName(path.toUtf8().constData());
+        writer->SetInputData(item.image);
+        writer->Write();
+        if (writer->GetErrorCode() != 0) {
+          ++p->failed;
+        }
+        p->encode_ns += timer.nsecsElapsed();
+        ++p->encoded;
+      }
+    });
+  }
+
+  running_ = true;
+  clock_.start();
+  render_timer_->setInterval(0);
+  render_timer_->start();
+  return true;
+}
+
+void FrameExporter::cancel() {
+  if (running_) {
+    finish(false, "cancelled");
+  }
+}
+
+void FrameExporter::render_tick() {
+  std::shared_ptr<Pipeline> p = pipeline_;
+  if (!p) {
+    return;
+  }
+  const int total = static_cast<int>(p->options.times.size());
+  const int encoded = p->encoded.load();
+  emit progress(encoded, total);
+  if (encoded >= total) {
+    finish(true, QString());
+    return;
+  }
+
+  // The encode queue has a single producer, so a non-full queue never
+  // blocks the push below.
+  Frame frame;
+  if (p->rendered < total && !p->encode_queue.full() &&
+      p->render_queue.try_pop(&frame)) {
+    QElapsedTimer timer;
+    timer.start();
+    mapper_->SetInputData(frame.surface);
+    renderer_->ResetCameraClippingRange();
+    window_->Render();
+    grab_->Modified();
+    grab_->Update();
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->DeepCopy(grab_->GetOutput());
+    p->render_ns += timer.nsecsElapsed();
+    ++p->rendered;
+    p->encode_queue.push({frame.step, image});
+    if (p->rendered == total) {
+      p->encode_queue.close();
+    }
+    render_timer_->setInterval(0);
+    return;
+  }
+  if (p->rendered < total && p->render_queue.drained()) {
+    finish(false, "the read stage stopped early");
+    return;
+  }
+  // Waiting on another stage; do not spin the event loop.
+  render_timer_->setInterval(5);
+}
+
+void FrameExporter::finish(bool ok, const QString& reason) {
+  render_timer_->stop();
+  std::shared_ptr<Pipeline> p = pipeline_;
+  p->read_queue.abort();
+  p->render_queue.abort();
+  p->encode_queue.abort();
+  join_workers();
+  running_ = false;
+
+  const int total = static_cast<int>(p->options.times.size());
+  const int frames = p->encoded.load();
+  const int failed = p->failed.load();
+  const double seconds = static_cast<double>(clock_.elapsed()) / 1000.0;
+  QString summary;
+  if (ok) {
+    summary = QString("Exported %1 frames to %2 in %3 s (%4 fps)")
+                  .arg(frames)
+                  .arg(p->options.directory)
+                  .arg(seconds, 0, 'f', 1)
+                  .arg(seconds > 0.0 ? frames / seconds : 0.0, 0, 'f', 1);
+  } else {
+    summary = QString("Frame export stopped after %1 of %2 frames: %3")
+                  .arg(frames)
+                  .arg(total)
+                  .arg(reason);
+  }
+  summary += QString(" | per frame: read %1, warp %2, render %3, encode %4 ms")
+                 .arg(per_frame_ms(p->read_ns, p->rendered), 0, 'f', 1)
+                 .arg(per_frame_ms(p->filter_ns, p->rendered), 0, 'f', 1)
+                 .arg(per_frame_ms(p->render_ns, p->rendered), 0, 'f', 1)
+                 .arg(per_frame_ms(p->encode_ns, frames), 0, 'f', 1);
+  if (failed > 0) {
+    summary += QString(" | %1 PNG writes failed").arg(failed);
+  }
+
+  grab_ = nullptr;
+  scalar_bar_ = nullptr;
+  actor_ = nullptr;
+  mapper_ = nullptr;
+  renderer_ = nullptr;
+  if (window_) {
+    window_->Finalize();
+    window_ = nullptr;
+  }
+  emit finished(ok && failed == 0, summary);
+}
+
+void FrameExporter::join_workers() {
+  // Stages are released by abort(); a reader mid-step finishes that step.
+  for (QThread* worker : workers_) {
+    worker->wait();
+    delete worker;
+  }
+  workers_.clear();
+}
+
+}  // namespace gmp
+
+#endif
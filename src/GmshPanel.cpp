@@ -7,7 +7,10 @@
 #include <QDialog>
 #include <QDialogButtonBox>
 #include "gmp/ComboPopupFix.h"
+#include "gmp/ImportJob.h"
+#include "gmp/MeshJob.h"
 #include <QEvent>
+#include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QFormLayout>
@@ -18,6 +21,7 @@
 #include <QListWidget>
 #include <QListWidgetItem>
 #include <QPlainTextEdit>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QRegularExpression>
 #include <QScrollArea>
@@ -29,6 +33,7 @@
 #include <QModelIndex>
 #include <QObject>
 #include <QString>
+#include <QThread>
 #include <QVBoxLayout>
 #include <algorithm>
 #include <set>
@@ -54,6 +59,14 @@ void tune_gmsh_combo(QComboBox* combo, int min_width = 80, int view_min_width =
   gmp::install_combo_popup_fix(combo);
 }
 
+QString format_dim_tags(const std::vector<std::pair<int, int>>& dim_tags) {
+  QStringList parts;
+  for (const auto& dt : dim_tags) {
+    parts << QString("%1:%2").arg(dt.first).arg(dt.second);
+  }
+  return parts.join(',');
+}
+
 }  // namespace
 
 namespace gmp {
@@ -572,9 +585,9 @@ GmshPanel::GmshPanel(QWidget* parent) : QWidget(parent) {
   phys_form->addRow("", phys_btns_container);
 
   phys_group_table_ = new QTableWidget();
-  phys_group_table_->setColumnCount(5);
+  phys_group_table_->setColumnCount(7);
   phys_group_table_->setHorizontalHeaderLabels(
-      {"Dim", "Tag", "Name", "Entities", "Elements"});
+      {"Dim", "Tag", "Name", "Entities", "Elements", "Min Q", "Mean Q"});
   phys_group_table_->horizontalHeader()->setStretchLastSection(true);
   phys_group_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
   phys_group_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -798,6 +811,61 @@ GmshPanel::GmshPanel(QWidget* parent) : QWidget(parent) {
   optimize_->setChecked(true);
   mesh_form->addRow("", optimize_);
 
+  mesh_threads_ = new QSpinBox();
+  mesh_threads_->setRange(0, 1024);
+  mesh_threads_->setSpecialValueText("Auto");
+  mesh_threads_->setValue(0);
+  mesh_threads_->setToolTip(
+      QString("Threads for General.NumThreads and Mesh.MaxNumThreads1D/2D/3D. "
+              "Auto uses %1.")
+          .arg(QThread::idealThreadCount()));
+  auto* probe_btn = new QPushButton("Scaling Probe");
+  probe_btn->setToolTip(
+      "Mesh the current model at 1/2/4/.../N threads without writing and "
+      "report wall time and element counts.");
+  connect(probe_btn, &QPushButton::clicked, this,
+          &GmshPanel::on_scaling_probe);
+  auto* threads_row = new QHBoxLayout();
+  threads_row->addWidget(mesh_threads_);
+  threads_row->addWidget(probe_btn);
+  threads_row->addStretch(1);
+  auto* threads_container = new QWidget();
+  threads_container->setLayout(threads_row);
+  mesh_form->addRow("Threads", threads_container);
+
+  parallel_algorithms_ = new QCheckBox("Prefer thread-capable algorithms");
+  parallel_algorithms_->setChecked(true);
+  parallel_algorithms_->setToolTip(
+      "With more than one thread, use HXT for 3D and a per-surface parallel "
+      "2D algorithm.");
+  mesh_form->addRow("", parallel_algorithms_);
+
+  mesh_cache_enabled_ = new QCheckBox("Enabled");
+  mesh_cache_enabled_->setChecked(true);
+  mesh_cache_enabled_->setToolTip(
+      "Reuse meshes generated from the same geometry and settings.");
+  mesh_cache_limit_ = new QSpinBox();
+  mesh_cache_limit_->setRange(16, 1024 * 1024);
+  mesh_cache_limit_->setSuffix(" MB");
+  mesh_cache_limit_->setValue(1024);
+  connect(mesh_cache_limit_, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          [this](int mb) {
+            mesh_cache_.set_limit_bytes(static_cast<qint64>(mb) * 1024 * 1024);
+          });
+  auto* cache_clear_btn = new QPushButton("Clear Cache");
+  connect(cache_clear_btn, &QPushButton::clicked, this, [this]() {
+    mesh_cache_.clear();
+    append_log("Mesh cache cleared.");
+  });
+  auto* cache_row = new QHBoxLayout();
+  cache_row->addWidget(mesh_cache_enabled_);
+  cache_row->addWidget(mesh_cache_limit_);
+  cache_row->addWidget(cache_clear_btn);
+  cache_row->addStretch(1);
+  auto* cache_container = new QWidget();
+  cache_container->setLayout(cache_row);
+  mesh_form->addRow("Mesh Cache", cache_container);
+
   content_layout->addWidget(mesh_box);
 
   auto* form = new QFormLayout();
@@ -855,6 +923,29 @@ GmshPanel::GmshPanel(QWidget* parent) : QWidget(parent) {
   generate_container->setLayout(generate_row);
   content_layout->addWidget(generate_container);
 
+  // Everything above touches gmsh and is locked while a mesh job owns it.
+  for (int i = 0; i < content_layout->count(); ++i) {
+    if (auto* w = content_layout->itemAt(i)->widget()) {
+      mesh_locked_widgets_.push_back(w);
+    }
+  }
+
+  mesh_progress_ = new QProgressBar();
+  mesh_progress_->setRange(0, 1);
+  mesh_progress_->setValue(0);
+  mesh_progress_->setFormat("Idle");
+  mesh_progress_->setTextVisible(true);
+  mesh_cancel_ = new QPushButton("Cancel");
+  mesh_cancel_->setEnabled(false);
+  connect(mesh_cancel_, &QPushButton::clicked, this,
+          &GmshPanel::on_cancel_generate);
+  auto* progress_row = new QHBoxLayout();
+  progress_row->addWidget(mesh_progress_, 1);
+  progress_row->addWidget(mesh_cancel_);
+  auto* progress_container = new QWidget();
+  progress_container->setLayout(progress_row);
+  content_layout->addWidget(progress_container);
+
   log_ = new QPlainTextEdit();
   log_->setReadOnly(true);
   content_layout->addWidget(log_, 1);
@@ -895,64 +986,146 @@ bool GmshPanel::import_geometry(const QString& path, bool auto_mesh) {
   if (path.isEmpty()) {
     return false;
   }
-  ensure_gmsh();
+  if (gmsh_busy()) {
+    append_log("Gmsh busy; geometry import skipped: " + path);
+    return false;
+  }
   try {
-    gmsh::option::setNumber("General.Terminal", 0);
-    gmsh::logger::start();
-    gmsh::clear();
-    gmsh::model::add("imported");
-
-    const QString ext = QFileInfo(path).suffix().toLower();
-    if (ext == "step" || ext == "stp" || ext == "iges" || ext == "igs" ||
-        ext == "brep") {
-      gmsh::vectorpair dim_tags;
-      std::string format;
-      if (ext == "brep") {
-        format = "brep";
-      } else if (ext == "iges" || ext == "igs") {
-        format = "iges";
-      } else {
-        format = "step";
-      }
-      gmsh::model::occ::importShapes(path.toStdString(), dim_tags, true, format);
-      gmsh::model::occ::synchronize();
-    } else {
-      gmsh::open(path.toStdString());
-      try {
-        gmsh::model::occ::synchronize();
-      } catch (...) {
-      }
-      try {
-        gmsh::model::geo::synchronize();
-      } catch (...) {
-      }
-    }
+    ensure_gmsh();
+  } catch (const std::exception& ex) {
+    append_log(QString("Gmsh error: %1").arg(ex.what()));
+    return false;
+  }
 
-    geo_path_->setText(path);
+  // The job clears the model first, so nothing cached about it survives.
+  mesh_stats_.clear();
+  model_history_.clear();
+  geometry_source_.clear();
+  model_loaded_ = false;
+  generate_queued_ = auto_mesh;
+  for (auto& tags : import_entities_) {
+    tags.clear();
+  }
+  if (entity_list_) {
+    entity_list_->setPlainText("Importing " + path + " ...");
+  }
+  if (entity_summary_) {
+    entity_summary_->setText("Entities: importing...");
+  }
+
+  import_thread_ = new QThread(this);
+  import_job_ = new ImportJob(path);
+  import_job_->moveToThread(import_thread_);
+  connect(import_thread_, &QThread::started, import_job_, &ImportJob::run);
+  connect(import_job_, &ImportJob::log_line, this, &GmshPanel::append_log);
+  connect(import_job_, &ImportJob::progress, this,
+          [this](int phase, int step, int total) {
+            if (!mesh_progress_) {
+              return;
+            }
+            mesh_progress_->setRange(0, std::max(1, total));
+            mesh_progress_->setValue(step);
+            mesh_progress_->setFormat(
+                QString("%1 (%2/%3)")
+                    .arg(ImportJob::phase_label(phase))
+                    .arg(std::min(step + 1, total))
+                    .arg(total));
+          });
+  connect(import_job_, &ImportJob::entities_ready, this,
+          &GmshPanel::on_import_entities);
+  connect(import_job_, &ImportJob::finished, import_thread_, &QThread::quit);
+  connect(import_thread_, &QThread::finished, this,
+          &GmshPanel::on_import_job_finished);
+
+  set_mesh_job_busy(true);
+  import_thread_->start();
+  append_log("Geometry import started: " + path);
+  return true;
+#endif
+}
+
+void GmshPanel::on_import_entities(int dim, const QList<int>& tags) {
+  if (dim < 0 || dim > 3) {
+    return;
+  }
+  auto& list = import_entities_[dim];
+  list.insert(list.end(), tags.begin(), tags.end());
+  if (entity_summary_) {
+    entity_summary_->setText(
+        QString("Entities: %1P / %2C / %3S / %4V (importing)")
+            .arg(import_entities_[0].size())
+            .arg(import_entities_[1].size())
+            .arg(import_entities_[2].size())
+            .arg(import_entities_[3].size()));
+  }
+  if (!entity_list_) {
+    return;
+  }
+  const int dim_filter = entity_dim_ ? entity_dim_->currentData().toInt() : -1;
+  if (dim_filter >= 0 && dim_filter != dim) {
+    return;
+  }
+  // Appending keeps each chunk proportional to its own size instead of
+  // re-rendering the whole list.
+  QStringList ids;
+  ids.reserve(tags.size());
+  for (int id : tags) {
+    ids << QString::number(id);
+  }
+  entity_list_->appendPlainText(
+      QString("dim %1: %2").arg(dim).arg(ids.join(", ")));
+}
+
+void GmshPanel::on_import_job_finished() {
+  if (!import_job_) {
+    return;
+  }
+  const ImportJobResult result = import_job_->result();
+  import_job_->deleteLater();
+  import_job_ = nullptr;
+  import_thread_->deleteLater();
+  import_thread_ = nullptr;
+  set_mesh_job_busy(false);
+  for (auto& tags : import_entities_) {
+    tags.clear();
+    tags.shrink_to_fit();
+  }
+  const bool generate = generate_queued_;
+  generate_queued_ = false;
+
+  if (result.ok) {
+    geo_path_->setText(result.path);
     model_loaded_ = true;
     use_sample_box_->setChecked(false);
-    update_entity_summary();
-    update_entity_list();
-    update_physical_group_list();
-    update_field_list();
-    refresh_occ_entity_template_lists();
-
-    std::vector<std::string> log;
-    gmsh::logger::get(log);
-    gmsh::logger::stop();
-    for (const auto& line : log) {
-      append_log(QString::fromStdString(line));
+    geometry_source_ = result.geometry_source;
+    append_log(QString("Geometry loaded: %1 (%2P / %3C / %4S / %5V)")
+                   .arg(result.path)
+                   .arg(result.entity_counts[0])
+                   .arg(result.entity_counts[1])
+                   .arg(result.entity_counts[2])
+                   .arg(result.entity_counts[3]));
+  } else {
+    if (result.canceled) {
+      append_log("Geometry import canceled.");
+    } else {
+      append_log(QString("Gmsh error: %1").arg(result.error));
     }
-    append_log("Geometry loaded: " + path);
-    if (auto_mesh) {
+    geo_path_->clear();
+    use_sample_box_->setChecked(true);
+  }
+  update_entity_summary();
+  update_entity_list();
+  update_physical_group_list();
+  update_field_list();
+  refresh_occ_entity_template_lists();
+
+  if (generate) {
+    if (result.ok) {
       on_generate();
+    } else {
+      emit mesh_generation_finished(false);
     }
-    return true;
-  } catch (const std::exception& ex) {
-    append_log(QString("Gmsh error: %1").arg(ex.what()));
   }
-  return false;
-#endif
 }
 
 QVariantMap GmshPanel::gmsh_settings() const {
@@ -978,6 +1151,13 @@ QVariantMap GmshPanel::gmsh_settings() const {
   map.insert("algo3d", algo3d_ ? algo3d_->currentData().toInt() : 1);
   map.insert("recombine", recombine_ && recombine_->isChecked());
   map.insert("smoothing", smoothing_ ? smoothing_->value() : 10);
+  map.insert("mesh_threads", mesh_threads_ ? mesh_threads_->value() : 0);
+  map.insert("mesh_cache_enabled",
+             mesh_cache_enabled_ && mesh_cache_enabled_->isChecked());
+  map.insert("mesh_cache_limit_mb",
+             mesh_cache_limit_ ? mesh_cache_limit_->value() : 1024);
+  map.insert("parallel_algorithms",
+             parallel_algorithms_ && parallel_algorithms_->isChecked());
   map.insert("output_path", output_path_ ? output_path_->text() : "");
   const QString geo_path = geo_path_ ? geo_path_->text() : "";
   if (!geo_path.isEmpty() && QFileInfo::exists(geo_path)) {
@@ -1090,6 +1270,25 @@ void GmshPanel::apply_gmsh_settings(const QVariantMap& settings) {
     smoothing_->setValue(
         settings.value("smoothing", smoothing_->value()).toInt());
   }
+  if (mesh_threads_) {
+    mesh_threads_->setValue(
+        settings.value("mesh_threads", mesh_threads_->value()).toInt());
+  }
+  if (parallel_algorithms_) {
+    parallel_algorithms_->setChecked(
+        settings.value("parallel_algorithms", parallel_algorithms_->isChecked())
+            .toBool());
+  }
+  if (mesh_cache_enabled_) {
+    mesh_cache_enabled_->setChecked(
+        settings.value("mesh_cache_enabled", mesh_cache_enabled_->isChecked())
+            .toBool());
+  }
+  if (mesh_cache_limit_) {
+    mesh_cache_limit_->setValue(
+        settings.value("mesh_cache_limit_mb", mesh_cache_limit_->value())
+            .toInt());
+  }
   if (output_path_) {
     output_path_->setText(
         settings.value("output_path", output_path_->text()).toString());
@@ -1153,6 +1352,22 @@ void GmshPanel::apply_gmsh_settings(const QVariantMap& settings) {
 }
 
 GmshPanel::~GmshPanel() {
+  if (import_thread_) {
+    import_job_->cancel();
+    import_thread_->quit();
+    import_thread_->wait();
+    delete import_job_;
+    import_job_ = nullptr;
+  }
+  if (mesh_thread_) {
+    // gmsh cannot be interrupted inside a phase, so this waits for the
+    // running phase to finish before finalizing.
+    mesh_job_->cancel();
+    mesh_thread_->quit();
+    mesh_thread_->wait();
+    delete mesh_job_;
+    mesh_job_ = nullptr;
+  }
 #ifdef GMP_ENABLE_GMSH_GUI
   if (gmsh_ready_) {
     gmsh::finalize();
@@ -1218,6 +1433,9 @@ void GmshPanel::on_clear_model() {
 #else
   ensure_gmsh();
   gmsh::clear();
+  mesh_stats_.clear();
+  model_history_.clear();
+  geometry_source_.clear();
   model_loaded_ = false;
   geo_path_->clear();
   update_entity_summary();
@@ -1262,6 +1480,9 @@ void GmshPanel::on_entity_size_apply() {
       dim_tags.emplace_back(0, t);
     }
     gmsh::model::mesh::setSize(dim_tags, entity_size_value_->value());
+    record_model_op(QString("size %1 %2")
+                        .arg(format_dim_tags(dim_tags))
+                        .arg(entity_size_value_->value()));
     append_log(QString("Entity size applied to %1 points.").arg(tags.size()));
   } catch (const std::exception& ex) {
     append_log(QString("Entity size apply failed: %1").arg(ex.what()));
@@ -1292,6 +1513,7 @@ void GmshPanel::on_entity_size_clear() {
       dim_tags.emplace_back(0, t);
     }
     gmsh::model::mesh::setSize(dim_tags, 0.0);
+    record_model_op(QString("size %1 0").arg(format_dim_tags(dim_tags)));
     append_log(QString("Entity size cleared for %1 points.").arg(tags.size()));
   } catch (const std::exception& ex) {
     append_log(QString("Entity size clear failed: %1").arg(ex.what()));
@@ -1325,216 +1547,270 @@ void GmshPanel::on_generate() {
   append_log("Gmsh is not enabled in this build.");
   return;
 #else
+  if (import_job_) {
+    if (!generate_queued_) {
+      generate_queued_ = true;
+      append_log("Mesh generation queued until the import finishes.");
+    }
+    return;
+  }
+  if (mesh_job_running()) {
+    append_log("Mesh generation already running.");
+    return;
+  }
+  MeshJobSpec spec = current_mesh_job_spec();
+  pending_cache_key_.clear();
+  // The sample box is cheap to build, and a cache hit would leave the
+  // previous model in gmsh behind the box's mesh.
+  if (!spec.build_sample_box && mesh_cache_enabled_ &&
+      mesh_cache_enabled_->isChecked()) {
+    const QString key = mesh_cache_key(spec);
+    MeshCache::Entry entry;
+    if (mesh_cache_.lookup(key, &entry)) {
+      finish_from_mesh_cache(spec, entry);
+      return;
+    }
+    pending_cache_key_ = key;
+    append_log("Mesh cache miss: " + mesh_cache_.stats_text());
+  }
+  if (!start_mesh_job(spec)) {
+    emit mesh_generation_finished(false);
+    return;
+  }
+  append_log("Mesh generation started.");
+#endif
+}
+
+void GmshPanel::on_scaling_probe() {
+#ifndef GMP_ENABLE_GMSH_GUI
+  append_log("Gmsh is not enabled in this build.");
+  return;
+#else
+  if (gmsh_busy()) {
+    append_log("Gmsh busy; scaling probe skipped.");
+    return;
+  }
+  probe_spec_ = current_mesh_job_spec();
+  probe_spec_.probe = true;
+  const int max_threads = probe_spec_.num_threads;
+  // Every run meshes with the algorithms of the widest one, so the speedup
+  // only measures General.NumThreads.
+  const auto [algo2d, algo3d] = ResolveMeshAlgorithms(probe_spec_);
+  probe_spec_.algo2d = algo2d;
+  probe_spec_.algo3d = algo3d;
+  probe_spec_.prefer_parallel_algorithms = false;
+  probe_pending_.clear();
+  probe_results_.clear();
+  for (int n = 1; n < max_threads; n *= 2) {
+    probe_pending_.push_back(n);
+  }
+  probe_pending_.push_back(max_threads);
+  append_log(QString("Scaling probe: %1 runs up to %2 threads, 2D algorithm "
+                     "%3, 3D algorithm %4.")
+                 .arg(probe_pending_.size())
+                 .arg(max_threads)
+                 .arg(algo2d)
+                 .arg(algo3d));
+  start_next_probe_run();
+#endif
+}
+
+void GmshPanel::start_next_probe_run() {
+  if (probe_pending_.empty()) {
+    return;
+  }
+  MeshJobSpec spec = probe_spec_;
+  spec.num_threads = probe_pending_.front();
+  probe_pending_.erase(probe_pending_.begin());
+  if (!start_mesh_job(spec)) {
+    probe_pending_.clear();
+    probe_results_.clear();
+  }
+}
+
+void GmshPanel::report_scaling_probe() {
+  if (probe_results_.empty()) {
+    return;
+  }
+  const double base_ms =
+      static_cast<double>(std::max<qint64>(1, probe_results_.front().mesh_ms));
+  append_log("Scaling probe results:");
+  for (const auto& r : probe_results_) {
+    append_log(QString("  threads=%1 wall=%2 ms nodes=%3 elems=%4 speedup=%5")
+                   .arg(r.threads)
+                   .arg(r.mesh_ms)
+                   .arg(r.node_count)
+                   .arg(r.element_count)
+                   .arg(base_ms / std::max<qint64>(1, r.mesh_ms), 0, 'f', 2));
+  }
+  probe_results_.clear();
+}
+
+MeshJobSpec GmshPanel::current_mesh_job_spec() const {
+  MeshJobSpec spec;
+  spec.build_sample_box =
+      !model_loaded_ || (use_sample_box_ && use_sample_box_->isChecked());
+  spec.size_x = size_x_->value();
+  spec.size_y = size_y_->value();
+  spec.size_z = size_z_->value();
+  spec.mesh_size = mesh_size_->value();
+  spec.requested_dim = mesh_dim_ ? mesh_dim_->currentData().toInt() : -1;
+  spec.order = elem_order_->currentData().toInt();
+  spec.msh_version = msh_version_->currentData().toInt();
+  spec.high_order_opt =
+      high_order_opt_ ? high_order_opt_->currentData().toInt() : 0;
+  spec.algo2d = algo2d_ ? algo2d_->currentData().toInt() : 2;
+  spec.algo3d = algo3d_ ? algo3d_->currentData().toInt() : 1;
+  spec.recombine = recombine_ && recombine_->isChecked();
+  spec.smoothing = smoothing_ ? smoothing_->value() : 10;
+  spec.optimize = optimize_->isChecked();
+  const int threads = mesh_threads_ ? mesh_threads_->value() : 0;
+  spec.num_threads =
+      threads > 0 ? threads : std::max(1, QThread::idealThreadCount());
+  spec.prefer_parallel_algorithms =
+      parallel_algorithms_ && parallel_algorithms_->isChecked();
+  spec.output_path = output_path_->text();
+  return spec;
+}
+
+bool GmshPanel::start_mesh_job(const MeshJobSpec& spec) {
   try {
     ensure_gmsh();
+  } catch (const std::exception& ex) {
+    append_log(QString("Gmsh error: %1").arg(ex.what()));
+    return false;
+  }
 
-    gmsh::option::setNumber("General.Terminal", 0);
-    gmsh::logger::start();
+  mesh_thread_ = new QThread(this);
+  mesh_job_ = new MeshJob(spec);
+  mesh_job_->moveToThread(mesh_thread_);
+  connect(mesh_thread_, &QThread::started, mesh_job_, &MeshJob::run);
+  connect(mesh_job_, &MeshJob::log_line, this, &GmshPanel::append_log);
+  connect(mesh_job_, &MeshJob::progress, this,
+          [this](int phase, int step, int total) {
+            if (!mesh_progress_) {
+              return;
+            }
+            mesh_progress_->setRange(0, std::max(1, total));
+            mesh_progress_->setValue(step);
+            mesh_progress_->setFormat(
+                QString("%1 (%2/%3)")
+                    .arg(MeshJob::phase_label(phase))
+                    .arg(std::min(step + 1, total))
+                    .arg(total));
+          });
+  connect(mesh_job_, &MeshJob::finished, mesh_thread_, &QThread::quit);
+  connect(mesh_thread_, &QThread::finished, this,
+          &GmshPanel::on_mesh_job_finished);
 
-    const double dx = size_x_->value();
-    const double dy = size_y_->value();
-    const double dz = size_z_->value();
-    const double lc = mesh_size_->value();
-    const int order = elem_order_->currentData().toInt();
-    const int msh_version = msh_version_->currentData().toInt();
-
-    gmsh::option::setNumber("Mesh.CharacteristicLengthMin", lc);
-    gmsh::option::setNumber("Mesh.CharacteristicLengthMax", lc);
-    gmsh::option::setNumber("Mesh.ElementOrder", order);
-    if (high_order_opt_) {
-      const int opt = high_order_opt_->currentData().toInt();
-      if (opt > 0 && order > 1) {
-        gmsh::option::setNumber("Mesh.HighOrderOptimize", opt);
-      } else {
-        gmsh::option::setNumber("Mesh.HighOrderOptimize", 0);
-      }
-    }
-    if (algo2d_) {
-      gmsh::option::setNumber("Mesh.Algorithm",
-                              algo2d_->currentData().toInt());
-    }
-    if (algo3d_) {
-      gmsh::option::setNumber("Mesh.Algorithm3D",
-                              algo3d_->currentData().toInt());
-    }
-    if (recombine_) {
-      gmsh::option::setNumber("Mesh.RecombineAll",
-                              recombine_->isChecked() ? 1 : 0);
-    }
-    if (smoothing_) {
-      gmsh::option::setNumber("Mesh.Smoothing", smoothing_->value());
-    }
-    gmsh::option::setNumber("Mesh.Optimize", optimize_->isChecked() ? 1 : 0);
-    gmsh::option::setNumber("Mesh.MshFileVersion", msh_version == 2 ? 2.2 : 4.1);
-
-    if (!model_loaded_ || (use_sample_box_ && use_sample_box_->isChecked())) {
-      gmsh::clear();
-      gmsh::model::add("box_model");
-      const int box = gmsh::model::occ::addBox(0, 0, 0, dx, dy, dz);
-      gmsh::model::occ::synchronize();
-
-      const int phys = gmsh::model::addPhysicalGroup(3, {box});
-      gmsh::model::setPhysicalName(3, phys, "solid");
-      std::vector<std::pair<int, int>> faces;
-      gmsh::model::getEntities(faces, 2);
-      if (!faces.empty()) {
-        std::vector<int> face_tags;
-        face_tags.reserve(faces.size());
-        for (const auto& f : faces) {
-          face_tags.push_back(f.second);
-        }
-        const int bnd = gmsh::model::addPhysicalGroup(2, face_tags);
-        gmsh::model::setPhysicalName(2, bnd, "boundary");
-      }
-      model_loaded_ = true;
-      geo_path_->setText("sample: box");
-      use_sample_box_->setChecked(true);
-    } else {
-      gmsh::model::mesh::clear();
-    }
+  set_mesh_job_busy(true);
+  mesh_thread_->start();
+  return true;
+}
 
-    int dim = infer_mesh_dim();
-    if (mesh_dim_) {
-      const int configured = mesh_dim_->currentData().toInt();
-      if (configured >= 1 && configured <= 3) {
-        if (configured <= dim) {
-          dim = configured;
-        } else {
-          append_log(QString("Requested mesh dim %1 exceeds geometry dim %2, "
-                            "fallback to %2.")
-                         .arg(configured)
-                         .arg(dim));
-        }
-      }
-    }
-    gmsh::model::mesh::generate(dim);
-    const int boundary_dim = std::max(0, dim - 1);
+void GmshPanel::on_cancel_generate() {
+  if (import_job_) {
+    // A queued mesh would start from the partially imported model.
+    import_job_->cancel();
+  } else if (mesh_job_) {
+    mesh_job_->cancel();
+  } else {
+    return;
+  }
+  if (mesh_cancel_) {
+    mesh_cancel_->setEnabled(false);
+  }
+  append_log("Cancel requested; stopping after the current phase.");
+}
 
-    const QString out_path = output_path_->text();
-    QDir().mkpath(QFileInfo(out_path).absolutePath());
-    gmsh::write(out_path.toStdString());
-
-    std::vector<std::pair<int, int>> phys_groups;
-    gmsh::model::getPhysicalGroups(phys_groups);
-    QStringList boundary_names;
-    for (const auto& p : phys_groups) {
-      if (p.first != boundary_dim) {
-        continue;
-      }
-      std::string name;
-      gmsh::model::getPhysicalName(p.first, p.second, name);
-      if (name.empty()) {
-        name = "boundary_" + std::to_string(p.second);
-      }
-      boundary_names << QString::fromStdString(name);
-    }
-    emit boundary_groups(boundary_names);
-
-    QStringList volume_names;
-    std::vector<std::pair<int, int>> vol_groups;
-    gmsh::model::getPhysicalGroups(vol_groups, dim);
-    for (const auto& g : vol_groups) {
-      std::string name;
-      gmsh::model::getPhysicalName(g.first, g.second, name);
-      if (name.empty()) {
-        name = "volume_" + std::to_string(g.second);
-      }
-      volume_names << QString::fromStdString(name);
-    }
-    emit volume_groups(volume_names);
+bool GmshPanel::mesh_job_running() const {
+  return mesh_job_ != nullptr || (import_job_ != nullptr && generate_queued_);
+}
 
-    std::vector<std::string> log;
-    gmsh::logger::get(log);
-    gmsh::logger::stop();
-    for (const auto& line : log) {
-      append_log(QString::fromStdString(line));
-    }
+bool GmshPanel::gmsh_busy() const {
+  return mesh_job_ != nullptr || import_job_ != nullptr;
+}
 
-    append_log("Mesh written: " + out_path);
-    emit mesh_written(out_path);
+void GmshPanel::set_mesh_job_busy(bool busy) {
+  for (auto* w : mesh_locked_widgets_) {
+    w->setEnabled(!busy);
+  }
+  if (mesh_cancel_) {
+    mesh_cancel_->setEnabled(busy);
+  }
+  if (mesh_progress_ && !busy) {
+    mesh_progress_->setRange(0, 1);
+    mesh_progress_->setValue(0);
+    mesh_progress_->setFormat("Idle");
+  }
+}
 
-    std::vector<std::size_t> node_tags;
-    std::vector<double> node_coords;
-    std::vector<double> node_params;
-    gmsh::model::mesh::getNodes(node_tags, node_coords, node_params);
+void GmshPanel::on_mesh_job_finished() {
+  if (!mesh_job_) {
+    return;
+  }
+  const MeshJobResult result = mesh_job_->result();
+  mesh_job_->deleteLater();
+  mesh_job_ = nullptr;
+  mesh_thread_->deleteLater();
+  mesh_thread_ = nullptr;
+  set_mesh_job_busy(false);
 
-    std::vector<int> element_types;
-    std::vector<std::vector<std::size_t>> element_tags;
-    std::vector<std::vector<std::size_t>> element_nodes;
-    gmsh::model::mesh::getElements(element_types, element_tags, element_nodes);
-    std::size_t elem_count = 0;
-    std::vector<std::size_t> all_element_tags;
-    for (const auto& tags : element_tags) {
-      elem_count += tags.size();
-      all_element_tags.insert(all_element_tags.end(), tags.begin(), tags.end());
+  if (result.built_sample_box) {
+    model_loaded_ = true;
+    geo_path_->setText("sample: box");
+    use_sample_box_->setChecked(true);
+    // The box replaced whatever was loaded before, edits included.
+    geometry_source_ = QString("sample-box %1 %2 %3")
+                           .arg(size_x_->value())
+                           .arg(size_y_->value())
+                           .arg(size_z_->value())
+                           .toUtf8();
+    model_history_.clear();
+  }
+  // The probe and a canceled job both leave a different mesh behind.
+  mesh_stats_ = result.stats;
+  if (result.probe) {
+    if (result.ok) {
+      probe_results_.push_back(result);
+    }
+    if (result.ok && !probe_pending_.empty()) {
+      start_next_probe_run();
+      return;
     }
-
-    append_log(QString("Nodes: %1, Elements: %2").arg(node_tags.size()).arg(elem_count));
+    probe_pending_.clear();
+    if (result.canceled) {
+      append_log("Scaling probe canceled.");
+    } else if (!result.ok) {
+      append_log(QString("Gmsh error: %1").arg(result.error));
+    }
+    report_scaling_probe();
     update_entity_summary();
     update_entity_list();
-    update_physical_group_list();
-    update_field_list();
-
-    if (!all_element_tags.empty()) {
-      try {
-        std::vector<double> qualities;
-        qualities.resize(all_element_tags.size());
-        gmsh::model::mesh::getElementQualities(all_element_tags, qualities,
-                                               "minSICN");
-        double qmin = qualities.front();
-        double qmax = qualities.front();
-        double qsum = 0.0;
-        for (double q : qualities) {
-          qmin = std::min(qmin, q);
-          qmax = std::max(qmax, q);
-          qsum += q;
-        }
-        const double qmean = qsum / static_cast<double>(qualities.size());
-        append_log(QString("Quality (minSICN) min=%1 mean=%2 max=%3")
-                       .arg(qmin, 0, 'g', 6)
-                       .arg(qmean, 0, 'g', 6)
-                       .arg(qmax, 0, 'g', 6));
-      } catch (const std::exception& ex) {
-        append_log(QString("Quality report failed: %1").arg(ex.what()));
-      }
-    }
-
-    try {
-      std::vector<std::pair<int, int>> groups;
-      gmsh::model::getPhysicalGroups(groups);
-      if (!groups.empty()) {
-        append_log("Physical group element counts:");
-      }
-      for (const auto& g : groups) {
-        std::string name;
-        gmsh::model::getPhysicalName(g.first, g.second, name);
-        std::vector<int> ent_tags;
-        gmsh::model::getEntitiesForPhysicalGroup(g.first, g.second, ent_tags);
-        std::size_t count = 0;
-        for (int ent : ent_tags) {
-          std::vector<int> etypes;
-          std::vector<std::vector<std::size_t>> etags;
-          std::vector<std::vector<std::size_t>> enodes;
-          gmsh::model::mesh::getElements(etypes, etags, enodes, g.first, ent);
-          for (const auto& tags : etags) {
-            count += tags.size();
-          }
-        }
-        const QString label = name.empty()
-                                  ? QString("%1:%2").arg(g.first).arg(g.second)
-                                  : QString("%1:%2 %3")
-                                        .arg(g.first)
-                                        .arg(g.second)
-                                        .arg(QString::fromStdString(name));
-        append_log(QString("  %1 -> %2 elems").arg(label).arg(count));
-      }
-    } catch (const std::exception& ex) {
-      append_log(QString("Physical group count failed: %1").arg(ex.what()));
+    return;
+  }
+  if (result.canceled) {
+    append_log("Mesh generation canceled.");
+  } else if (!result.ok) {
+    append_log(QString("Gmsh error: %1").arg(result.error));
+  } else {
+    emit boundary_groups(result.boundary_names);
+    emit volume_groups(result.volume_names);
+    append_log("Mesh written: " + result.output_path);
+    emit mesh_written(result.output_path);
+    if (!pending_cache_key_.isEmpty() &&
+        mesh_cache_.insert(pending_cache_key_, result.output_path, result.dim,
+                           result.boundary_names, result.volume_names)) {
+      append_log("Mesh cached: " + mesh_cache_.stats_text());
     }
-  } catch (const std::exception& ex) {
-    append_log(QString("Gmsh error: %1").arg(ex.what()));
   }
-#endif
+  pending_cache_key_.clear();
+
+  update_entity_summary();
+  update_entity_list();
+  update_physical_group_list();
+  update_field_list();
+  emit mesh_generation_finished(result.ok);
 }
 
 void GmshPanel::on_add_primitive() {
@@ -1575,6 +1851,15 @@ void GmshPanel::on_add_primitive() {
     for (const auto& line : log) {
       append_log(QString::fromStdString(line));
     }
+    record_model_op(QString("primitive %1 %2 %3 %4 %5 %6 %7 %8")
+                        .arg(kind)
+                        .arg(x)
+                        .arg(y)
+                        .arg(z)
+                        .arg(prim_dx_->value())
+                        .arg(prim_dy_->value())
+                        .arg(prim_dz_->value())
+                        .arg(prim_radius_->value()));
     append_log(QString("Primitive added: %1").arg(kind));
   } catch (const std::exception& ex) {
     append_log(QString("Gmsh error: %1").arg(ex.what()));
@@ -1606,6 +1891,11 @@ void GmshPanel::on_apply_translate() {
     update_entity_summary();
     update_entity_list();
     refresh_occ_entity_template_lists();
+    record_model_op(QString("translate %1 %2 %3 %4")
+                        .arg(format_dim_tags(tags))
+                        .arg(trans_dx_->value())
+                        .arg(trans_dy_->value())
+                        .arg(trans_dz_->value()));
     append_log(QString("Translated %1 entities.").arg(tags.size()));
   } catch (const std::exception& ex) {
     append_log(QString("Translate failed: %1").arg(ex.what()));
@@ -1639,6 +1929,15 @@ void GmshPanel::on_apply_rotate() {
     update_entity_summary();
     update_entity_list();
     refresh_occ_entity_template_lists();
+    record_model_op(QString("rotate %1 %2 %3 %4 %5 %6 %7 %8")
+                        .arg(format_dim_tags(tags))
+                        .arg(rot_x_->value())
+                        .arg(rot_y_->value())
+                        .arg(rot_z_->value())
+                        .arg(rot_ax_->value())
+                        .arg(rot_ay_->value())
+                        .arg(rot_az_->value())
+                        .arg(angle));
     append_log(QString("Rotated %1 entities.").arg(tags.size()));
   } catch (const std::exception& ex) {
     append_log(QString("Rotate failed: %1").arg(ex.what()));
@@ -1671,6 +1970,14 @@ void GmshPanel::on_apply_scale() {
     update_entity_summary();
     update_entity_list();
     refresh_occ_entity_template_lists();
+    record_model_op(QString("scale %1 %2 %3 %4 %5 %6 %7")
+                        .arg(format_dim_tags(tags))
+                        .arg(scale_cx_->value())
+                        .arg(scale_cy_->value())
+                        .arg(scale_cz_->value())
+                        .arg(scale_x_->value())
+                        .arg(scale_y_->value())
+                        .arg(scale_z_->value()));
     append_log(QString("Scaled %1 entities.").arg(tags.size()));
   } catch (const std::exception& ex) {
     append_log(QString("Scale failed: %1").arg(ex.what()));
@@ -1712,6 +2019,11 @@ void GmshPanel::on_apply_boolean_fuse() {
     update_entity_summary();
     update_entity_list();
     refresh_occ_entity_template_lists();
+    record_model_op(QString("fuse %1 %2 %3 %4")
+                        .arg(format_dim_tags(obj_tags))
+                        .arg(format_dim_tags(tool_tags))
+                        .arg(boolean_remove_obj_->isChecked() ? 1 : 0)
+                        .arg(boolean_remove_tool_->isChecked() ? 1 : 0));
     append_log(QString("Fuse result: %1 entities.").arg(out_tags.size()));
   } catch (const std::exception& ex) {
     append_log(QString("Fuse failed: %1").arg(ex.what()));
@@ -1753,6 +2065,11 @@ void GmshPanel::on_apply_boolean_cut() {
     update_entity_summary();
     update_entity_list();
     refresh_occ_entity_template_lists();
+    record_model_op(QString("cut %1 %2 %3 %4")
+                        .arg(format_dim_tags(obj_tags))
+                        .arg(format_dim_tags(tool_tags))
+                        .arg(boolean_remove_obj_->isChecked() ? 1 : 0)
+                        .arg(boolean_remove_tool_->isChecked() ? 1 : 0));
     append_log(QString("Cut result: %1 entities.").arg(out_tags.size()));
   } catch (const std::exception& ex) {
     append_log(QString("Cut failed: %1").arg(ex.what()));
@@ -1794,6 +2111,11 @@ void GmshPanel::on_apply_boolean_intersect() {
     update_entity_summary();
     update_entity_list();
     refresh_occ_entity_template_lists();
+    record_model_op(QString("intersect %1 %2 %3 %4")
+                        .arg(format_dim_tags(obj_tags))
+                        .arg(format_dim_tags(tool_tags))
+                        .arg(boolean_remove_obj_->isChecked() ? 1 : 0)
+                        .arg(boolean_remove_tool_->isChecked() ? 1 : 0));
     append_log(QString("Intersect result: %1 entities.").arg(out_tags.size()));
   } catch (const std::exception& ex) {
     append_log(QString("Intersect failed: %1").arg(ex.what()));
@@ -1878,6 +2200,9 @@ void GmshPanel::select_physical_group(int dim, int tag) {
   Q_UNUSED(tag);
   return;
 #else
+  if (gmsh_busy()) {
+    return;
+  }
   if (!phys_group_list_) {
     return;
   }
@@ -1897,6 +2222,9 @@ void GmshPanel::apply_entity_pick(int dim, int tag) {
   Q_UNUSED(tag);
   return;
 #else
+  if (gmsh_busy()) {
+    return;
+  }
   if (!active_entity_input_) {
     append_log("Pick: focus an entity input field first.");
     return;
@@ -1962,6 +2290,11 @@ void GmshPanel::on_physical_group_add() {
       gmsh::model::setPhysicalName(dim, group_tag, name);
     }
     update_physical_group_list();
+    record_model_op(QString("group add %1:%2 %3 %4")
+                        .arg(dim)
+                        .arg(group_tag)
+                        .arg(phys_group_entities_->text().simplified())
+                        .arg(QString::fromStdString(name)));
     append_log(QString("Physical group added: %1:%2").arg(dim).arg(group_tag));
   } catch (const std::exception& ex) {
     append_log(QString("Physical group add failed: %1").arg(ex.what()));
@@ -2002,6 +2335,11 @@ void GmshPanel::on_physical_group_update() {
       gmsh::model::setPhysicalName(dim, tag, name);
     }
     update_physical_group_list();
+    record_model_op(QString("group update %1:%2 %3 %4")
+                        .arg(dim)
+                        .arg(tag)
+                        .arg(phys_group_entities_->text().simplified())
+                        .arg(QString::fromStdString(name)));
     append_log(QString("Physical group updated: %1:%2").arg(dim).arg(tag));
   } catch (const std::exception& ex) {
     append_log(QString("Physical group update failed: %1").arg(ex.what()));
@@ -2031,6 +2369,7 @@ void GmshPanel::on_physical_group_delete() {
       return;
     }
     gmsh::model::removePhysicalGroups({{dim, tag}});
+    record_model_op(QString("group delete %1:%2").arg(dim).arg(tag));
     update_physical_group_list();
     phys_group_name_->clear();
     phys_group_entities_->clear();
@@ -2085,6 +2424,13 @@ void GmshPanel::on_field_apply() {
                                         field_dist_max_->value());
     gmsh::model::mesh::field::setAsBackgroundMesh(thr);
 
+    record_model_op(QString("field %1 %2 %3 %4 %5 %6")
+                        .arg(dim)
+                        .arg(field_entities_->text().simplified())
+                        .arg(field_dist_min_->value())
+                        .arg(field_dist_max_->value())
+                        .arg(field_size_min_->value())
+                        .arg(field_size_max_->value()));
     update_field_list();
     append_log(QString("Field applied: Distance=%1 Threshold=%2")
                    .arg(dist)
@@ -2107,6 +2453,7 @@ void GmshPanel::on_field_clear() {
     for (int tag : tags) {
       gmsh::model::mesh::field::remove(tag);
     }
+    record_model_op("field clear");
     update_field_list();
     append_log("All mesh fields cleared.");
   } catch (const std::exception& ex) {
@@ -2131,7 +2478,7 @@ void GmshPanel::ensure_gmsh() {
 
 void GmshPanel::update_entity_summary() {
 #ifdef GMP_ENABLE_GMSH_GUI
-  if (!entity_summary_) {
+  if (!entity_summary_ || gmsh_busy()) {
     return;
   }
   if (!gmsh_ready_) {
@@ -2161,7 +2508,7 @@ void GmshPanel::update_entity_summary() {
 
 void GmshPanel::update_entity_list() {
 #ifdef GMP_ENABLE_GMSH_GUI
-  if (!entity_list_) {
+  if (!entity_list_ || gmsh_busy()) {
     return;
   }
   if (!gmsh_ready_) {
@@ -2212,7 +2559,7 @@ void GmshPanel::update_entity_list() {
 
 void GmshPanel::update_physical_group_list() {
 #ifdef GMP_ENABLE_GMSH_GUI
-  if (!phys_group_list_) {
+  if (!phys_group_list_ || gmsh_busy()) {
     return;
   }
   if (!gmsh_ready_) {
@@ -2312,16 +2659,10 @@ void GmshPanel::update_physical_group_table() {
     gmsh::model::getPhysicalName(g.first, g.second, name);
     std::vector<int> ent_tags;
     gmsh::model::getEntitiesForPhysicalGroup(g.first, g.second, ent_tags);
-    std::size_t elem_count = 0;
-    for (int ent : ent_tags) {
-      std::vector<int> etypes;
-      std::vector<std::vector<std::size_t>> etags;
-      std::vector<std::vector<std::size_t>> enodes;
-      gmsh::model::mesh::getElements(etypes, etags, enodes, g.first, ent);
-      for (const auto& tags : etags) {
-        elem_count += tags.size();
-      }
-    }
+    MeshEntityStats stats;
+    const bool cached =
+        AggregateGroupStats(mesh_stats_, g.first, ent_tags, &stats);
+    const bool has_quality = cached && stats.quality.count > 0;
 
     const int row = static_cast<int>(i);
     phys_group_table_->setItem(row, 0,
@@ -2335,7 +2676,19 @@ void GmshPanel::update_physical_group_table() {
     phys_group_table_->setItem(
         row, 3, new QTableWidgetItem(QString::number(ent_tags.size())));
     phys_group_table_->setItem(
-        row, 4, new QTableWidgetItem(QString::number(elem_count)));
+        row, 4, new QTableWidgetItem(QString::number(stats.element_count)));
+    auto* min_item = new QTableWidgetItem(
+        has_quality ? QString::number(stats.quality.min, 'g', 4) : "-");
+    auto* mean_item = new QTableWidgetItem(
+        has_quality ? QString::number(stats.quality.mean(), 'g', 4) : "-");
+    if (has_quality) {
+      const QString tip = "minSICN " + stats.quality.summary() + "\n" +
+                          stats.quality.bins_text();
+      min_item->setToolTip(tip);
+      mean_item->setToolTip(tip);
+    }
+    phys_group_table_->setItem(row, 5, min_item);
+    phys_group_table_->setItem(row, 6, mean_item);
 
     const QString key = QString("%1:%2").arg(g.first).arg(g.second);
     if (!current.isEmpty() && key == current) {
@@ -2357,7 +2710,7 @@ void GmshPanel::update_physical_group_table() {
 
 void GmshPanel::update_field_list() {
 #ifdef GMP_ENABLE_GMSH_GUI
-  if (!field_list_) {
+  if (!field_list_ || gmsh_busy()) {
     return;
   }
   if (!gmsh_ready_) {
@@ -2548,7 +2901,7 @@ QStringList GmshPanel::invalid_entity_tokens(const QString& text, int dim_filter
 
 void GmshPanel::validate_entity_input(QLineEdit* input, int dim_filter,
                                      bool occ_only) {
-  if (!input) {
+  if (!input || gmsh_busy()) {
     return;
   }
   const QStringList invalid = invalid_entity_tokens(input->text(), dim_filter,
@@ -2629,6 +2982,9 @@ void GmshPanel::populate_boolean_entity_templates(int dim_filter) {
 }
 
 void GmshPanel::refresh_occ_entity_template_lists() {
+  if (gmsh_busy()) {
+    return;
+  }
   const int transform_dim =
       transform_dim_ ? transform_dim_->currentData().toInt() : -1;
   const int boolean_dim =
@@ -2910,6 +3266,54 @@ std::vector<std::pair<int, int>> GmshPanel::resolve_occ_dim_tags(
 #endif
 }
 
+void GmshPanel::record_model_op(const QString& op) {
+  model_history_ << op;
+}
+
+QString GmshPanel::mesh_cache_key(const MeshJobSpec& spec) const {
+  const QByteArray geometry =
+      geometry_source_ + "\n" + model_history_.join('\n').toUtf8();
+  QVariantMap settings = gmsh_settings();
+  // The box sizes only matter when building the box, and then they are
+  // part of geometry_source_ afterwards.
+  settings.remove("size_x");
+  settings.remove("size_y");
+  settings.remove("size_z");
+  // The thread count does not change the mesh, but it decides which
+  // algorithms run.
+  settings.remove("mesh_threads");
+  const auto [algo2d, algo3d] = ResolveMeshAlgorithms(spec);
+  settings.insert("algo2d", algo2d);
+  settings.insert("algo3d", algo3d);
+  settings.remove("parallel_algorithms");
+  return MeshCache::MakeKey(geometry, settings);
+}
+
+void GmshPanel::finish_from_mesh_cache(const MeshJobSpec& spec,
+                                       const MeshCache::Entry& entry) {
+  const QString out_path = spec.output_path;
+  if (QFileInfo(out_path).absoluteFilePath() !=
+      QFileInfo(entry.file).absoluteFilePath()) {
+    // Downstream users keep the output path, which must survive eviction.
+    QDir().mkpath(QFileInfo(out_path).absolutePath());
+    QFile::remove(out_path);
+    if (!QFile::copy(entry.file, out_path)) {
+      append_log("Mesh cache copy failed: " + out_path);
+      emit mesh_generation_finished(false);
+      return;
+    }
+  }
+  // The in-memory model was not meshed.
+  mesh_stats_.clear();
+  append_log("Mesh cache hit: " + mesh_cache_.stats_text());
+  emit boundary_groups(entry.boundary_names);
+  emit volume_groups(entry.volume_names);
+  append_log("Mesh written: " + out_path);
+  emit mesh_written(out_path);
+  update_physical_group_table();
+  emit mesh_generation_finished(true);
+}
+
 void GmshPanel::append_log(const QString& text) {
   if (log_) {
     log_->appendPlainText(text);
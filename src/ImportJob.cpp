@@ -0,0 +1,181 @@
+#include "gmp/ImportJob.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gmp/MeshCache.h"
+
+#ifdef GMP_ENABLE_GMSH_GUI
+#include <gmsh.h>
+#endif
+
+namespace {
+
+struct JobCanceled {};
+
+#ifdef GMP_ENABLE_GMSH_GUI
+// Keeps each queued signal small enough that the GUI thread stays
+// responsive while a 10k-face assembly is listed.
+constexpr int kEntityChunk = 1000;
+#endif
+
+}  // namespace
+
+namespace gmp {
+
+ImportJob::ImportJob(const QString& path, QObject* parent)
+    : QObject(parent), path_(path) {}
+
+void ImportJob::cancel() {
+  cancel_.store(true);
+}
+
+bool ImportJob::cancel_requested() const {
+  return cancel_.load();
+}
+
+QString ImportJob::phase_label(int phase) {
+  switch (phase) {
+    case Hash:
+      return "Hash";
+    case Read:
+      return "Import";
+    case Synchronize:
+      return "Synchronize";
+    case Entities:
+      return "Entities";
+    default:
+      return "Import";
+  }
+}
+
+void ImportJob::drain_log() {
+#ifdef GMP_ENABLE_GMSH_GUI
+  std::vector<std::string> log;
+  gmsh::logger::get(log);
+  for (std::size_t i = log_seen_; i < log.size(); ++i) {
+    emit log_line(QString::fromStdString(log[i]));
+  }
+  log_seen_ = std::max(log_seen_, log.size());
+#endif
+}
+
+void ImportJob::run() {
+  result_ = ImportJobResult();
+  result_.path = path_;
+#ifndef GMP_ENABLE_GMSH_GUI
+  result_.error = "Gmsh is not enabled in this build.";
+  emit finished();
+#else
+  log_seen_ = 0;
+  const int total = 4;
+  int step = 0;
+  QElapsedTimer phase_timer;
+  auto begin_phase = [&](int phase) {
+    if (cancel_requested()) {
+      throw JobCanceled();
+    }
+    emit progress(phase, step++, total);
+    phase_timer.start();
+  };
+  auto end_phase = [&](int phase) {
+    drain_log();
+    emit log_line(QString("%1 done in %2 ms")
+                      .arg(phase_label(phase))
+                      .arg(phase_timer.elapsed()));
+  };
+
+  const QString ext = QFileInfo(path_).suffix().toLower();
+  const bool occ = ext == "step" || ext == "stp" || ext == "iges" ||
+                   ext == "igs" || ext == "brep";
+  try {
+    gmsh::option::setNumber("General.Terminal", 0);
+    gmsh::logger::start();
+
+    begin_phase(Hash);
+    result_.geometry_source =
+        ext.toUtf8() + ":" + MeshCache::HashFile(path_).toHex();
+    end_phase(Hash);
+
+    begin_phase(Read);
+    gmsh::clear();
+    gmsh::model::add("imported");
+    if (occ) {
+      gmsh::vectorpair dim_tags;
+      std::string format;
+      if (ext == "brep") {
+        format = "brep";
+      } else if (ext == "iges" || ext == "igs") {
+        format = "iges";
+      } else {
+        format = "step";
+      }
+      gmsh::model::occ::importShapes(path_.toStdString(), dim_tags, true,
+                                     format);
+    } else {
+      gmsh::open(path_.toStdString());
+    }
+    end_phase(Read);
+
+    begin_phase(Synchronize);
+    if (occ) {
+      gmsh::model::occ::synchronize();
+    } else {
+      try {
+        gmsh::model::occ::synchronize();
+      } catch (...) {
+      }
+      try {
+        gmsh::model::geo::synchronize();
+      } catch (...) {
+      }
+    }
+    end_phase(Synchronize);
+
+    begin_phase(Entities);
+    for (int dim = 0; dim <= 3; ++dim) {
+      std::vector<std::pair<int, int>> ents;
+      gmsh::model::getEntities(ents, dim);
+      result_.entity_counts[dim] = static_cast<int>(ents.size());
+      QList<int> chunk;
+      chunk.reserve(kEntityChunk);
+      for (const auto& e : ents) {
+        chunk.append(e.second);
+        if (chunk.size() == kEntityChunk) {
+          emit entities_ready(dim, chunk);
+          chunk.clear();
+        }
+      }
+      if (!chunk.isEmpty()) {
+        emit entities_ready(dim, chunk);
+      }
+    }
+    end_phase(Entities);
+
+    gmsh::logger::stop();
+    result_.ok = true;
+    emit progress(Entities, total, total);
+  } catch (const JobCanceled&) {
+    result_.canceled = true;
+    try {
+      gmsh::clear();
+      drain_log();
+      gmsh::logger::stop();
+    } catch (...) {
+    }
+  } catch (const std::exception& ex) {
+    result_.error = QString::fromUtf8(ex.what());
+    try {
+      drain_log();
+      gmsh::logger::stop();
+    } catch (...) {
+    }
+  }
+  emit finished();
+#endif
+}
+
+}  // namespace gmp
@@ -0,0 +1,227 @@
+#include "gmp/JobLog.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QStringMatcher>
+#include <QThread>
+#include <algorithm>
+#include <cstring>
+
+namespace gmp {
+
+namespace {
+
+constexpr qint64 kSearchChunkBytes = 1 << 20;
+constexpr qint64 kTailChunkBytes = 64 * 1024;
+
+QStringList SplitLines(const QByteArray& bytes) {
+  QStringList lines = QString::fromUtf8(bytes).split('\n');
+  if (!lines.isEmpty() && lines.back().isEmpty()) {
+    lines.removeLast();
+  }
+  return lines;
+}
+
+}  // namespace
+
+struct JobLog::Search {
+  QString path;
+  QString needle;
+  qint64 limit = 0;
+  int max_hits = 0;
+  std::atomic<bool> cancel{false};
+  QVector<JobLogHit> hits;
+  bool truncated = false;
+  double ms = 0.0;
+};
+
+JobLog::JobLog(const QString& path, int window_lines, QObject* parent)
+    : QObject(parent),
+      window_lines_(static_cast<std::size_t>(std::max(1, window_lines))) {
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  file_.setFileName(path);
+  file_.open(QIODevice::ReadWrite | QIODevice::Truncate);
+}
+
+JobLog::~JobLog() {
+  cancel_search();
+}
+
+void JobLog::append(const QStringList& lines) {
+  if (lines.isEmpty()) {
+    return;
+  }
+  QByteArray bytes;
+  for (const QString& line : lines) {
+    offsets_.push_back(end_ + bytes.size());
+    bytes += line.toUtf8();
+    bytes += '\n';
+    window_.push_back(line);
+  }
+  while (window_.size() > window_lines_) {
+    window_.pop_front();
+  }
+  if (file_.isOpen()) {
+    file_.seek(end_);
+    file_.write(bytes);
+    // Searches and tails of older jobs read the file through other handles.
+    file_.flush();
+  }
+  end_ += bytes.size();
+}
+
+QString JobLog::line(qint64 index) const {
+  const QStringList found = lines(index, 1);
+  return found.isEmpty() ? QString() : found.front();
+}
+
+QStringList JobLog::lines(qint64 first, qint64 count) const {
+  const qint64 total = line_count();
+  first = std::max<qint64>(0, first);
+  const qint64 last = std::min(total, first + std::max<qint64>(0, count));
+  if (first >= last) {
+    return {};
+  }
+  const qint64 window_first = total - static_cast<qint64>(window_.size());
+  QStringList out;
+  if (first < window_first) {
+    out = read_range(first, std::min(last, window_first) - first);
+  }
+  for (qint64 i = std::max(first, window_first); i < last; ++i) {
+    out << window_[static_cast<std::size_t>(i - window_first)];
+  }
+  return out;
+}
+
+QStringList JobLog::tail(int count) const {
+  return lines(line_count() - count, count);
+}
+
+QStringList JobLog::read_range(qint64 first, qint64 count) const {
+  if (!file_.isOpen() || count <= 0) {
+    return {};
+  }
+  const qint64 begin = offsets_[static_cast<std::size_t>(first)];
+  const qint64 next = first + count;
+  const qint64 end = next < line_count()
+                         ? offsets_[static_cast<std::size_t>(next)]
+                         : end_;
+  if (!file_.seek(begin)) {
+    return {};
+  }
+  return SplitLines(file_.read(end - begin));
+}
+
+void JobLog::cancel_search() {
+  if (!search_thread_) {
+    return;
+  }
+  search_->cancel = true;
+  search_thread_->wait();
+  delete search_thread_;
+  search_thread_ = nullptr;
+  search_.reset();
+}
+
+void JobLog::start_search(const QString& needle, int max_hits) {
+  cancel_search();
+  if (needle.isEmpty()) {
+    return;
+  }
+  auto search = std::make_shared<Search>();
+  search->path = path();
+  search->needle = needle;
+  search->limit = end_;
+  search->max_hits = std::max(1, max_hits);
+  search_ = search;
+  search_thread_ = QThread::create([search]() {
+    QElapsedTimer timer;
+    timer.start();
+    QFile file(search->path);
+    if (!file.open(QIODevice::ReadOnly)) {
+      return;
+    }
+    const QStringMatcher matcher(search->needle, Qt::CaseInsensitive);
+    QByteArray carry;
+    qint64 line_no = 0;
+    qint64 remaining = search->limit;
+    auto check = [&](const char* data, qint64 size) {
+      const QString text = QString::fromUtf8(data, static_cast<int>(size));
+      if (matcher.indexIn(text) >= 0) {
+        if (search->hits.size() >= search->max_hits) {
+          search->truncated = true;
+        } else {
+          search->hits.push_back({line_no, text});
+        }
+      }
+      ++line_no;
+    };
+    while (remaining > 0 && !search->cancel && !search->truncated) {
+      const QByteArray chunk = file.read(std::min(remaining, kSearchChunkBytes));
+      if (chunk.isEmpty()) {
+        break;
+      }
+      remaining -= chunk.size();
+      const char* p = chunk.constData();
+      const char* end = p + chunk.size();
+      while (p < end && !search->truncated) {
+        const auto* newline =
+            static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!newline) {
+          carry.append(p, static_cast<int>(end - p));
+          break;
+        }
+        if (carry.isEmpty()) {
+          check(p, newline - p);
+        } else {
+          carry.append(p, static_cast<int>(newline - p));
+          check(carry.constData(), carry.size());
+          carry.clear();
+        }
+        p = newline + 1;
+      }
+    }
+    search->ms = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+  });
+  connect(search_thread_, &QThread::finished, this, [this, search]() {
+    if (search != search_) {
+      return;
+    }
+    search_thread_->deleteLater();
+    search_thread_ = nullptr;
+    search_.reset();
+    if (!search->cancel) {
+      emit search_finished(search->needle, search->hits, search->truncated,
+                           search->ms);
+    }
+  });
+  search_thread_->start(QThread::LowPriority);
+}
+
+QStringList JobLog::ReadTail(const QString& path, int count) {
+  QFile file(path);
+  if (count <= 0 || !file.open(QIODevice::ReadOnly)) {
+    return {};
+  }
+  qint64 pos = file.size();
+  QByteArray data;
+  // One newline past `count` lines, ignoring the final one.
+  while (pos > 0 && data.count('\n') <= count) {
+    const qint64 step = std::min(pos, kTailChunkBytes);
+    pos -= step;
+    file.seek(pos);
+    data.prepend(file.read(step));
+  }
+  QStringList lines = SplitLines(data);
+  if (pos > 0 && !lines.isEmpty()) {
+    // The first piece may start mid-line.
+    lines.removeFirst();
+  }
+  if (lines.size() > count) {
+    lines = lines.mid(lines.size() - count);
+  }
+  return lines;
+}
+
+}  // namespace gmp
@@ -0,0 +1,241 @@
+#include "gmp/JobQueue.h"
+
+#include <QMetaObject>
+#include <algorithm>
+
+namespace gmp {
+
+namespace {
+
+// Finished jobs whose log and progress stay reachable through the queue.
+constexpr std::size_t kKeepFinished = 16;
+constexpr int kLogWindowLines = 5000;
+
+}  // namespace
+
+struct JobQueue::Job {
+  int id = 0;
+  QueuedJob request;
+  std::unique_ptr<Runner> runner;
+  std::unique_ptr<JobLog> log;
+  MooseProgress progress;
+  bool cancel_requested = false;
+};
+
+JobQueue::JobQueue(QObject* parent) : QObject(parent) {}
+
+JobQueue::~JobQueue() {
+  // Runners die with their jobs; disconnect first so no signal reaches a
+  // half-destroyed queue.
+  for (auto& [id, job] : running_) {
+    if (job->runner) {
+      job->runner->disconnect(this);
+    }
+  }
+}
+
+void JobQueue::set_core_budget(int cores) {
+  budget_ = std::max(1, cores);
+  schedule();
+}
+
+void JobQueue::set_order(Order order) {
+  order_ = order;
+  schedule();
+}
+
+void JobQueue::set_output_watch(const QRegularExpression& pattern, int group) {
+  watch_pattern_ = pattern;
+  watch_group_ = group;
+}
+
+int JobQueue::submit(const QueuedJob& request) {
+  auto job = std::make_unique<Job>();
+  job->id = next_id_++;
+  job->request = request;
+  job->request.cores = std::max(1, request.cores);
+  const int id = job->id;
+  waiting_.push_back(std::move(job));
+  if (!schedule_posted_) {
+    schedule_posted_ = true;
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+          schedule_posted_ = false;
+          schedule();
+        },
+        Qt::QueuedConnection);
+  }
+  emit load_changed();
+  return id;
+}
+
+void JobQueue::cancel(int id) {
+  auto running = running_.find(id);
+  if (running != running_.end()) {
+    // finish() runs when the process exits.
+    running->second->cancel_requested = true;
+    if (running->second->runner) {
+      running->second->runner->stop();
+    }
+    return;
+  }
+  auto waiting = std::find_if(waiting_.begin(), waiting_.end(),
+                              [id](const auto& job) { return job->id == id; });
+  if (waiting == waiting_.end()) {
+    return;
+  }
+  waiting_.erase(waiting);
+  emit job_dropped(id);
+  emit load_changed();
+  // The dropped job may have been the one holding the others back.
+  schedule();
+}
+
+void JobQueue::cancel_all() {
+  std::vector<int> dropped;
+  for (const auto& job : waiting_) {
+    dropped.push_back(job->id);
+  }
+  waiting_.clear();
+  for (const int id : dropped) {
+    emit job_dropped(id);
+  }
+  for (auto& [id, job] : running_) {
+    job->cancel_requested = true;
+    if (job->runner) {
+      job->runner->stop();
+    }
+  }
+  emit load_changed();
+}
+
+bool JobQueue::is_waiting(int id) const {
+  return std::any_of(waiting_.begin(), waiting_.end(),
+                     [id](const auto& job) { return job->id == id; });
+}
+
+bool JobQueue::cancel_requested(int id) const {
+  const Job* job = find(id);
+  return job && job->cancel_requested;
+}
+
+std::vector<int> JobQueue::running_ids() const {
+  std::vector<int> ids;
+  ids.reserve(running_.size());
+  for (const auto& [id, job] : running_) {
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+const JobQueue::Job* JobQueue::find(int id) const {
+  auto running = running_.find(id);
+  if (running != running_.end()) {
+    return running->second.get();
+  }
+  for (const auto& job : finished_) {
+    if (job->id == id) {
+      return job.get();
+    }
+  }
+  return nullptr;
+}
+
+JobLog* JobQueue::log(int id) const {
+  const Job* job = find(id);
+  return job ? job->log.get() : nullptr;
+}
+
+const MooseProgress* JobQueue::progress(int id) const {
+  const Job* job = find(id);
+  return job ? &job->progress : nullptr;
+}
+
+void JobQueue::schedule() {
+  while (!waiting_.empty()) {
+    auto next = waiting_.begin();
+    if (order_ == Order::Priority) {
+      // Ids grow with submission, so ties keep FIFO order.
+      next = std::min_element(
+          waiting_.begin(), waiting_.end(), [](const auto& a, const auto& b) {
+            if (a->request.priority != b->request.priority) {
+              return a->request.priority > b->request.priority;
+            }
+            return a->id < b->id;
+          });
+    }
+    const int cores = (*next)->request.cores;
+    if (!running_.empty() && in_use_ + cores > budget_) {
+      break;
+    }
+    std::unique_ptr<Job> job = std::move(*next);
+    waiting_.erase(next);
+    start(std::move(job));
+  }
+}
+
+void JobQueue::start(std::unique_ptr<Job> job) {
+  const int id = job->id;
+  const QueuedJob& request = job->request;
+  job->log = std::make_unique<JobLog>(request.log_path, kLogWindowLines);
+  job->runner = CreateRunner(request.kind);
+  in_use_ += request.cores;
+  Job* raw = job.get();
+  running_.emplace(id, std::move(job));
+  emit job_started(id);
+  emit load_changed();
+  if (!raw->runner) {
+    raw->log->append("Failed to create runner.");
+    finish(id, -1, QProcess::CrashExit);
+    return;
+  }
+
+  raw->runner->set_output_watch(watch_pattern_, watch_group_);
+  connect(raw->runner.get(), &Runner::output, this,
+          [this, raw, id](const OutputBatch& batch) {
+            if (!batch.lines.isEmpty()) {
+              raw->log->append(batch.lines);
+            }
+            const bool stepped = raw->progress.feed(batch.lines);
+            emit job_output(id, batch);
+            if (stepped) {
+              emit job_progress(id);
+            }
+          });
+  connect(raw->runner.get(), &Runner::finished, this,
+          [this, id](int code, QProcess::ExitStatus status) {
+            finish(id, code, status);
+          });
+  raw->log->append("Launching: " + request.spec.program + " " +
+                   request.spec.args.join(" "));
+  raw->runner->start(request.spec);
+}
+
+void JobQueue::finish(int id, int exit_code, QProcess::ExitStatus status) {
+  auto it = running_.find(id);
+  if (it == running_.end()) {
+    return;
+  }
+  std::unique_ptr<Job> job = std::move(it->second);
+  running_.erase(it);
+  in_use_ -= job->request.cores;
+  job->log->append(QString("Run finished. exit=%1 status=%2%3")
+                       .arg(exit_code)
+                       .arg(status == QProcess::NormalExit ? "Normal" : "Crash")
+                       .arg(job->cancel_requested ? " (cancelled)" : ""));
+  if (job->runner) {
+    // This may run inside the runner's own signal.
+    job->runner->disconnect(this);
+    job->runner.release()->deleteLater();
+  }
+  finished_.push_back(std::move(job));
+  while (finished_.size() > kKeepFinished) {
+    finished_.pop_front();
+  }
+  emit job_finished(id, exit_code, status);
+  emit load_changed();
+  schedule();
+}
+
+}  // namespace gmp
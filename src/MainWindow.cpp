@@ -5,6 +5,7 @@
 #include <QDir>
 #include <QInputDialog>
 #include <QLabel>
+#include <QLineEdit>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
@@ -12,6 +13,7 @@
 #include <QSizePolicy>
 #include <QScrollArea>
 #include <QPlainTextEdit>
+#include <QPointer>
 #include <QPushButton>
 #include <QDialog>
 #include <QTableWidget>
@@ -23,6 +25,7 @@
 #include <QFrame>
 #include <QTabBar>
 #include <QTabWidget>
+#include <QTimer>
 #include <QToolBar>
 #include <QTreeWidget>
 #include <QAbstractItemView>
@@ -43,7 +46,12 @@
 #include <QLabel>
 #include <QTextStream>
 #include <QDateTime>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <vector>
 
 #include <fstream>
@@ -52,7 +60,11 @@
 
 #include "gmp/GmshPanel.h"
 #include "gmp/MoosePanel.h"
+#include "gmp/MooseProgress.h"
+#include "gmp/ParameterSweep.h"
+#include "gmp/PlotWidget.h"
 #include "gmp/PropertyEditor.h"
+#include "gmp/SweepDialog.h"
 #include "gmp/VtkViewer.h"
 
 namespace gmp {
@@ -693,9 +705,10 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
   auto* job_info_layout = new QVBoxLayout(job_info_panel);
   job_info_layout->setContentsMargins(0, 0, 0, 0);
   job_table_ = new QTableWidget(job_info_panel);
-  job_table_->setColumnCount(7);
-  job_table_->setHorizontalHeaderLabels(
-      {"Name", "Status", "Start", "Duration", "Mesh", "Exec", "Result"});
+  job_table_->setColumnCount(11);
+  job_table_->setHorizontalHeaderLabels({"Name", "Status", "Start", "Duration",
+                                         "Steps", "Steps/s", "Avg NL",
+                                         "Last |R|", "Mesh", "Exec", "Result"});
   job_table_->horizontalHeader()->setStretchLastSection(true);
   job_table_->verticalHeader()->setVisible(false);
   job_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
@@ -706,6 +719,19 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
   job_detail_->setReadOnly(true);
   job_detail_->setPlaceholderText("Select a job to view details.");
   job_info_layout->addWidget(job_detail_);
+  auto* progress_row = new QHBoxLayout();
+  progress_row->addWidget(new QLabel("Convergence", job_info_panel));
+  progress_metric_ = new QComboBox(job_info_panel);
+  progress_metric_->addItems({"Final |R| (log10)", "Nonlinear its",
+                              "Linear its", "dt", "Wall time per step (s)"});
+  progress_row->addWidget(progress_metric_);
+  auto* progress_export_btn = new QPushButton("Export CSV", job_info_panel);
+  progress_row->addWidget(progress_export_btn);
+  progress_row->addStretch(1);
+  job_info_layout->addLayout(progress_row);
+  progress_plot_ = new PlotWidget(job_info_panel);
+  progress_plot_->set_message("Select a job to plot its solver steps.");
+  job_info_layout->addWidget(progress_plot_);
   job_split->addWidget(job_info_panel);
   job_split->addWidget(job_page);
   job_split->setStretchFactor(0, 0);
@@ -1366,6 +1392,18 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
                              if (gmsh_panel_) {
                                gmsh_panel_->set_mesh_generation_dim(3);
                                gmsh_panel_->generate_mesh();
+                               if (gmsh_panel_->mesh_job_running()) {
+                                 connect(gmsh_panel_,
+                                         &GmshPanel::mesh_generation_finished,
+                                         this,
+                                         [this](bool ok) {
+                                           if (ok) {
+                                             start_submit_workflow();
+                                           }
+                                         },
+                                         Qt::SingleShotConnection);
+                                 return;
+                               }
                              }
                              start_submit_workflow();
                            }},
@@ -1394,6 +1432,9 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
                                moose_panel_->stop_job();
                              }
                            }},
+                           {"Parameter Sweep...", [this]() {
+                             show_sweep_dialog();
+                           }},
                        });
 
   assign_module_actions(viz_tab,
@@ -1453,20 +1494,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
                            {"Open as Text", [open_selected_result_as_text]() {
                              open_selected_result_as_text();
                            }},
-                           {"Open Job Log", [this]() {
-                             if (!moose_panel_) {
-                               return;
-                             }
-                             QDialog dialog(this);
-                             dialog.setWindowTitle("Job Log");
-                             dialog.resize(800, 500);
-                             auto* layout = new QVBoxLayout(&dialog);
-                             auto* log_view = new QPlainTextEdit(&dialog);
-                             log_view->setReadOnly(true);
-                             log_view->setPlainText(moose_panel_->log_text());
-                             layout->addWidget(log_view);
-                             dialog.exec();
-                           }},
+                           {"Open Job Log", [this]() { show_job_log(); }},
                        });
 
   apply_toolbar_actions = [this,
@@ -1627,7 +1655,11 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
           [this, center_tabs]() { center_tabs->setCurrentIndex(2); });
 
   connect(mesh_page, &GmshPanel::mesh_written, job_page,
-          &MoosePanel::set_mesh_path);
+          [this, job_page](const QString& path) {
+            if (!sweep_meshing_) {
+              job_page->set_mesh_path(path);
+            }
+          });
   connect(mesh_page, &GmshPanel::boundary_groups, job_page,
           &MoosePanel::set_boundary_groups);
   connect(mesh_page, &GmshPanel::boundary_groups, property_editor_,
@@ -1635,15 +1667,24 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
   connect(mesh_page, &GmshPanel::volume_groups, property_editor_,
           &PropertyEditor::set_volume_groups);
   connect(mesh_page, &GmshPanel::mesh_written, viewer_,
-          &VtkViewer::set_mesh_file);
+          [this](const QString& path) {
+            if (!sweep_meshing_) {
+              viewer_->set_mesh_file(path);
+            }
+          });
   connect(mesh_page, &GmshPanel::physical_group_selected, viewer_,
           &VtkViewer::set_mesh_group_filter);
   connect(viewer_, &VtkViewer::mesh_group_picked, mesh_page,
           &GmshPanel::select_physical_group);
   connect(viewer_, &VtkViewer::mesh_entity_picked, mesh_page,
           &GmshPanel::apply_entity_pick);
+  connect(viewer_, &VtkViewer::log_message, console_,
+          &QPlainTextEdit::appendPlainText);
   connect(mesh_page, &GmshPanel::mesh_written, this,
           [this](const QString& path) {
+            if (sweep_meshing_) {
+              return;
+            }
             upsert_mesh_item(path);
             statusBar()->showMessage("Mesh generated.", 2000);
           });
@@ -1651,7 +1692,12 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
           &VtkViewer::set_exodus_file);
   connect(job_page, &MoosePanel::exodus_history, viewer_,
           &VtkViewer::set_exodus_history);
+  // Sweep cases are ordinary jobs; these only follow them for the sweep.
   connect(job_page, &MoosePanel::job_started, this,
+          [this](const QVariantMap& info) { on_sweep_job_started(info); });
+  connect(job_page, &MoosePanel::job_finished, this,
+          [this](const QVariantMap& info) { on_sweep_job_finished(info); });
+  connect(job_page, &MoosePanel::job_queued, this,
           [this](const QVariantMap& info) {
             auto* root = find_root_item("Jobs");
             if (!root) {
@@ -1663,28 +1709,53 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
                 base.isEmpty()
                     ? QString("job_%1").arg(root->childCount() + 1)
                     : base;
-            active_job_item_ = add_child_item(root, name, "Jobs", info);
-            statusBar()->showMessage("Job running...", 2000);
+            auto* item = add_child_item(root, name, "Jobs", info);
             QVariantMap params = info;
+            params.insert("status", "Queued");
+            item->setData(0, PropertyEditor::kParamsRole, params);
+            job_items_.insert(info.value("job_id").toInt(), item);
+            append_job_row(name, params);
+            statusBar()->showMessage("Job queued.", 2000);
+          });
+  connect(job_page, &MoosePanel::job_started, this,
+          [this](const QVariantMap& info) {
+            const int id = info.value("job_id").toInt();
+            auto* item = job_items_.value(id);
+            if (!item) {
+              return;
+            }
+            QVariantMap params =
+                item->data(0, PropertyEditor::kParamsRole).toMap();
             params.insert("status", "Running");
-            params.insert("start_time",
-                          QDateTime::currentDateTime().toString(Qt::ISODate));
-            active_job_item_->setData(0, PropertyEditor::kParamsRole, params);
-            active_job_row_ = append_job_row(name, params);
+            params.insert("start_time", info.value("start_time"));
+            params.insert("duration", "0s");
+            item->setData(0, PropertyEditor::kParamsRole, params);
+            const int row = job_row(id);
+            if (row >= 0) {
+              update_job_row(row, item->text(0), params);
+              if (job_table_->currentRow() == row) {
+                update_job_detail(row);
+              }
+            }
+            statusBar()->showMessage("Job running...", 2000);
           });
   connect(job_page, &MoosePanel::job_finished, this,
           [this](const QVariantMap& info) {
-            if (!active_job_item_) {
+            const int id = info.value("job_id").toInt();
+            const int row = job_row(id);
+            auto* item = job_items_.take(id);
+            if (!item) {
               return;
             }
             QVariantMap params =
-                active_job_item_->data(0, PropertyEditor::kParamsRole).toMap();
+                item->data(0, PropertyEditor::kParamsRole).toMap();
             for (auto it = info.begin(); it != info.end(); ++it) {
               params.insert(it.key(), it.value());
             }
-            const QString status = info.value("status").toString() == "Normal"
-                                       ? "Completed"
-                                       : "Failed";
+            const QString outcome = info.value("status").toString();
+            const QString status = outcome == "Normal"      ? "Completed"
+                                   : outcome == "Cancelled" ? "Cancelled"
+                                                            : "Failed";
             params.insert("status", status);
             const QString start = params.value("start_time").toString();
             if (!start.isEmpty()) {
@@ -1696,19 +1767,44 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
                 params.insert("duration", QString::number(seconds) + "s");
               }
             }
-            active_job_item_->setData(0, PropertyEditor::kParamsRole, params);
+            item->setData(0, PropertyEditor::kParamsRole, params);
             const QString exodus = info.value("exodus").toString();
             if (!exodus.isEmpty()) {
-              upsert_result_item(exodus, active_job_item_->text(0));
+              upsert_result_item(exodus, item->text(0));
+            }
+            if (row >= 0) {
+              update_job_row(row, item->text(0), params);
+              if (job_table_->currentRow() == row) {
+                update_job_detail(row);
+                update_progress_plot(row);
+              }
+            }
+            statusBar()->showMessage(QString("Job %1.").arg(status.toLower()),
+                                     2000);
+          });
+  connect(job_page, &MoosePanel::job_progress, this,
+          [this](const QVariantMap& summary) {
+            // Only the table row is touched per step; the Jobs tree item
+            // takes the final summary with job_finished.
+            const int row = job_row(summary.value("job_id").toInt());
+            auto* item = row >= 0 ? job_table_->item(row, 0) : nullptr;
+            if (!item) {
+              return;
+            }
+            QVariantMap params = item->data(Qt::UserRole).toMap();
+            for (auto it = summary.begin(); it != summary.end(); ++it) {
+              params.insert(it.key(), it.value());
             }
-            if (active_job_row_ >= 0) {
-              update_job_row(active_job_row_, active_job_item_->text(0), params);
-              update_job_detail(active_job_row_);
+            update_job_row(row, item->text(), params);
+            if (job_table_->currentRow() == row) {
+              update_progress_plot(row);
             }
-            active_job_item_ = nullptr;
-            active_job_row_ = -1;
-            statusBar()->showMessage("Job finished.", 2000);
           });
+  job_clock_ = new QTimer(this);
+  job_clock_->setInterval(1000);
+  connect(job_clock_, &QTimer::timeout, this,
+          [this]() { refresh_running_durations(); });
+  job_clock_->start();
   connect(job_page, &MoosePanel::exodus_ready, this,
           [this](const QString& path) { upsert_result_item(path, ""); });
 
@@ -1718,7 +1814,14 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     }
   });
   connect(job_stop_btn, &QPushButton::clicked, this, [this]() {
-    if (moose_panel_) {
+    if (!moose_panel_) {
+      return;
+    }
+    // The selected job if it is queued or running, else the followed one.
+    const int id = live_job_id(job_table_->currentRow());
+    if (id > 0 && moose_panel_->is_job_active(id)) {
+      moose_panel_->cancel_job(id);
+    } else {
       moose_panel_->stop_job();
     }
   });
@@ -1746,22 +1849,16 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
       statusBar()->showMessage("Result loaded.", 2000);
     }
   });
-  connect(job_log_btn, &QPushButton::clicked, this, [this]() {
-    if (!moose_panel_) {
-      return;
-    }
-    QDialog dialog(this);
-    dialog.setWindowTitle("Job Log");
-    dialog.resize(800, 500);
-    auto* layout = new QVBoxLayout(&dialog);
-    auto* log_view = new QPlainTextEdit(&dialog);
-    log_view->setReadOnly(true);
-    log_view->setPlainText(moose_panel_->log_text());
-    layout->addWidget(log_view);
-    dialog.exec();
-  });
+  connect(job_log_btn, &QPushButton::clicked, this, [this]() { show_job_log(); });
+  connect(progress_export_btn, &QPushButton::clicked, this,
+          [this]() { export_job_progress(); });
+  connect(progress_metric_, &QComboBox::currentIndexChanged, this,
+          [this]() { update_progress_plot(job_table_->currentRow()); });
   connect(job_table_, &QTableWidget::currentCellChanged, this,
-          [this](int row, int, int, int) { update_job_detail(row); });
+          [this](int row, int, int, int) {
+            update_job_detail(row);
+            update_progress_plot(row);
+          });
 
   connect(model_tree_, &QTreeWidget::itemSelectionChanged, this, [this]() {
     auto* item = model_tree_->currentItem();
@@ -1846,6 +1943,10 @@ void MainWindow::build_menu() {
   action_run_ = job_menu->addAction("Run");
   action_check_ = job_menu->addAction("Check Input");
   action_stop_ = job_menu->addAction("Stop");
+  job_menu->addSeparator();
+  auto* action_sweep = job_menu->addAction("Parameter Sweep...");
+  connect(action_sweep, &QAction::triggered, this,
+          [this]() { show_sweep_dialog(); });
   action_run_->setShortcut(QKeySequence(Qt::Key_F5));
   action_check_->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_K));
   action_stop_->setShortcut(QKeySequence(Qt::SHIFT | Qt::Key_F5));
@@ -2559,6 +2660,9 @@ void MainWindow::start_submit_workflow() {
     }
     gmsh_panel_->set_mesh_generation_dim(3);
     gmsh_panel_->generate_mesh();
+    if (gmsh_panel_->mesh_job_running()) {
+      return {};
+    }
     const QString after_mesh =
         moose_panel_->moose_settings().value("mesh_path").toString();
     if (!after_mesh.isEmpty()) {
@@ -2567,7 +2671,28 @@ void MainWindow::start_submit_workflow() {
     return latest_mesh_from_project();
   };
 
+  if (gmsh_panel_->mesh_job_running()) {
+    if (statusBar()) {
+      statusBar()->showMessage("Mesh generation in progress, submit later.",
+                               3000);
+    }
+    return;
+  }
   const QString mesh_path = sync_mesh_for_submit();
+  if (mesh_path.isEmpty() && gmsh_panel_->mesh_job_running()) {
+    // Resume once the background mesh job has written the mesh.
+    connect(gmsh_panel_, &GmshPanel::mesh_generation_finished, this,
+            [this](bool ok) {
+              if (ok) {
+                start_submit_workflow();
+              }
+            },
+            Qt::SingleShotConnection);
+    if (statusBar()) {
+      statusBar()->showMessage("Generating mesh before submit...", 3000);
+    }
+    return;
+  }
   if (mesh_path.isEmpty()) {
     if (statusBar()) {
       statusBar()->showMessage("No mesh found, cannot submit without mesh.", 3000);
@@ -3290,6 +3415,10 @@ void MainWindow::remove_item(QTreeWidgetItem* item) {
     return;
   }
   auto* parent = item->parent();
+  // A removed job keeps running; its updates just have no row any more.
+  for (auto it = job_items_.begin(); it != job_items_.end();) {
+    it = it.value() == item ? job_items_.erase(it) : std::next(it);
+  }
   parent->removeChild(item);
   delete item;
   set_project_dirty(true);
@@ -3373,9 +3502,18 @@ void MainWindow::update_job_row(int row, const QString& name,
   set_item(1, params.value("status").toString());
   set_item(2, params.value("start_time").toString());
   set_item(3, params.value("duration").toString());
-  set_item(4, params.value("mesh").toString());
-  set_item(5, params.value("exec").toString());
-  set_item(6, params.value("exodus").toString());
+  auto number = [&params](const char* key, char format, int precision) {
+    const QVariant value = params.value(key);
+    return value.isValid() ? QString::number(value.toDouble(), format, precision)
+                           : QString();
+  };
+  set_item(4, params.value("steps").toString());
+  set_item(5, number("steps_per_s", 'f', 2));
+  set_item(6, number("avg_nl_its", 'f', 1));
+  set_item(7, number("last_residual", 'e', 2));
+  set_item(8, params.value("mesh").toString());
+  set_item(9, params.value("exec").toString());
+  set_item(10, params.value("exodus").toString());
   if (auto* item = job_table_->item(row, 0)) {
     item->setData(Qt::UserRole, params);
   }
@@ -3406,15 +3544,769 @@ void MainWindow::update_job_detail(int row) {
   lines << QString("Workdir: %1").arg(params.value("workdir").toString());
   lines << QString("Result: %1").arg(params.value("exodus").toString());
   lines << QString("Exit: %1").arg(params.value("exit_code").toString());
-  if (moose_panel_) {
-    const QString tail = moose_panel_->log_tail(30);
-    if (!tail.isEmpty()) {
-      lines << "" << "Log (latest)" << tail;
-    }
+  // Each job keeps its own log file; recent ones are served from memory.
+  const QString log_path = params.value("log").toString();
+  const int live_id = live_job_id(row);
+  QString tail;
+  if (live_id > 0) {
+    tail = moose_panel_->job_log(live_id)->tail(30).join("\n");
+  } else if (!log_path.isEmpty()) {
+    tail = JobLog::ReadTail(log_path, 30).join("\n");
+  } else if (moose_panel_) {
+    tail = moose_panel_->log_tail(30);
+  }
+  if (!log_path.isEmpty()) {
+    lines << QString("Log: %1").arg(log_path);
+  }
+  if (!tail.isEmpty()) {
+    lines << "" << "Log (latest)" << tail;
   }
   job_detail_->setPlainText(lines.join("\n"));
 }
 
+int MainWindow::job_row(int job_id) const {
+  // Rows mirror the children of the Jobs root in order.
+  auto* item = job_items_.value(job_id);
+  auto* parent = item ? item->parent() : nullptr;
+  const int row = parent ? parent->indexOfChild(item) : -1;
+  return job_table_ && row < job_table_->rowCount() ? row : -1;
+}
+
+int MainWindow::live_job_id(int row) const {
+  auto* item = job_table_ && row >= 0 ? job_table_->item(row, 0) : nullptr;
+  if (!item || !moose_panel_) {
+    return 0;
+  }
+  // Ids restart every session, so the log path confirms the match.
+  const QVariantMap params = item->data(Qt::UserRole).toMap();
+  const int id = params.value("job_id").toInt();
+  JobLog* log = id > 0 ? moose_panel_->job_log(id) : nullptr;
+  return log && log->path() == params.value("log").toString() ? id : 0;
+}
+
+void MainWindow::refresh_running_durations() {
+  const QDateTime now = QDateTime::currentDateTime();
+  for (auto it = job_items_.begin(); it != job_items_.end(); ++it) {
+    const int row = job_row(it.key());
+    auto* cell = row >= 0 ? job_table_->item(row, 3) : nullptr;
+    const QVariantMap params =
+        it.value()->data(0, PropertyEditor::kParamsRole).toMap();
+    if (!cell || params.value("status").toString() != "Running") {
+      continue;
+    }
+    const QDateTime start =
+        QDateTime::fromString(params.value("start_time").toString(), Qt::ISODate);
+    if (start.isValid()) {
+      cell->setText(QString::number(start.secsTo(now)) + "s");
+    }
+  }
+}
+
+std::vector<MooseStep> MainWindow::job_progress_steps(int row) const {
+  if (const int id = live_job_id(row)) {
+    return moose_panel_->progress(id)->steps();
+  }
+  auto* item = job_table_ && row >= 0 ? job_table_->item(row, 0) : nullptr;
+  if (!item) {
+    return {};
+  }
+  const QString csv = item->data(Qt::UserRole).toMap().value("progress").toString();
+  return csv.isEmpty() ? std::vector<MooseStep>() : MooseProgress::ReadCsv(csv);
+}
+
+void MainWindow::update_progress_plot(int row) {
+  if (!progress_plot_ || !progress_metric_) {
+    return;
+  }
+  const std::vector<MooseStep> steps = job_progress_steps(row);
+  if (steps.empty()) {
+    progress_plot_->set_message(row < 0 ? "Select a job to plot its solver steps."
+                                        : "No solver steps recorded.");
+    return;
+  }
+  const int metric = progress_metric_->currentIndex();
+  std::vector<double> x;
+  std::vector<double> y;
+  x.reserve(steps.size());
+  y.reserve(steps.size());
+  for (const MooseStep& s : steps) {
+    double value = 0.0;
+    switch (metric) {
+      case 0:
+        value = s.final_residual > 0.0
+                    ? std::log10(s.final_residual)
+                    : std::numeric_limits<double>::quiet_NaN();
+        break;
+      case 1:
+        value = s.nonlinear_its;
+        break;
+      case 2:
+        value = s.linear_its;
+        break;
+      case 3:
+        value = s.dt;
+        break;
+      default:
+        value = s.wall_s;
+        break;
+    }
+    x.push_back(static_cast<double>(s.step));
+    y.push_back(value);
+  }
+  progress_plot_->set_series(
+      x, y, progress_metric_->currentText() + " per time step");
+}
+
+void MainWindow::export_job_progress() {
+  const int row = job_table_ ? job_table_->currentRow() : -1;
+  const std::vector<MooseStep> steps = job_progress_steps(row);
+  if (steps.empty()) {
+    statusBar()->showMessage("No solver steps to export.", 2000);
+    return;
+  }
+  const QString name = job_table_->item(row, 0)->text();
+  const QString path = QFileDialog::getSaveFileName(
+      this, "Export Solver Progress", name + "_progress.csv",
+      "CSV Files (*.csv);;All Files (*)");
+  if (path.isEmpty()) {
+    return;
+  }
+  QString error;
+  if (!MooseProgress::WriteCsv(steps, path, &error)) {
+    QMessageBox::warning(this, "Export Solver Progress", error);
+    return;
+  }
+  statusBar()->showMessage(
+      QString("Exported %1 steps to %2").arg(steps.size()).arg(path), 3000);
+}
+
+void MainWindow::show_job_log() {
+  if (!moose_panel_) {
+    return;
+  }
+  // The selected job, else the one the MOOSE panel follows. The queue may
+  // drop an old log while the dialog is open, hence the QPointer.
+  const int row = job_table_ ? job_table_->currentRow() : -1;
+  const int id = row >= 0 ? live_job_id(row) : moose_panel_->followed_job();
+  QPointer<JobLog> log = moose_panel_->job_log(id);
+  constexpr int kDialogLines = 5000;
+  const QString row_log =
+      row >= 0 && job_table_->item(row, 0)
+          ? job_table_->item(row, 0)->data(Qt::UserRole).toMap()
+                .value("log").toString()
+          : QString();
+  QDialog dialog(this);
+  dialog.setWindowTitle(log ? QString("Job Log - %1")
+                                  .arg(QFileInfo(log->path()).fileName())
+                            : QString("Job Log"));
+  dialog.resize(800, 500);
+  auto* layout = new QVBoxLayout(&dialog);
+  auto* search_row = new QHBoxLayout();
+  auto* search_edit = new QLineEdit(&dialog);
+  search_edit->setPlaceholderText("Search the whole log");
+  auto* search_btn = new QPushButton("Find", &dialog);
+  search_row->addWidget(search_edit, 1);
+  search_row->addWidget(search_btn);
+  layout->addLayout(search_row);
+  auto* status = new QLabel(&dialog);
+  layout->addWidget(status);
+  auto* log_view = new QPlainTextEdit(&dialog);
+  log_view->setReadOnly(true);
+  log_view->setLineWrapMode(QPlainTextEdit::NoWrap);
+  layout->addWidget(log_view, 1);
+
+  if (!log) {
+    // Older jobs: their file's tail, without the index a search needs.
+    search_edit->setEnabled(false);
+    search_btn->setEnabled(false);
+    if (!row_log.isEmpty()) {
+      status->setText(row_log);
+      log_view->setPlainText(
+          JobLog::ReadTail(row_log, kDialogLines).join("\n"));
+    } else {
+      log_view->setPlainText(moose_panel_->log_text());
+    }
+    dialog.exec();
+    return;
+  }
+  // Only the tail is loaded; the rest of the run stays on disk and is
+  // reached through the search.
+  const QStringList tail = log->tail(kDialogLines);
+  const QString summary =
+      QString("%1 lines (%2 MB) in %3; showing the last %4")
+          .arg(log->line_count())
+          .arg(static_cast<double>(log->bytes()) / 1048576.0, 0, 'f', 1)
+          .arg(log->path())
+          .arg(tail.size());
+  status->setText(summary);
+  log_view->setPlainText(tail.join("\n"));
+
+  auto run_search = [log, search_edit, status, log_view, tail, summary]() {
+    if (!log) {
+      status->setText("The log is no longer in memory.");
+      return;
+    }
+    const QString needle = search_edit->text();
+    if (needle.isEmpty()) {
+      log->cancel_search();
+      status->setText(summary);
+      log_view->setPlainText(tail.join("\n"));
+      return;
+    }
+    status->setText(QString("Searching for \"%1\"...").arg(needle));
+    log->start_search(needle);
+  };
+  connect(search_btn, &QPushButton::clicked, &dialog, run_search);
+  connect(search_edit, &QLineEdit::returnPressed, &dialog, run_search);
+  connect(log, &JobLog::search_finished, &dialog,
+          [status, log_view](const QString& needle,
+                             const QVector<JobLogHit>& hits, bool truncated,
+                             double ms) {
+            QStringList lines;
+            lines.reserve(hits.size());
+            for (const JobLogHit& hit : hits) {
+              lines << QString("%1: %2").arg(hit.line + 1).arg(hit.text);
+            }
+            log_view->setPlainText(lines.join("\n"));
+            status->setText(QString("%1%2 matches for \"%3\" in %4 ms")
+                                .arg(hits.size())
+                                .arg(truncated ? "+" : "")
+                                .arg(needle)
+                                .arg(ms, 0, 'f', 0));
+          });
+  dialog.exec();
+  if (log) {
+    log->cancel_search();
+  }
+}
+
+struct MainWindow::SweepRun {
+  int serial = 0;
+  std::vector<SweepFactor> factors;
+  QStringList globals;
+  QString dir;
+  int max_parallel = 1;
+  std::vector<SweepCase> cases;
+  // Cases [0, prepared) have an input file (or failed to get one).
+  std::size_t prepared = 0;
+  std::size_t next_submit = 0;
+  int active = 0;
+  bool preparing = true;
+  bool cancelled = false;
+  // Mesh key -> mesh file; cases differing only in solver parameters share
+  // one mesh.
+  QMap<QString, QString> meshes;
+  QSet<QString> failed_meshes;
+  // Job id -> position in `cases`.
+  QHash<int, std::size_t> jobs;
+  std::vector<QThread*> readers;
+  // What preparing the cases changes, restored once all inputs exist.
+  QMap<QString, QVariantMap> saved_params;
+  QVariantMap saved_gmsh;
+  QVariantMap saved_moose;
+};
+
+MainWindow::~MainWindow() {
+  if (sweep_) {
+    for (QThread* reader : sweep_->readers) {
+      reader->wait();
+    }
+  }
+}
+
+QTreeWidgetItem* MainWindow::sweep_item(const QString& target) const {
+  // Item names may contain '/'; the root and the key may not.
+  QTreeWidgetItem* root = find_root_item(target.section('/', 0, 0));
+  const QString name = target.section('/', 1, -2);
+  for (int i = 0; root && i < root->childCount(); ++i) {
+    if (root->child(i)->text(0) == name) {
+      return root->child(i);
+    }
+  }
+  return nullptr;
+}
+
+QStringList MainWindow::sweep_targets() const {
+  QStringList targets;
+  // The roots sync_model_to_input() turns into input blocks.
+  for (const char* root_name : {"Functions", "Variables", "Materials", "BC",
+                                "Loads", "Outputs", "Steps"}) {
+    const QTreeWidgetItem* root = find_root_item(root_name);
+    for (int i = 0; root && i < root->childCount(); ++i) {
+      const QTreeWidgetItem* item = root->child(i);
+      const QVariantMap params =
+          item->data(0, PropertyEditor::kParamsRole).toMap();
+      for (auto it = params.begin(); it != params.end(); ++it) {
+        targets << QString("%1/%2/%3")
+                       .arg(QString::fromLatin1(root_name), item->text(0),
+                            it.key());
+      }
+    }
+  }
+  if (gmsh_panel_) {
+    const QVariantMap settings = gmsh_panel_->gmsh_settings();
+    for (auto it = settings.begin(); it != settings.end(); ++it) {
+      const int type = it.value().typeId();
+      const bool numeric = type == QMetaType::Double ||
+                           type == QMetaType::Int || type == QMetaType::Bool;
+      if (numeric && !it.key().startsWith("auto_") &&
+          !it.key().startsWith("mesh_cache")) {
+        targets << "gmsh/" + it.key();
+      }
+    }
+  }
+  return targets;
+}
+
+void MainWindow::show_sweep_dialog() {
+  if (!sweep_dialog_) {
+    sweep_dialog_ = new SweepDialog(this);
+    connect(sweep_dialog_, &SweepDialog::start_requested, this,
+            [this]() { start_sweep(); });
+    connect(sweep_dialog_, &SweepDialog::cancel_requested, this,
+            [this]() { cancel_sweep(); });
+  }
+  sweep_dialog_->set_targets(sweep_targets());
+  if (sweep_) {
+    sweep_dialog_->show();
+    sweep_dialog_->raise();
+    sweep_dialog_->activateWindow();
+    return;
+  }
+  QString base =
+      moose_panel_ ? moose_panel_->moose_settings().value("workdir").toString()
+                   : QString();
+  if (base.isEmpty()) {
+    base = project_path_.isEmpty() ? QDir::currentPath()
+                                   : QFileInfo(project_path_).absolutePath();
+  }
+  sweep_dialog_->set_default_dir(QDir(base).filePath(
+      "sweeps/sweep_" +
+      QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")));
+  sweep_dialog_->show();
+  sweep_dialog_->raise();
+  sweep_dialog_->activateWindow();
+}
+
+void MainWindow::start_sweep() {
+  if (!sweep_dialog_ || !moose_panel_ || !gmsh_panel_) {
+    return;
+  }
+  if (sweep_) {
+    sweep_dialog_->set_status("A sweep is already running.");
+    return;
+  }
+  static int sweep_serial = 0;
+  auto run = std::make_unique<SweepRun>();
+  run->serial = ++sweep_serial;
+  QString error;
+  run->factors = sweep_dialog_->factors(&error);
+  const QVariantMap gmsh = gmsh_panel_->gmsh_settings();
+  bool mesh_factors = false;
+  for (const SweepFactor& f : run->factors) {
+    if (f.is_mesh()) {
+      mesh_factors = true;
+      const QVariant current = gmsh.value(f.key());
+      for (const QString& value : f.values) {
+        QVariant converted(value);
+        if (!current.isValid() || !converted.convert(current.metaType())) {
+          error = QString("%1 cannot take \"%2\".").arg(f.target, value);
+        }
+      }
+    } else if (!sweep_item(f.target)) {
+      error = "No model item for " + f.target + ".";
+    } else {
+      run->saved_params.insert(
+          f.target.section('/', 0, -2),
+          sweep_item(f.target)->data(0, PropertyEditor::kParamsRole).toMap());
+    }
+  }
+  if (error.isEmpty()) {
+    run->cases = ExpandSweep(run->factors, sweep_dialog_->design(), &error);
+  }
+  run->dir = sweep_dialog_->output_dir();
+  if (!run->dir.isEmpty()) {
+    // Case inputs, meshes and sweep_results.csv of an earlier sweep must
+    // not be overwritten; a used directory gets a numbered sibling.
+    const QString requested = QDir::cleanPath(run->dir);
+    run->dir = requested;
+    const auto used = [](const QString& dir) {
+      return QDir(dir).exists() &&
+             !QDir(dir).isEmpty(QDir::AllEntries | QDir::NoDotAndDotDot);
+    };
+    for (int n = 2; used(run->dir); ++n) {
+      run->dir = QString("%1_%2").arg(requested).arg(n);
+    }
+  }
+  if (error.isEmpty() && (run->dir.isEmpty() || !QDir().mkpath(run->dir))) {
+    error = "Cannot create the output directory.";
+  }
+  if (!error.isEmpty()) {
+    sweep_dialog_->set_status(error);
+    return;
+  }
+  if (run->dir != QDir::cleanPath(sweep_dialog_->output_dir())) {
+    sweep_dialog_->set_output_dir(run->dir);
+    console_->appendPlainText("Sweep output directory in use; writing to " +
+                              run->dir);
+  }
+  run->dir = QDir(run->dir).absolutePath();
+  run->globals = sweep_dialog_->globals();
+  run->max_parallel = sweep_dialog_->max_parallel();
+  run->saved_gmsh = gmsh;
+  const QVariantMap moose = moose_panel_->moose_settings();
+  for (const char* key : {"mesh_path", "template_key", "input_text"}) {
+    run->saved_moose.insert(key, moose.value(key));
+  }
+  if (mesh_factors) {
+    // Swept meshes are files; switch generated-mesh templates over as the
+    // submit workflow does.
+    const QString template_key = moose.value("template_key").toString();
+    if (template_key == "generated") {
+      moose_panel_->set_template_by_key("filemesh");
+    } else if (template_key == "tm_generated") {
+      moose_panel_->set_template_by_key("tm_filemesh");
+    }
+  }
+  sweep_ = std::move(run);
+  sweep_dialog_->show_cases(sweep_->factors, sweep_->globals, sweep_->cases);
+  sweep_dialog_->set_running(true);
+  console_->appendPlainText(QString("Parameter sweep: %1 cases in %2.")
+                                .arg(sweep_->cases.size())
+                                .arg(sweep_->dir));
+  prepare_sweep_cases();
+}
+
+void MainWindow::cancel_sweep() {
+  if (!sweep_) {
+    return;
+  }
+  sweep_->cancelled = true;
+  sweep_dialog_->set_status("Cancelling sweep...");
+  // Job ids first: cancelling a waiting job finishes it right away.
+  const QList<int> ids = sweep_->jobs.keys();
+  for (const int id : ids) {
+    moose_panel_->cancel_job(id);
+  }
+  // A mesh job still running resumes preparation, which then stops.
+  finish_sweep_preparation();
+}
+
+void MainWindow::prepare_sweep_cases() {
+  SweepRun* run = sweep_.get();
+  while (run && run->preparing && !run->cancelled &&
+         run->prepared < run->cases.size()) {
+    SweepCase& c = run->cases[run->prepared];
+    QVariantMap mesh_overrides;
+    suppress_dirty_ = true;
+    for (std::size_t k = 0; k < run->factors.size(); ++k) {
+      const SweepFactor& f = run->factors[k];
+      const QString& value = c.values[static_cast<int>(k)];
+      if (f.is_mesh()) {
+        mesh_overrides.insert(f.key(), value);
+      } else if (QTreeWidgetItem* item = sweep_item(f.target)) {
+        QVariantMap params = item->data(0, PropertyEditor::kParamsRole).toMap();
+        params.insert(f.key(), value);
+        item->setData(0, PropertyEditor::kParamsRole, params);
+      }
+    }
+    suppress_dirty_ = false;
+
+    if (!c.mesh_key.isEmpty()) {
+      if (!run->meshes.contains(c.mesh_key) &&
+          !run->failed_meshes.contains(c.mesh_key)) {
+        if (start_sweep_mesh(c.mesh_key, mesh_overrides)) {
+          // Resumed with this case once the mesh is written.
+          return;
+        }
+        continue;
+      }
+      if (run->failed_meshes.contains(c.mesh_key)) {
+        c.status = "Mesh failed";
+        sweep_dialog_->update_case(c);
+        ++run->prepared;
+        continue;
+      }
+      const QString mesh = run->meshes.value(c.mesh_key);
+      if (moose_panel_->moose_settings().value("mesh_path").toString() != mesh) {
+        moose_panel_->set_mesh_path(mesh);
+      }
+    }
+
+    sync_model_to_input();
+    const QString name = QString("case_%1").arg(c.index, 3, 10, QChar('0'));
+    c.workdir = QDir(run->dir).filePath(name);
+    c.input = QDir(c.workdir).filePath(name + ".i");
+    QFile file(c.input);
+    if (QDir().mkpath(c.workdir) &&
+        file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+      file.write(
+          moose_panel_->moose_settings().value("input_text").toString().toUtf8());
+      c.status = "Ready";
+    } else {
+      console_->appendPlainText("Sweep: cannot write " + c.input);
+      c.status = "Failed";
+    }
+    sweep_dialog_->update_case(c);
+    ++run->prepared;
+    // Cases run while later ones are still being meshed.
+    dispatch_sweep_cases();
+  }
+  finish_sweep_preparation();
+}
+
+bool MainWindow::start_sweep_mesh(const QString& key,
+                                  const QVariantMap& overrides) {
+  SweepRun* run = sweep_.get();
+  const int serial = run->serial;
+  auto resume = [this, serial]() {
+    if (sweep_ && sweep_->serial == serial) {
+      prepare_sweep_cases();
+    }
+  };
+  if (gmsh_panel_->mesh_job_running()) {
+    // Not ours; try again when it is done.
+    connect(gmsh_panel_, &GmshPanel::mesh_generation_finished, this,
+            [this, resume]() { QTimer::singleShot(0, this, resume); },
+            Qt::SingleShotConnection);
+    return true;
+  }
+
+  QVariantMap settings = run->saved_gmsh;
+  for (auto it = overrides.begin(); it != overrides.end(); ++it) {
+    QVariant value(it.value());
+    value.convert(settings.value(it.key()).metaType());
+    settings.insert(it.key(), value);
+  }
+  const QString path = QDir(run->dir).filePath(
+      QString("mesh_%1.msh").arg(run->meshes.size() + run->failed_meshes.size() + 1));
+  settings.insert("output_path", path);
+  // Keeps apply_gmsh_settings() from re-importing the geometry.
+  settings.insert("geometry_path", QString());
+  gmsh_panel_->apply_gmsh_settings(settings);
+  sweep_dialog_->set_status(QString("Meshing %1...").arg(key));
+
+  // A cache hit or an early failure reports before generate_mesh() returns.
+  auto synchronous = std::make_shared<bool>(true);
+  auto reported = std::make_shared<bool>(false);
+  const QMetaObject::Connection connection = connect(
+      gmsh_panel_, &GmshPanel::mesh_generation_finished, this,
+      [this, serial, key, path, synchronous, reported, resume](bool ok) {
+        *reported = true;
+        sweep_meshing_ = false;
+        if (!sweep_ || sweep_->serial != serial) {
+          return;
+        }
+        if (ok) {
+          sweep_->meshes.insert(key, path);
+        } else {
+          sweep_->failed_meshes.insert(key);
+          console_->appendPlainText("Sweep: meshing failed for " + key);
+        }
+        if (!*synchronous) {
+          // Out of the panel's signal before it meshes again.
+          QTimer::singleShot(0, this, resume);
+        }
+      },
+      Qt::SingleShotConnection);
+  sweep_meshing_ = true;
+  gmsh_panel_->generate_mesh();
+  *synchronous = false;
+  if (*reported) {
+    return false;
+  }
+  if (!gmsh_panel_->mesh_job_running()) {
+    sweep_meshing_ = false;
+    disconnect(connection);
+    run->failed_meshes.insert(key);
+    console_->appendPlainText("Sweep: mesh generation did not start.");
+    return false;
+  }
+  return true;
+}
+
+void MainWindow::finish_sweep_preparation() {
+  SweepRun* run = sweep_.get();
+  if (!run || !run->preparing) {
+    return;
+  }
+  run->preparing = false;
+  suppress_dirty_ = true;
+  for (auto it = run->saved_params.begin(); it != run->saved_params.end();
+       ++it) {
+    if (QTreeWidgetItem* item = sweep_item(it.key() + "/")) {
+      item->setData(0, PropertyEditor::kParamsRole, it.value());
+    }
+  }
+  suppress_dirty_ = false;
+  if (!run->meshes.isEmpty() || !run->failed_meshes.isEmpty()) {
+    QVariantMap gmsh = run->saved_gmsh;
+    gmsh.insert("geometry_path", QString());
+    gmsh_panel_->apply_gmsh_settings(gmsh);
+  }
+  moose_panel_->apply_moose_settings(run->saved_moose);
+  for (std::size_t i = run->prepared; i < run->cases.size(); ++i) {
+    run->cases[i].status = "Cancelled";
+    sweep_dialog_->update_case(run->cases[i]);
+  }
+  dispatch_sweep_cases();
+}
+
+void MainWindow::dispatch_sweep_cases() {
+  SweepRun* run = sweep_.get();
+  if (!run) {
+    return;
+  }
+  while (!run->cancelled && run->active < run->max_parallel &&
+         run->next_submit < run->prepared) {
+    SweepCase& c = run->cases[run->next_submit++];
+    if (c.status != "Ready") {
+      continue;
+    }
+    QVariantMap extra;
+    extra.insert("batch", true);
+    extra.insert("sweep_case", c.index);
+    if (!c.mesh_key.isEmpty()) {
+      extra.insert("mesh", run->meshes.value(c.mesh_key));
+    }
+    const int id = moose_panel_->submit_input(c.input, c.workdir, extra);
+    if (id > 0) {
+      c.job_id = id;
+      c.status = "Queued";
+      run->jobs.insert(id, static_cast<std::size_t>(c.index - 1));
+      ++run->active;
+    } else {
+      c.status = "Failed";
+    }
+    sweep_dialog_->update_case(c);
+  }
+  if (run->cancelled) {
+    for (; run->next_submit < run->prepared; ++run->next_submit) {
+      SweepCase& c = run->cases[run->next_submit];
+      if (c.status == "Ready") {
+        c.status = "Cancelled";
+        sweep_dialog_->update_case(c);
+      }
+    }
+  }
+  update_sweep_status();
+  maybe_finish_sweep();
+}
+
+void MainWindow::on_sweep_job_started(const QVariantMap& info) {
+  SweepRun* run = sweep_.get();
+  const int id = info.value("job_id").toInt();
+  if (!run || !run->jobs.contains(id)) {
+    return;
+  }
+  SweepCase& c = run->cases[run->jobs.value(id)];
+  c.status = "Running";
+  sweep_dialog_->update_case(c);
+}
+
+void MainWindow::on_sweep_job_finished(const QVariantMap& info) {
+  SweepRun* run = sweep_.get();
+  const int id = info.value("job_id").toInt();
+  if (!run || !run->jobs.contains(id)) {
+    return;
+  }
+  const std::size_t pos = run->jobs.take(id);
+  --run->active;
+  SweepCase& c = run->cases[pos];
+  c.exodus = info.value("exodus").toString();
+  const QString outcome = info.value("status").toString();
+  if (outcome == "Normal" && info.value("exit_code").toInt() == 0) {
+    c.status = "Completed";
+  } else if (outcome == "Cancelled" || run->cancelled) {
+    c.status = "Cancelled";
+  } else {
+    c.status = "Failed";
+  }
+  sweep_dialog_->update_case(c);
+  if (c.status == "Completed" && !c.exodus.isEmpty() &&
+      !run->globals.isEmpty()) {
+    read_sweep_results(pos);
+  }
+  dispatch_sweep_cases();
+}
+
+void MainWindow::read_sweep_results(std::size_t pos) {
+  SweepRun* run = sweep_.get();
+  const QString exodus = run->cases[pos].exodus;
+  const QStringList names = run->globals;
+  auto values = std::make_shared<QVariantMap>();
+  auto error = std::make_shared<QString>();
+  QThread* reader = QThread::create([exodus, names, values, error]() {
+    *values = ReadFinalGlobals(exodus, names, error.get());
+  });
+  run->readers.push_back(reader);
+  const int serial = run->serial;
+  connect(reader, &QThread::finished, this,
+          [this, reader, serial, pos, values, error]() {
+            reader->deleteLater();
+            if (!sweep_ || sweep_->serial != serial) {
+              return;
+            }
+            auto& readers = sweep_->readers;
+            readers.erase(std::remove(readers.begin(), readers.end(), reader),
+                          readers.end());
+            SweepCase& c = sweep_->cases[pos];
+            c.results = *values;
+            if (!error->isEmpty()) {
+              console_->appendPlainText(
+                  QString("Sweep case %1: %2").arg(c.index).arg(*error));
+            }
+            sweep_dialog_->update_case(c);
+            maybe_finish_sweep();
+          });
+  reader->start(QThread::LowPriority);
+}
+
+void MainWindow::update_sweep_status() {
+  const SweepRun* run = sweep_.get();
+  if (!run) {
+    return;
+  }
+  int done = 0;
+  for (const SweepCase& c : run->cases) {
+    done += c.status == "Completed" || c.status == "Failed" ||
+                    c.status == "Cancelled" || c.status == "Mesh failed"
+                ? 1
+                : 0;
+  }
+  sweep_dialog_->set_status(QString("Prepared %1/%2, running %3, done %4")
+                                .arg(run->prepared)
+                                .arg(run->cases.size())
+                                .arg(run->active)
+                                .arg(done));
+}
+
+void MainWindow::maybe_finish_sweep() {
+  const SweepRun* run = sweep_.get();
+  if (!run || run->preparing || run->active > 0 || !run->readers.empty() ||
+      run->next_submit < run->prepared) {
+    return;
+  }
+  int completed = 0;
+  for (const SweepCase& c : run->cases) {
+    completed += c.status == "Completed" ? 1 : 0;
+  }
+  const QString csv = QDir(run->dir).filePath("sweep_results.csv");
+  QString error;
+  const bool written =
+      WriteSweepCsv(csv, run->factors, run->globals, run->cases, &error);
+  const QString summary =
+      QString("Sweep %1: %2 of %3 cases completed. %4")
+          .arg(run->cancelled ? "cancelled" : "finished")
+          .arg(completed)
+          .arg(run->cases.size())
+          .arg(written ? "Results: " + csv : "Results not written: " + error);
+  console_->appendPlainText(summary);
+  sweep_dialog_->set_status(summary);
+  sweep_dialog_->set_running(false);
+  sweep_.reset();
+}
+
 void MainWindow::load_project(const QString& path) {
   try {
     suppress_dirty_ = true;
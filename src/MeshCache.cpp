@@ -0,0 +1,255 @@
+#include "gmp/MeshCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QSet>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Settings that do not change the generated mesh. The geometry path is
+// replaced by the content hash passed to MakeKey. The entity size and
+// field widgets only take effect when applied, and applied operations are
+// part of the model history hashed with the geometry.
+const QSet<QString>& ignored_setting_keys() {
+  static const QSet<QString> keys = {
+      "output_path",         "geometry_path",      "auto_mesh_on_import",
+      "auto_reload_geometry", "mesh_cache_enabled", "mesh_cache_limit_mb",
+      "entity_size_dim",     "entity_size_ids",    "entity_size_value",
+      "field_dim",           "field_entities",     "field_dist_min",
+      "field_dist_max",      "field_size_min",     "field_size_max",
+  };
+  return keys;
+}
+
+QJsonArray to_json(const QStringList& list) {
+  QJsonArray array;
+  for (const auto& s : list) {
+    array.append(s);
+  }
+  return array;
+}
+
+QStringList from_json(const QJsonValue& value) {
+  QStringList list;
+  for (const auto& v : value.toArray()) {
+    list << v.toString();
+  }
+  return list;
+}
+
+}  // namespace
+
+namespace gmp {
+
+MeshCache::MeshCache(const QString& dir) : dir_(dir) {
+  load();
+}
+
+QString MeshCache::DefaultDir() {
+  return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+         "/gmp_ise/meshes";
+}
+
+QByteArray MeshCache::HashFile(const QString& path) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return {};
+  }
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  if (!hash.addData(&file)) {
+    return {};
+  }
+  return hash.result();
+}
+
+QString MeshCache::MakeKey(const QByteArray& geometry,
+                           const QVariantMap& settings) {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(geometry);
+  hash.addData(QByteArrayLiteral("\n--settings--\n"));
+  // QVariantMap iterates in key order, so the key is stable.
+  for (auto it = settings.cbegin(); it != settings.cend(); ++it) {
+    if (ignored_setting_keys().contains(it.key())) {
+      continue;
+    }
+    hash.addData(it.key().toUtf8());
+    hash.addData(QByteArrayLiteral("="));
+    hash.addData(it.value().toString().toUtf8());
+    hash.addData(QByteArrayLiteral("\n"));
+  }
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+void MeshCache::set_limit_bytes(qint64 limit) {
+  limit_ = std::max<qint64>(0, limit);
+  evict();
+  save();
+}
+
+bool MeshCache::lookup(const QString& key, Entry* out) {
+  auto it = entries_.find(key);
+  if (it != entries_.end() && !QFileInfo::exists(dir_ + "/" + it->second.file)) {
+    entries_.erase(it);
+    it = entries_.end();
+  }
+  if (it == entries_.end()) {
+    ++misses_;
+    save();
+    return false;
+  }
+  ++hits_;
+  it->second.last_used = QDateTime::currentMSecsSinceEpoch();
+  if (out) {
+    *out = it->second;
+    out->file = dir_ + "/" + it->second.file;
+  }
+  save();
+  return true;
+}
+
+bool MeshCache::insert(const QString& key, const QString& mesh_path, int dim,
+                       const QStringList& boundary_names,
+                       const QStringList& volume_names) {
+  if (key.isEmpty() || limit_ <= 0 || !QDir().mkpath(dir_)) {
+    return false;
+  }
+  const QFileInfo info(mesh_path);
+  if (!info.exists() || info.size() > limit_) {
+    return false;
+  }
+  Entry entry;
+  entry.file = key + ".msh";
+  entry.bytes = info.size();
+  entry.last_used = QDateTime::currentMSecsSinceEpoch();
+  entry.dim = dim;
+  entry.boundary_names = boundary_names;
+  entry.volume_names = volume_names;
+
+  const QString target = dir_ + "/" + entry.file;
+  QFile::remove(target);
+  if (!QFile::copy(mesh_path, target)) {
+    return false;
+  }
+  entries_[key] = entry;
+  evict();
+  save();
+  return true;
+}
+
+void MeshCache::clear() {
+  for (const auto& [key, entry] : entries_) {
+    QFile::remove(dir_ + "/" + entry.file);
+  }
+  entries_.clear();
+  hits_ = 0;
+  misses_ = 0;
+  save();
+}
+
+QString MeshCache::stats_text() const {
+  const qint64 lookups = hits_ + misses_;
+  const double rate =
+      lookups > 0 ? 100.0 * static_cast<double>(hits_) / lookups : 0.0;
+  return QString("hits=%1 misses=%2 (%3%) entries=%4 size=%5/%6 MB")
+      .arg(hits_)
+      .arg(misses_)
+      .arg(rate, 0, 'f', 1)
+      .arg(entries_.size())
+      .arg(total_bytes() / (1024.0 * 1024.0), 0, 'f', 1)
+      .arg(limit_ / (1024.0 * 1024.0), 0, 'f', 0);
+}
+
+void MeshCache::load() {
+  entries_.clear();
+  QFile file(dir_ + "/index.json");
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+  const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+  hits_ = root.value("hits").toInteger();
+  misses_ = root.value("misses").toInteger();
+  const QJsonObject items = root.value("entries").toObject();
+  for (auto it = items.begin(); it != items.end(); ++it) {
+    const QJsonObject obj = it.value().toObject();
+    Entry entry;
+    entry.file = obj.value("file").toString();
+    entry.bytes = obj.value("bytes").toInteger();
+    entry.last_used = obj.value("last_used").toInteger();
+    entry.dim = obj.value("dim").toInt();
+    entry.boundary_names = from_json(obj.value("boundary"));
+    entry.volume_names = from_json(obj.value("volume"));
+    if (!entry.file.isEmpty()) {
+      entries_[it.key()] = entry;
+    }
+  }
+}
+
+void MeshCache::save() const {
+  if (!QDir().mkpath(dir_)) {
+    return;
+  }
+  QJsonObject items;
+  for (const auto& [key, entry] : entries_) {
+    QJsonObject obj;
+    obj.insert("file", entry.file);
+    obj.insert("bytes", entry.bytes);
+    obj.insert("last_used", entry.last_used);
+    obj.insert("dim", entry.dim);
+    obj.insert("boundary", to_json(entry.boundary_names));
+    obj.insert("volume", to_json(entry.volume_names));
+    items.insert(key, obj);
+  }
+  QJsonObject root;
+  root.insert("hits", hits_);
+  root.insert("misses", misses_);
+  root.insert("entries", items);
+
+  QSaveFile file(dir_ + "/index.json");
+  if (!file.open(QIODevice::WriteOnly)) {
+    return;
+  }
+  file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+  file.commit();
+}
+
+void MeshCache::evict() {
+  qint64 total = total_bytes();
+  if (total <= limit_) {
+    return;
+  }
+  std::vector<std::pair<qint64, QString>> by_age;
+  by_age.reserve(entries_.size());
+  for (const auto& [key, entry] : entries_) {
+    by_age.emplace_back(entry.last_used, key);
+  }
+  std::sort(by_age.begin(), by_age.end());
+  for (const auto& [last_used, key] : by_age) {
+    if (total <= limit_) {
+      break;
+    }
+    auto it = entries_.find(key);
+    total -= it->second.bytes;
+    QFile::remove(dir_ + "/" + it->second.file);
+    entries_.erase(it);
+  }
+}
+
+qint64 MeshCache::total_bytes() const {
+  qint64 total = 0;
+  for (const auto& [key, entry] : entries_) {
+    total += entry.bytes;
+  }
+  return total;
+}
+
+}  // namespace gmp
@@ -0,0 +1,364 @@
+#include "gmp/MeshJob.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef GMP_ENABLE_GMSH_GUI
+#include <gmsh.h>
+#endif
+
+namespace {
+
+struct JobCanceled {};
+
+constexpr int kAlgo2dMeshAdapt = 1;
+constexpr int kAlgo2dAutomatic = 2;
+constexpr int kAlgo2dFrontalDelaunay = 6;
+constexpr int kAlgo3dHxt = 10;
+
+#ifdef GMP_ENABLE_GMSH_GUI
+const char* high_order_method(int opt) {
+  switch (opt) {
+    case 1:
+      return "HighOrder";
+    case 2:
+      return "HighOrderElastic";
+    case 3:
+      return "HighOrderFastCurving";
+    default:
+      return nullptr;
+  }
+}
+#endif
+
+}  // namespace
+
+namespace gmp {
+
+std::pair<int, int> ResolveMeshAlgorithms(const MeshJobSpec& spec) {
+  int algo2d = spec.algo2d;
+  int algo3d = spec.algo3d;
+  if (spec.prefer_parallel_algorithms && spec.num_threads > 1) {
+    // Only HXT parallelizes a single volume; Delaunay and Frontal run one
+    // thread per region. HXT is tetrahedral, so leave recombined meshes
+    // alone.
+    if (algo3d != kAlgo3dHxt && !spec.recombine) {
+      algo3d = kAlgo3dHxt;
+    }
+    // Surfaces are meshed concurrently, but Automatic may pick MeshAdapt
+    // per surface, which does not scale; Frontal-Delaunay does.
+    if (algo2d == kAlgo2dAutomatic || algo2d == kAlgo2dMeshAdapt) {
+      algo2d = kAlgo2dFrontalDelaunay;
+    }
+  }
+  return {algo2d, algo3d};
+}
+
+MeshJob::MeshJob(const MeshJobSpec& spec, QObject* parent)
+    : QObject(parent), spec_(spec) {}
+
+void MeshJob::cancel() {
+  cancel_.store(true);
+}
+
+bool MeshJob::cancel_requested() const {
+  return cancel_.load();
+}
+
+QString MeshJob::phase_label(int phase) {
+  switch (phase) {
+    case Setup:
+      return "Setup";
+    case Mesh1D:
+      return "1D mesh";
+    case Mesh2D:
+      return "2D mesh";
+    case Mesh3D:
+      return "3D mesh";
+    case Optimize:
+      return "Optimize";
+    case Write:
+      return "Write";
+    case Report:
+      return "Report";
+    default:
+      return "Mesh";
+  }
+}
+
+void MeshJob::drain_log() {
+#ifdef GMP_ENABLE_GMSH_GUI
+  // The gmsh logger keeps every line since start(), so only forward the tail.
+  std::vector<std::string> log;
+  gmsh::logger::get(log);
+  for (std::size_t i = log_seen_; i < log.size(); ++i) {
+    emit log_line(QString::fromStdString(log[i]));
+  }
+  log_seen_ = std::max(log_seen_, log.size());
+#endif
+}
+
+void MeshJob::run() {
+  result_ = MeshJobResult();
+  result_.output_path = spec_.output_path;
+  result_.probe = spec_.probe;
+#ifndef GMP_ENABLE_GMSH_GUI
+  result_.error = "Gmsh is not enabled in this build.";
+  emit finished();
+#else
+  log_seen_ = 0;
+  int step = 0;
+  int total = 1;
+  QElapsedTimer phase_timer;
+  auto begin_phase = [&](int phase) {
+    if (cancel_requested()) {
+      throw JobCanceled();
+    }
+    emit progress(phase, step++, total);
+    phase_timer.start();
+  };
+  auto end_phase = [&](int phase) {
+    drain_log();
+    emit log_line(QString("%1 done in %2 ms")
+                      .arg(phase_label(phase))
+                      .arg(phase_timer.elapsed()));
+  };
+
+  try {
+    gmsh::option::setNumber("General.Terminal", 0);
+    gmsh::logger::start();
+
+    begin_phase(Setup);
+    gmsh::option::setNumber("Mesh.CharacteristicLengthMin", spec_.mesh_size);
+    gmsh::option::setNumber("Mesh.CharacteristicLengthMax", spec_.mesh_size);
+    // Order elevation and optimization run as their own phase after the
+    // linear mesh exists, so every generate() call below stays first order.
+    gmsh::option::setNumber("Mesh.ElementOrder", 1);
+    gmsh::option::setNumber("Mesh.HighOrderOptimize", 0);
+    gmsh::option::setNumber("Mesh.Optimize", 0);
+    const int threads = std::max(1, spec_.num_threads);
+    result_.threads = threads;
+    gmsh::option::setNumber("General.NumThreads", threads);
+    gmsh::option::setNumber("Mesh.MaxNumThreads1D", threads);
+    gmsh::option::setNumber("Mesh.MaxNumThreads2D", threads);
+    gmsh::option::setNumber("Mesh.MaxNumThreads3D", threads);
+    const auto [algo2d, algo3d] = ResolveMeshAlgorithms(spec_);
+    if (algo2d != spec_.algo2d || algo3d != spec_.algo3d) {
+      emit log_line(QString("Threads=%1: using 2D algorithm %2, 3D algorithm "
+                            "%3.")
+                        .arg(threads)
+                        .arg(algo2d)
+                        .arg(algo3d));
+    }
+    gmsh::option::setNumber("Mesh.Algorithm", algo2d);
+    gmsh::option::setNumber("Mesh.Algorithm3D", algo3d);
+    gmsh::option::setNumber("Mesh.RecombineAll", spec_.recombine ? 1 : 0);
+    gmsh::option::setNumber("Mesh.Smoothing", spec_.smoothing);
+    gmsh::option::setNumber("Mesh.MshFileVersion",
+                            spec_.msh_version == 2 ? 2.2 : 4.1);
+
+    if (spec_.build_sample_box) {
+      gmsh::clear();
+      gmsh::model::add("box_model");
+      const int box = gmsh::model::occ::addBox(0, 0, 0, spec_.size_x,
+                                               spec_.size_y, spec_.size_z);
+      gmsh::model::occ::synchronize();
+
+      const int phys = gmsh::model::addPhysicalGroup(3, {box});
+      gmsh::model::setPhysicalName(3, phys, "solid");
+      std::vector<std::pair<int, int>> faces;
+      gmsh::model::getEntities(faces, 2);
+      if (!faces.empty()) {
+        std::vector<int> face_tags;
+        face_tags.reserve(faces.size());
+        for (const auto& f : faces) {
+          face_tags.push_back(f.second);
+        }
+        const int bnd = gmsh::model::addPhysicalGroup(2, face_tags);
+        gmsh::model::setPhysicalName(2, bnd, "boundary");
+      }
+      result_.built_sample_box = true;
+    } else {
+      gmsh::model::mesh::clear();
+    }
+
+    std::vector<std::pair<int, int>> ents;
+    gmsh::model::getEntities(ents);
+    int dim = 1;
+    for (const auto& e : ents) {
+      dim = std::max(dim, e.first);
+    }
+    dim = std::min(dim, 3);
+    if (spec_.requested_dim >= 1 && spec_.requested_dim <= 3) {
+      if (spec_.requested_dim <= dim) {
+        dim = spec_.requested_dim;
+      } else {
+        emit log_line(QString("Requested mesh dim %1 exceeds geometry dim %2, "
+                              "fallback to %2.")
+                          .arg(spec_.requested_dim)
+                          .arg(dim));
+      }
+    }
+    result_.dim = dim;
+
+    const bool optimize_tets = spec_.optimize && dim == 3;
+    const bool elevate = spec_.order > 1;
+    const bool optimize_phase = optimize_tets || elevate;
+    total = 1 + dim + (optimize_phase ? 1 : 0) + (spec_.probe ? 1 : 2);
+    end_phase(Setup);
+
+    QElapsedTimer mesh_timer;
+    mesh_timer.start();
+
+    // gmsh::model::mesh::generate(d) only meshes the dimensions above what is
+    // already meshed, so calling it once per dimension gives one phase each.
+    for (int d = 1; d <= dim; ++d) {
+      const int phase = Mesh1D + d - 1;
+      begin_phase(phase);
+      gmsh::model::mesh::generate(d);
+      end_phase(phase);
+    }
+
+    if (optimize_phase) {
+      begin_phase(Optimize);
+      if (optimize_tets) {
+        gmsh::model::mesh::optimize("");
+      }
+      if (elevate) {
+        gmsh::model::mesh::setOrder(spec_.order);
+        if (const char* method = high_order_method(spec_.high_order_opt)) {
+          gmsh::model::mesh::optimize(method);
+        }
+      }
+      end_phase(Optimize);
+    }
+
+    result_.mesh_ms = mesh_timer.elapsed();
+
+    if (!spec_.probe) {
+      begin_phase(Write);
+      QDir().mkpath(QFileInfo(spec_.output_path).absolutePath());
+      gmsh::write(spec_.output_path.toStdString());
+      end_phase(Write);
+    }
+
+    begin_phase(Report);
+    const int boundary_dim = std::max(0, dim - 1);
+    std::vector<std::pair<int, int>> phys_groups;
+    gmsh::model::getPhysicalGroups(phys_groups);
+    for (const auto& p : phys_groups) {
+      if (p.first != boundary_dim && p.first != dim) {
+        continue;
+      }
+      std::string name;
+      gmsh::model::getPhysicalName(p.first, p.second, name);
+      if (p.first == boundary_dim) {
+        result_.boundary_names << QString::fromStdString(
+            name.empty() ? "boundary_" + std::to_string(p.second) : name);
+      }
+      if (p.first == dim) {
+        result_.volume_names << QString::fromStdString(
+            name.empty() ? "volume_" + std::to_string(p.second) : name);
+      }
+    }
+
+    double node_count = 0.0;
+    gmsh::option::getNumber("Mesh.NbNodes", node_count);
+    result_.node_count = static_cast<std::size_t>(node_count);
+
+    if (spec_.probe) {
+      std::vector<std::pair<int, int>> ents;
+      gmsh::model::getEntities(ents);
+      for (const auto& e : ents) {
+        result_.element_count += CountEntityElements(e.first, e.second);
+      }
+      emit log_line(QString("Nodes: %1, Elements: %2")
+                        .arg(result_.node_count)
+                        .arg(result_.element_count));
+      end_phase(Report);
+      gmsh::logger::stop();
+      result_.ok = true;
+      emit progress(Report, total, total);
+      emit finished();
+      return;
+    }
+
+    QString stats_error;
+    if (!ComputeMeshStats(spec_.num_threads, &result_.stats, &stats_error)) {
+      emit log_line(QString("Quality report failed: %1").arg(stats_error));
+    }
+    MeshQualityHistogram quality;
+    for (const auto& [key, stats] : result_.stats) {
+      result_.element_count += stats.element_count;
+      quality.merge(stats.quality);
+    }
+    emit log_line(QString("Nodes: %1, Elements: %2")
+                      .arg(result_.node_count)
+                      .arg(result_.element_count));
+    if (quality.count > 0) {
+      emit log_line("Quality (minSICN) " + quality.summary());
+      emit log_line("  histogram " + quality.bins_text());
+    }
+
+    if (!phys_groups.empty()) {
+      emit log_line("Physical group element counts:");
+    }
+    for (const auto& g : phys_groups) {
+      std::string name;
+      gmsh::model::getPhysicalName(g.first, g.second, name);
+      std::vector<int> ent_tags;
+      gmsh::model::getEntitiesForPhysicalGroup(g.first, g.second, ent_tags);
+      MeshEntityStats group;
+      for (int ent : ent_tags) {
+        auto it = result_.stats.find({g.first, ent});
+        if (it != result_.stats.end()) {
+          group.element_count += it->second.element_count;
+          group.quality.merge(it->second.quality);
+        }
+      }
+      const QString label = name.empty()
+                                ? QString("%1:%2").arg(g.first).arg(g.second)
+                                : QString("%1:%2 %3")
+                                      .arg(g.first)
+                                      .arg(g.second)
+                                      .arg(QString::fromStdString(name));
+      QString line =
+          QString("  %1 -> %2 elems").arg(label).arg(group.element_count);
+      if (group.quality.count > 0) {
+        line += ", quality " + group.quality.summary();
+      }
+      emit log_line(line);
+      if (group.quality.count > 0) {
+        emit log_line("    histogram " + group.quality.bins_text());
+      }
+    }
+    end_phase(Report);
+
+    gmsh::logger::stop();
+    result_.ok = true;
+    emit progress(Report, total, total);
+  } catch (const JobCanceled&) {
+    result_.canceled = true;
+    try {
+      gmsh::model::mesh::clear();
+      drain_log();
+      gmsh::logger::stop();
+    } catch (...) {
+    }
+  } catch (const std::exception& ex) {
+    result_.error = QString::fromUtf8(ex.what());
+    try {
+      drain_log();
+      gmsh::logger::stop();
+    } catch (...) {
+    }
+  }
+  emit finished();
+#endif
+}
+
+}  // namespace gmp
@@ -0,0 +1,274 @@
+#include "gmp/MeshSelectionIndex.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+// Below this many cells per task the thread start-up dominates.
+constexpr std::size_t kMinCellsPerTask = 1 << 18;
+
+std::int64_t make_key(int a, int b) {
+  return (static_cast<std::int64_t>(a) << 32) |
+         static_cast<std::int64_t>(static_cast<std::uint32_t>(b));
+}
+
+template <typename Fn>
+void run_tasks(int num_tasks, Fn&& fn) {
+  if (num_tasks == 1) {
+    fn(0);
+    return;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(static_cast<std::size_t>(num_tasks));
+  for (int task = 0; task < num_tasks; ++task) {
+    workers.emplace_back([&fn, task]() { fn(task); });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+}  // namespace
+
+namespace gmp {
+
+bool MeshSelectionIndex::Query::unrestricted() const {
+  return dim < 0 && phys_id < 0 && elem_type < 0 &&
+         (entity_dim < 0 || entity_tag < 0) && cell < 0;
+}
+
+bool MeshSelectionIndex::Query::operator==(const Query& other) const {
+  return dim == other.dim && phys_id == other.phys_id &&
+         elem_type == other.elem_type && entity_dim == other.entity_dim &&
+         entity_tag == other.entity_tag && cell == other.cell;
+}
+
+void MeshSelectionIndex::Lists::build(const int* a, const int* b,
+                                      std::size_t cells, int threads) {
+  keys.clear();
+  offsets.assign(1, 0);
+  ids.clear();
+  if (!a || cells == 0) {
+    return;
+  }
+  const std::size_t max_tasks =
+      std::max<std::size_t>(1, cells / kMinCellsPerTask);
+  const int num_tasks =
+      static_cast<int>(std::min<std::size_t>(std::max(1, threads), max_tasks));
+  const std::size_t chunk =
+      (cells + static_cast<std::size_t>(num_tasks) - 1) /
+      static_cast<std::size_t>(num_tasks);
+  auto key_at = [a, b](std::size_t i) {
+    return make_key(a[i], b ? b[i] : 0);
+  };
+
+  // Pass 1: distinct keys per chunk. Cells come in element blocks, so runs
+  // of equal keys are long and only the run boundaries are looked up.
+  std::vector<std::vector<std::pair<std::int64_t, std::size_t>>> runs(
+      static_cast<std::size_t>(num_tasks));
+  run_tasks(num_tasks, [&](int task) {
+    const std::size_t begin = static_cast<std::size_t>(task) * chunk;
+    const std::size_t end = std::min(cells, begin + chunk);
+    auto& out = runs[static_cast<std::size_t>(task)];
+    std::size_t i = begin;
+    while (i < end) {
+      const std::int64_t key = key_at(i);
+      std::size_t j = i + 1;
+      while (j < end && key_at(j) == key) {
+        ++j;
+      }
+      out.emplace_back(key, j - i);
+      i = j;
+    }
+  });
+
+  for (const auto& task_runs : runs) {
+    for (const auto& run : task_runs) {
+      keys.push_back(run.first);
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  auto slot_of = [this](std::int64_t key) {
+    return static_cast<std::size_t>(
+        std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+  };
+
+  // Per-chunk write cursors: chunk t starts after every earlier chunk's
+  // cells of the same key, which keeps each list ascending.
+  const std::size_t num_keys = keys.size();
+  std::vector<std::vector<std::size_t>> cursors(
+      static_cast<std::size_t>(num_tasks),
+      std::vector<std::size_t>(num_keys, 0));
+  for (int task = 0; task < num_tasks; ++task) {
+    for (const auto& run : runs[static_cast<std::size_t>(task)]) {
+      cursors[static_cast<std::size_t>(task)][slot_of(run.first)] +=
+          run.second;
+    }
+  }
+  offsets.assign(num_keys + 1, 0);
+  for (std::size_t k = 0; k < num_keys; ++k) {
+    std::size_t pos = offsets[k];
+    for (auto& task_cursor : cursors) {
+      const std::size_t n = task_cursor[k];
+      task_cursor[k] = pos;
+      pos += n;
+    }
+    offsets[k + 1] = pos;
+  }
+
+  // Pass 2: scatter the runs.
+  ids.resize(cells);
+  run_tasks(num_tasks, [&](int task) {
+    std::size_t cell = static_cast<std::size_t>(task) * chunk;
+    auto& cursor = cursors[static_cast<std::size_t>(task)];
+    for (const auto& run : runs[static_cast<std::size_t>(task)]) {
+      CellId* dst = ids.data() + cursor[slot_of(run.first)];
+      for (std::size_t n = 0; n < run.second; ++n) {
+        dst[n] = static_cast<CellId>(cell + n);
+      }
+      cursor[slot_of(run.first)] += run.second;
+      cell += run.second;
+    }
+  });
+}
+
+std::pair<const MeshSelectionIndex::CellId*, const MeshSelectionIndex::CellId*>
+MeshSelectionIndex::Lists::find(int a, int b) const {
+  const std::int64_t key = make_key(a, b);
+  const auto it = std::lower_bound(keys.begin(), keys.end(), key);
+  if (it == keys.end() || *it != key) {
+    return {nullptr, nullptr};
+  }
+  const std::size_t k = static_cast<std::size_t>(it - keys.begin());
+  return {ids.data() + offsets[k], ids.data() + offsets[k + 1]};
+}
+
+void MeshSelectionIndex::build(const int* phys_dim, const int* phys_id,
+                               const int* elem_type, const int* entity_dim,
+                               const int* entity_tag, std::size_t cells,
+                               int threads) {
+  clear();
+  dim_.build(phys_dim, nullptr, cells, threads);
+  group_.build(phys_dim, phys_id, cells, threads);
+  type_.build(elem_type, nullptr, cells, threads);
+  entity_.build(entity_dim, entity_tag, cells, threads);
+  cells_ = cells;
+}
+
+void MeshSelectionIndex::clear() {
+  dim_ = Lists();
+  group_ = Lists();
+  type_ = Lists();
+  entity_ = Lists();
+  cells_ = 0;
+}
+
+std::size_t MeshSelectionIndex::memory_bytes() const {
+  std::size_t bytes = 0;
+  for (const Lists* lists : {&dim_, &group_, &type_, &entity_}) {
+    bytes += lists->keys.capacity() * sizeof(std::int64_t) +
+             lists->offsets.capacity() * sizeof(std::size_t) +
+             lists->ids.capacity() * sizeof(CellId);
+  }
+  return bytes;
+}
+
+bool MeshSelectionIndex::select(const Query& query,
+                                std::vector<CellId>* out) const {
+  if (!out) {
+    return false;
+  }
+  out->clear();
+  if (query.unrestricted()) {
+    return false;
+  }
+
+  using Range = std::pair<const CellId*, const CellId*>;
+  std::vector<Range> ranges;
+  // A group id without a dimension matches that id in every dimension; the
+  // per-dimension lists are disjoint, so merging keeps the ids ascending.
+  std::vector<CellId> any_dim;
+  if (query.dim >= 0 && query.phys_id >= 0) {
+    ranges.push_back(group_.find(query.dim, query.phys_id));
+  } else if (query.dim >= 0) {
+    ranges.push_back(dim_.find(query.dim, 0));
+  } else if (query.phys_id >= 0) {
+    for (int d = 0; d <= 3; ++d) {
+      const Range r = group_.find(d, query.phys_id);
+      if (!r.first) {
+        continue;
+      }
+      const std::size_t mid = any_dim.size();
+      any_dim.insert(any_dim.end(), r.first, r.second);
+      std::inplace_merge(any_dim.begin(), any_dim.begin() + mid,
+                         any_dim.end());
+    }
+    ranges.emplace_back(any_dim.empty() ? nullptr : any_dim.data(),
+                        any_dim.data() + any_dim.size());
+  }
+  if (query.elem_type >= 0) {
+    ranges.push_back(type_.find(query.elem_type, 0));
+  }
+  if (query.entity_dim >= 0 && query.entity_tag >= 0) {
+    ranges.push_back(entity_.find(query.entity_dim, query.entity_tag));
+  }
+  for (const Range& r : ranges) {
+    if (!r.first) {
+      return true;
+    }
+  }
+
+  if (query.cell >= 0) {
+    if (static_cast<std::size_t>(query.cell) >= cells_) {
+      return true;
+    }
+    const CellId cell = static_cast<CellId>(query.cell);
+    for (const Range& r : ranges) {
+      if (!std::binary_search(r.first, r.second, cell)) {
+        return true;
+      }
+    }
+    out->push_back(cell);
+    return true;
+  }
+
+  // Walk the shortest list and look its ids up in the others; each lookup
+  // starts where the previous one ended.
+  std::sort(ranges.begin(), ranges.end(), [](const Range& x, const Range& y) {
+    return (x.second - x.first) < (y.second - y.first);
+  });
+  if (ranges.empty()) {
+    return true;
+  }
+  const Range base = ranges.front();
+  if (ranges.size() == 1) {
+    out->assign(base.first, base.second);
+    return true;
+  }
+  out->reserve(static_cast<std::size_t>(base.second - base.first));
+  std::vector<const CellId*> cursor;
+  for (const Range& r : ranges) {
+    cursor.push_back(r.first);
+  }
+  for (const CellId* it = base.first; it != base.second; ++it) {
+    bool keep = true;
+    for (std::size_t r = 1; r < ranges.size(); ++r) {
+      cursor[r] = std::lower_bound(cursor[r], ranges[r].second, *it);
+      if (cursor[r] == ranges[r].second) {
+        return true;
+      }
+      if (*cursor[r] != *it) {
+        keep = false;
+        break;
+      }
+    }
+    if (keep) {
+      out->push_back(*it);
+    }
+  }
+  return true;
+}
+
+}  // namespace gmp
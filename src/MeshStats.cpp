@@ -0,0 +1,247 @@
+#include "gmp/MeshStats.h"
+
+#include <QStringList>
+#include <algorithm>
+#include <thread>
+
+#ifdef GMP_ENABLE_GMSH_GUI
+#include <gmsh.h>
+#endif
+
+namespace {
+
+#ifdef GMP_ENABLE_GMSH_GUI
+// Below this many elements per task the thread start-up dominates.
+constexpr std::size_t kMinElementsPerTask = 4096;
+
+void evaluate_qualities(const std::vector<std::size_t>& tags, int threads,
+                        std::vector<double>* qualities) {
+  qualities->assign(tags.size(), 0.0);
+  if (tags.empty()) {
+    return;
+  }
+  const std::size_t max_tasks =
+      std::max<std::size_t>(1, tags.size() / kMinElementsPerTask);
+  const int num_tasks =
+      static_cast<int>(std::min<std::size_t>(std::max(1, threads), max_tasks));
+  if (num_tasks == 1) {
+    gmsh::model::mesh::getElementQualities(tags, *qualities, "minSICN");
+    return;
+  }
+  // The first lookup builds gmsh's element-by-tag cache; do it before the
+  // tasks start so they only read it.
+  std::vector<double> warm(1, 0.0);
+  gmsh::model::mesh::getElementQualities({tags.front()}, warm, "minSICN");
+
+  std::vector<std::thread> workers;
+  workers.reserve(static_cast<std::size_t>(num_tasks));
+  for (int task = 0; task < num_tasks; ++task) {
+    workers.emplace_back([&tags, qualities, task, num_tasks]() {
+      gmsh::model::mesh::getElementQualities(tags, *qualities, "minSICN",
+                                             task, num_tasks);
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+#endif
+
+}  // namespace
+
+namespace gmp {
+
+void MeshQualityHistogram::add(double q) {
+  if (count == 0) {
+    min = q;
+    max = q;
+  } else {
+    min = std::min(min, q);
+    max = std::max(max, q);
+  }
+  ++count;
+  sum += q;
+  if (q < 0.0) {
+    ++inverted;
+    return;
+  }
+  const int bin = std::min(kBins - 1, static_cast<int>(q * kBins));
+  ++bins[static_cast<std::size_t>(bin)];
+}
+
+void MeshQualityHistogram::merge(const MeshQualityHistogram& other) {
+  if (other.count == 0) {
+    return;
+  }
+  if (count == 0) {
+    min = other.min;
+    max = other.max;
+  } else {
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+  count += other.count;
+  inverted += other.inverted;
+  sum += other.sum;
+  for (int i = 0; i < kBins; ++i) {
+    bins[static_cast<std::size_t>(i)] += other.bins[static_cast<std::size_t>(i)];
+  }
+}
+
+double MeshQualityHistogram::mean() const {
+  return count > 0 ? sum / static_cast<double>(count) : 0.0;
+}
+
+QString MeshQualityHistogram::summary() const {
+  if (count == 0) {
+    return "n/a";
+  }
+  return QString("min=%1 mean=%2 max=%3")
+      .arg(min, 0, 'g', 6)
+      .arg(mean(), 0, 'g', 6)
+      .arg(max, 0, 'g', 6);
+}
+
+QString MeshQualityHistogram::bins_text() const {
+  QStringList parts;
+  if (inverted > 0) {
+    parts << QString("<0:%1").arg(inverted);
+  }
+  for (int i = 0; i < kBins; ++i) {
+    parts << QString("%1-%2:%3")
+                 .arg(static_cast<double>(i) / kBins, 0, 'f', 1)
+                 .arg(static_cast<double>(i + 1) / kBins, 0, 'f', 1)
+                 .arg(bins[static_cast<std::size_t>(i)]);
+  }
+  return parts.join(' ');
+}
+
+std::size_t CountEntityElements(int dim, int tag) {
+#ifdef GMP_ENABLE_GMSH_GUI
+  std::vector<int> types;
+  gmsh::model::mesh::getElementTypes(types, dim, tag);
+  std::size_t count = 0;
+  for (int type : types) {
+    std::vector<std::size_t> elem_tags;
+    std::vector<std::size_t> node_tags;
+    gmsh::model::mesh::preallocateElementsByType(type, true, false, elem_tags,
+                                                 node_tags, tag);
+    count += elem_tags.size();
+  }
+  return count;
+#else
+  (void)dim;
+  (void)tag;
+  return 0;
+#endif
+}
+
+bool ComputeMeshStats(int threads, MeshStatsCache* cache, QString* error) {
+  if (!cache) {
+    return false;
+  }
+  cache->clear();
+#ifndef GMP_ENABLE_GMSH_GUI
+  (void)threads;
+  if (error) {
+    *error = "Gmsh is not enabled in this build.";
+  }
+  return false;
+#else
+  try {
+    std::vector<std::pair<int, int>> ents;
+    gmsh::model::getEntities(ents);
+
+    // Per element type, the entities carrying it and their element counts in
+    // gmsh's entity order, which is also the order getElementsByType(-1)
+    // returns elements in.
+    struct TypeSlice {
+      std::pair<int, int> entity;
+      std::size_t count = 0;
+    };
+    std::map<int, std::vector<TypeSlice>> slices;
+    for (const auto& e : ents) {
+      auto& stats = (*cache)[e];
+      std::vector<int> types;
+      gmsh::model::mesh::getElementTypes(types, e.first, e.second);
+      for (int type : types) {
+        std::vector<std::size_t> elem_tags;
+        std::vector<std::size_t> node_tags;
+        gmsh::model::mesh::preallocateElementsByType(type, true, false,
+                                                     elem_tags, node_tags,
+                                                     e.second);
+        stats.element_count += elem_tags.size();
+        if (e.first >= 2 && !elem_tags.empty()) {
+          slices[type].push_back({e, elem_tags.size()});
+        }
+      }
+    }
+
+    std::vector<std::size_t> tags;
+    std::vector<std::size_t> nodes;
+    std::vector<double> qualities;
+    for (const auto& [type, parts] : slices) {
+      gmsh::model::mesh::getElementsByType(type, tags, nodes, -1);
+      nodes.clear();
+      nodes.shrink_to_fit();
+
+      std::size_t expected = 0;
+      for (const auto& part : parts) {
+        expected += part.count;
+      }
+      if (expected != tags.size()) {
+        // Entity order did not line up; fall back to one fetch per entity.
+        for (const auto& part : parts) {
+          gmsh::model::mesh::getElementsByType(type, tags, nodes,
+                                               part.entity.second);
+          evaluate_qualities(tags, threads, &qualities);
+          auto& hist = (*cache)[part.entity].quality;
+          for (double q : qualities) {
+            hist.add(q);
+          }
+        }
+        continue;
+      }
+
+      evaluate_qualities(tags, threads, &qualities);
+      std::size_t offset = 0;
+      for (const auto& part : parts) {
+        auto& hist = (*cache)[part.entity].quality;
+        for (std::size_t i = 0; i < part.count; ++i) {
+          hist.add(qualities[offset + i]);
+        }
+        offset += part.count;
+      }
+    }
+    return true;
+  } catch (const std::exception& ex) {
+    if (error) {
+      *error = QString::fromUtf8(ex.what());
+    }
+  }
+  return false;
+#endif
+}
+
+bool AggregateGroupStats(const MeshStatsCache& cache, int dim,
+                         const std::vector<int>& entity_tags,
+                         MeshEntityStats* out) {
+  if (!out) {
+    return false;
+  }
+  *out = MeshEntityStats();
+  bool complete = true;
+  for (int tag : entity_tags) {
+    const std::size_t current = CountEntityElements(dim, tag);
+    out->element_count += current;
+    auto it = cache.find({dim, tag});
+    if (it == cache.end() || it->second.element_count != current) {
+      complete = false;
+      continue;
+    }
+    out->quality.merge(it->second.quality);
+  }
+  return complete;
+}
+
+}  // namespace gmp
@@ -2,6 +2,7 @@
 
 #include <QCheckBox>
 #include <QComboBox>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileDialog>
@@ -23,15 +24,17 @@
 #include <QStringList>
 #include <QProcess>
 #include <QStandardPaths>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QThread>
+
+#include <algorithm>
 
 #include "gmp/ComboPopupFix.h"
+#include "gmp/MshReader.h"
 
 #include "gmp/RunSpec.h"
 
-#ifdef GMP_ENABLE_GMSH_GUI
-#include <gmsh.h>
-#endif
-
 namespace gmp {
 
 namespace {
@@ -55,6 +58,55 @@ RunnerKind RunnerKindFromIndex(int idx) {
   }
 }
 
+// Lines the panel's log view keeps; the job log file has everything.
+constexpr int kLogViewLines = 5000;
+
+// Threads per MPI rank from "--n-threads=N" or "--n-threads N".
+int ThreadsPerRank(const QStringList& args) {
+  for (int i = 0; i < args.size(); ++i) {
+    QString value;
+    if (args[i].startsWith("--n-threads=")) {
+      value = args[i].mid(12);
+    } else if (args[i] == "--n-threads" && i + 1 < args.size()) {
+      value = args[i + 1];
+    }
+    bool ok = false;
+    const int threads = value.toInt(&ok);
+    if (ok && threads > 0) {
+      return threads;
+    }
+  }
+  return 1;
+}
+
+// Exodus file names as MOOSE prints them, optionally quoted. Compiled once
+// and handed to every runner's output framer.
+const QRegularExpression& ExodusTokenPattern() {
+  static const QRegularExpression pattern = []() {
+    QRegularExpression re(R"m((['"]?)([A-Za-z0-9_./\\-]+\.e)\1)m");
+    re.optimize();
+    return re;
+  }();
+  return pattern;
+}
+
+// Exodus output of `input` relative to its working directory: the first
+// file_base in the input, else MOOSE's default "<input name>_out".
+QString ExodusFileBase(const QString& input) {
+  static const QRegularExpression file_base(
+      R"re(^\s*file_base\s*=\s*['"]?([^'"\s#]+))re",
+      QRegularExpression::MultilineOption);
+  QFile file(input);
+  if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    const QRegularExpressionMatch match =
+        file_base.match(QString::fromUtf8(file.readAll()));
+    if (match.hasMatch()) {
+      return match.captured(1);
+    }
+  }
+  return QFileInfo(input).completeBaseName() + "_out";
+}
+
 }  // namespace
 
 MoosePanel::MoosePanel(QWidget* parent) : QWidget(parent) {
@@ -156,6 +208,25 @@ MoosePanel::MoosePanel(QWidget* parent) : QWidget(parent) {
   runner_kind_->addItem("Remote", static_cast<int>(RunnerKind::kRemote));
   run_form->addRow("Runner", runner_kind_);
 
+  core_budget_ = new QSpinBox();
+  core_budget_->setRange(1, 4096);
+  core_budget_->setValue(std::max(1, QThread::idealThreadCount()));
+  core_budget_->setToolTip(
+      "Cores shared by concurrent jobs; each job needs MPI ranks x threads.");
+  run_form->addRow("Core Budget", core_budget_);
+
+  queue_order_ = new QComboBox();
+  install_combo_popup_fix(queue_order_);
+  queue_order_->addItem("FIFO", static_cast<int>(JobQueue::Order::Fifo));
+  queue_order_->addItem("Priority", static_cast<int>(JobQueue::Order::Priority));
+  run_form->addRow("Queue Order", queue_order_);
+
+  job_priority_ = new QSpinBox();
+  job_priority_->setRange(-100, 100);
+  job_priority_->setValue(0);
+  job_priority_->setToolTip("Higher runs first when the queue is in priority order.");
+  run_form->addRow("Priority", job_priority_);
+
   extra_args_ = new QLineEdit();
   extra_args_->setPlaceholderText("Extra args (e.g. --n-threads=4)");
   run_form->addRow("Extra Args", extra_args_);
@@ -199,21 +270,67 @@ MoosePanel::MoosePanel(QWidget* parent) : QWidget(parent) {
   check_btn_ = new QPushButton("Check Input");
   stop_btn_ = new QPushButton("Stop");
   stop_btn_->setEnabled(false);
+  stop_all_btn_ = new QPushButton("Stop All");
+  stop_all_btn_->setEnabled(false);
   connect(run_btn_, &QPushButton::clicked, this, &MoosePanel::on_run);
   connect(check_btn_, &QPushButton::clicked, this, &MoosePanel::on_check_input);
   connect(stop_btn_, &QPushButton::clicked, this, &MoosePanel::on_stop);
+  connect(stop_all_btn_, &QPushButton::clicked, this,
+          &MoosePanel::stop_all_jobs);
   action_row->addWidget(run_btn_);
   action_row->addWidget(check_btn_);
   action_row->addWidget(stop_btn_);
+  action_row->addWidget(stop_all_btn_);
+  queue_status_ = new QLabel();
+  action_row->addWidget(queue_status_);
+  output_rate_ = new QLabel("Output: idle");
+  action_row->addWidget(output_rate_);
   action_row->addStretch(1);
   layout->addLayout(action_row);
 
   log_ = new QPlainTextEdit();
   log_->setReadOnly(true);
+  log_->setMaximumBlockCount(kLogViewLines);
   layout->addWidget(log_, 1);
 
+  queue_ = new JobQueue(this);
+  queue_->set_output_watch(ExodusTokenPattern(), 2);
+  connect(queue_, &JobQueue::job_started, this, &MoosePanel::on_job_started);
+  connect(queue_, &JobQueue::job_output, this, &MoosePanel::handle_output);
+  connect(queue_, &JobQueue::job_progress, this, [this](int id) {
+    QVariantMap summary = queue_->progress(id)->summary();
+    summary.insert("job_id", id);
+    emit job_progress(summary);
+  });
+  connect(queue_, &JobQueue::job_finished, this, &MoosePanel::on_job_finished);
+  connect(queue_, &JobQueue::job_dropped, this, [this](int id) {
+    jobs_.remove(id);
+    append_log(QString("Job %1 removed from the queue.").arg(id));
+    QVariantMap info;
+    info.insert("job_id", id);
+    info.insert("status", "Cancelled");
+    emit job_finished(info);
+  });
+  connect(queue_, &JobQueue::load_changed, this,
+          &MoosePanel::update_queue_status);
+
   append_log("MOOSE panel ready.");
   load_settings();
+  queue_->set_core_budget(core_budget_->value());
+  queue_->set_order(
+      static_cast<JobQueue::Order>(queue_order_->currentData().toInt()));
+  // Connected after load_settings() so loading does not save half a state.
+  connect(core_budget_, &QSpinBox::valueChanged, this, [this](int cores) {
+    queue_->set_core_budget(cores);
+    update_queue_status();
+    save_settings();
+  });
+  connect(queue_order_, &QComboBox::currentIndexChanged, this, [this]() {
+    queue_->set_order(
+        static_cast<JobQueue::Order>(queue_order_->currentData().toInt()));
+    save_settings();
+  });
+  update_queue_status();
 }
 
 void MoosePanel::on_pick_exec() {
@@ -273,27 +390,38 @@ void MoosePanel::run_job() {
 }
 
 void MoosePanel::on_stop() {
-  if (!runner_) {
-    return;
-  }
-  runner_->stop();
+  cancel_job(followed_job_);
 }
 
 void MoosePanel::stop_job() {
   on_stop();
 }
 
+void MoosePanel::cancel_job(int id) {
+  queue_->cancel(id);
+}
+
+void MoosePanel::stop_all_jobs() {
+  queue_->cancel_all();
+}
+
 QString MoosePanel::log_text() const {
   return log_ ? log_->toPlainText() : QString();
 }
 
 QString MoosePanel::log_tail(int max_lines) const {
+  JobLog* followed = queue_->log(followed_job_);
+  if (followed && followed->line_count() > 0) {
+    return followed->tail(max_lines).join("\n");
+  }
   if (!log_) {
     return QString();
   }
-  QStringList lines = log_->toPlainText().split('\n');
-  if (max_lines > 0 && lines.size() > max_lines) {
-    lines = lines.mid(lines.size() - max_lines);
+  QStringList lines;
+  for (QTextBlock block = log_->document()->lastBlock();
+       block.isValid() && (max_lines <= 0 || lines.size() < max_lines);
+       block = block.previous()) {
+    lines.prepend(block.text());
   }
   return lines.join("\n");
 }
@@ -312,44 +440,156 @@ void MoosePanel::append_log(const QString& text) {
   }
 }
 
-void MoosePanel::handle_output(const QString& text) {
-  output_buffer_ += text;
-  int idx = -1;
-  while ((idx = output_buffer_.indexOf('\n')) != -1) {
-    const QString line = output_buffer_.left(idx).trimmed();
-    output_buffer_.remove(0, idx + 1);
-    if (!line.isEmpty()) {
-      append_log(line);
-      const QRegularExpression re(R"m((['"]?)([A-Za-z0-9_./\\-]+\.e)\1)m");
-      auto it = re.globalMatch(line);
-      while (it.hasNext()) {
-        const auto m = it.next();
-        const QString token = m.captured(2);
-        const QString resolved = resolve_exodus_path(token);
-        if (!resolved.isEmpty()) {
-          maybe_emit_exodus(resolved);
-        }
-      }
+void MoosePanel::handle_output(int id, const OutputBatch& batch) {
+  // Every job's output already went to its own JobLog; the view follows
+  // one job so concurrent runs do not interleave in it.
+  if (id != followed_job_) {
+    return;
+  }
+  // One append per batch; the framer already split, trimmed and matched.
+  if (!batch.lines.isEmpty()) {
+    append_log(batch.lines.join('\n'));
+  }
+  const QString workdir = jobs_.value(id).value("workdir").toString();
+  // Batch jobs leave the viewer alone; see on_job_finished().
+  const bool quiet = jobs_.value(id).value("batch").toBool();
+  QSet<QString> seen;
+  for (const QString& token : batch.matches) {
+    if (quiet || seen.contains(token)) {
+      continue;
+    }
+    seen.insert(token);
+    const QString resolved = resolve_exodus_path(token, workdir);
+    if (!resolved.isEmpty()) {
+      maybe_emit_exodus(resolved);
     }
   }
+  if (output_rate_) {
+    output_rate_->setText(QString("Output: %1 lines/s, %2 lines")
+                              .arg(batch.lines_per_second, 0, 'f', 0)
+                              .arg(batch.total_lines));
+  }
 }
 
-void MoosePanel::flush_output() {
-  if (output_buffer_.isEmpty()) {
-    return;
-  }
-  handle_output("\n");
+void MoosePanel::on_job_started(int id) {
+  const QVariantMap info = jobs_.value(id);
+  followed_job_ = id;
+  append_log(QString("Job %1 started (%2 cores): %3 %4")
+                 .arg(id)
+                 .arg(info.value("cores").toInt())
+                 .arg(info.value("launcher").toString(),
+                      info.value("args").toString()));
+  QVariantMap start_info;
+  start_info.insert("job_id", id);
+  start_info.insert("start_time",
+                    QDateTime::currentDateTime().toString(Qt::ISODate));
+  emit job_started(start_info);
 }
 
-void MoosePanel::set_running(bool running) {
-  if (run_btn_) {
-    run_btn_->setEnabled(!running);
+void MoosePanel::on_job_finished(int id, int code,
+                                 QProcess::ExitStatus status) {
+  const QVariantMap info = jobs_.take(id);
+  // A stopped job usually ends in a crash exit; report why it ended.
+  const QString outcome = queue_->cancel_requested(id) ? "Cancelled"
+                          : status == QProcess::NormalExit ? "Normal"
+                                                           : "Crash";
+  append_log(QString("Job %1 finished. exit=%2 status=%3")
+                 .arg(id)
+                 .arg(code)
+                 .arg(outcome));
+
+  const QString workdir = info.value("workdir").toString().isEmpty()
+                              ? QDir::currentPath()
+                              : info.value("workdir").toString();
+  const QString input_dir =
+      QFileInfo(info.value("input").toString()).absolutePath();
+  QStringList dirs;
+  if (!workdir.isEmpty()) {
+    dirs << workdir;
+  }
+  if (!input_dir.isEmpty() && input_dir != workdir) {
+    dirs << input_dir;
+  }
+  // Jobs can share a working directory, so only this job's own output
+  // counts: <file_base>.e and its adaptivity steps <file_base>.e-sNNN.
+  const QString file_base = ExodusFileBase(info.value("input").toString());
+  const QString own_dir =
+      QFileInfo(QDir(workdir).filePath(file_base)).absolutePath();
+  if (!dirs.contains(own_dir)) {
+    dirs << own_dir;
+  }
+  const QString own_name = QFileInfo(file_base).fileName() + ".e";
+  QStringList history;
+  for (const QString& path : collect_exodus_files(dirs)) {
+    const QString name = QFileInfo(path).fileName();
+    if (name == own_name || name.startsWith(own_name + "-s")) {
+      history << path;
+    }
+  }
+  const QString exodus = pick_latest_exodus(history);
+  // Batch jobs report their results through job_finished() only, so a
+  // sweep does not reload the viewer for every case.
+  const bool batch = info.value("batch").toBool();
+  if (!history.isEmpty() && !batch) {
+    emit exodus_history(history);
+  }
+  if (!exodus.isEmpty() && !batch) {
+    maybe_emit_exodus(exodus);
+  }
+
+  QVariantMap finish_info;
+  finish_info.insert("job_id", id);
+  finish_info.insert("exit_code", code);
+  finish_info.insert("status", outcome);
+  finish_info.insert("exodus", exodus);
+  finish_info.insert("history", history);
+  const MooseProgress* progress = queue_->progress(id);
+  JobLog* log = queue_->log(id);
+  if (progress) {
+    const QVariantMap summary = progress->summary();
+    for (auto it = summary.begin(); it != summary.end(); ++it) {
+      finish_info.insert(it.key(), it.value());
+    }
+  }
+  if (progress && log && !progress->steps().empty()) {
+    // Next to the job log, so finished jobs can still be plotted.
+    const QFileInfo log_info(log->path());
+    const QString csv = log_info.dir().filePath(log_info.completeBaseName() +
+                                                ".progress.csv");
+    QString error;
+    if (MooseProgress::WriteCsv(progress->steps(), csv, &error)) {
+      finish_info.insert("progress", csv);
+    } else {
+      append_log("Progress not written: " + error);
+    }
   }
-  if (check_btn_) {
-    check_btn_->setEnabled(!running);
+  if (id == followed_job_) {
+    // Follow the newest job still running, if any.
+    const std::vector<int> running = queue_->running_ids();
+    if (!running.empty()) {
+      followed_job_ = running.back();
+      append_log(QString("Following job %1.").arg(followed_job_));
+    }
   }
+  emit job_finished(finish_info);
+}
+
+void MoosePanel::update_queue_status() {
+  const int running = queue_->running_count();
+  const int waiting = queue_->waiting_count();
   if (stop_btn_) {
-    stop_btn_->setEnabled(running);
+    stop_btn_->setEnabled(queue_->is_running(followed_job_) ||
+                          queue_->is_waiting(followed_job_));
+  }
+  if (stop_all_btn_) {
+    stop_all_btn_->setEnabled(running + waiting > 0);
+  }
+  if (queue_status_) {
+    queue_status_->setText(QString("Jobs: %1 running, %2 waiting | cores %3/%4")
+                               .arg(running)
+                               .arg(waiting)
+                               .arg(queue_->cores_in_use())
+                               .arg(queue_->core_budget()));
   }
 }
 
@@ -393,6 +633,8 @@ QVariantMap MoosePanel::moose_settings() const {
   map.insert("template_key",
              template_kind_ ? template_kind_->currentData().toString() : "");
   map.insert("extra_args", extra_args_ ? extra_args_->text() : "");
+  map.insert("core_budget", core_budget_ ? core_budget_->value() : 1);
+  map.insert("queue_order", queue_order_ ? queue_order_->currentIndex() : 0);
   map.insert("input_text", input_editor_ ? input_editor_->toPlainText() : "");
   return map;
 }
@@ -440,6 +682,14 @@ void MoosePanel::apply_moose_settings(const QVariantMap& settings) {
     extra_args_->setText(
         settings.value("extra_args", extra_args_->text()).toString());
   }
+  if (core_budget_) {
+    core_budget_->setValue(
+        settings.value("core_budget", core_budget_->value()).toInt());
+  }
+  if (queue_order_) {
+    queue_order_->setCurrentIndex(
+        settings.value("queue_order", queue_order_->currentIndex()).toInt());
+  }
   if (input_editor_ && !input_text.isEmpty()) {
     input_editor_->setPlainText(input_text);
   }
@@ -545,11 +795,6 @@ void MoosePanel::on_insert_bcs_block() {
 }
 
 void MoosePanel::run_task(bool check_only) {
-  if (runner_) {
-    append_log("A run is already active.");
-    return;
-  }
-
   if (exec_path_->currentText().isEmpty()) {
     append_log("Executable is empty.");
     return;
@@ -564,13 +809,32 @@ void MoosePanel::run_task(bool check_only) {
   if (!QFileInfo::exists(input_path)) {
     on_write_input();
   }
+  submit(input_path, workdir_path_->text(), check_only, {});
+}
 
-  RunSpec spec;
+int MoosePanel::submit_input(const QString& input_path, const QString& workdir,
+                             const QVariantMap& extra_info) {
+  if (exec_path_->currentText().isEmpty()) {
+    append_log("Executable is empty.");
+    return 0;
+  }
+  if (!QFileInfo::exists(input_path)) {
+    append_log("Input file not found: " + input_path);
+    return 0;
+  }
+  return submit(input_path, workdir, false, extra_info);
+}
+
+int MoosePanel::submit(const QString& input_path, const QString& workdir,
+                       bool check_only, const QVariantMap& extra_info) {
+  QueuedJob job;
+  RunSpec& spec = job.spec;
   const QString exec_path = exec_path_->currentText();
   const QStringList extra = QProcess::splitCommand(extra_args_->text());
+  const int ranks = use_mpi_->isChecked() ? mpi_ranks_->value() : 1;
   if (use_mpi_->isChecked()) {
     spec.program = "mpiexec";
-    spec.args << "-n" << QString::number(mpi_ranks_->value())
+    spec.args << "-n" << QString::number(ranks)
               << exec_path << "-i" << input_path;
   } else {
     spec.program = exec_path;
@@ -580,76 +844,51 @@ void MoosePanel::run_task(bool check_only) {
   if (check_only) {
     spec.args << "--check-input";
   }
-  spec.working_dir = workdir_path_->text();
-
-  const RunnerKind kind = RunnerKindFromIndex(runner_kind_->currentIndex());
-  runner_ = CreateRunner(kind);
-  if (!runner_) {
-    append_log("Failed to create runner.");
-    return;
-  }
-
-  QVariantMap start_info;
-  start_info.insert("exec", exec_path);
-  start_info.insert("input", input_path);
-  start_info.insert("workdir", spec.working_dir);
-  start_info.insert("mesh", mesh_path_ ? mesh_path_->text() : QString());
-  start_info.insert("use_mpi", use_mpi_->isChecked());
-  start_info.insert("mpi_ranks", mpi_ranks_->value());
-  start_info.insert("check_only", check_only);
-  start_info.insert("launcher", spec.program);
-  start_info.insert("args", spec.args.join(" "));
-  emit job_started(start_info);
-
-  connect(runner_.get(), &Runner::std_out, this, &MoosePanel::handle_output);
-  connect(runner_.get(), &Runner::std_err, this, &MoosePanel::handle_output);
-  connect(runner_.get(), &Runner::started, this, [this, check_only]() {
-    append_log(check_only ? "Input check started." : "Run started.");
-    set_running(true);
-  });
-  connect(runner_.get(), &Runner::finished, this,
-          [this](int code, QProcess::ExitStatus status) {
-            flush_output();
-            append_log(QString("Run finished. exit=%1 status=%2")
-                           .arg(code)
-                           .arg(status == QProcess::NormalExit ? "Normal" : "Crash"));
-            runner_.reset();
-            set_running(false);
-
-            const QString workdir = workdir_path_->text().isEmpty()
-                                        ? QDir::currentPath()
-                                        : workdir_path_->text();
-            const QString input_dir = QFileInfo(input_path_->text()).absolutePath();
-            QStringList dirs;
-            if (!workdir.isEmpty()) {
-              dirs << workdir;
-            }
-            if (!input_dir.isEmpty() && input_dir != workdir) {
-              dirs << input_dir;
-            }
-            const QStringList history = collect_exodus_files(dirs);
-            const QString exodus = pick_latest_exodus(history);
-            if (!history.isEmpty()) {
-              emit exodus_history(history);
-            }
-            if (!exodus.isEmpty()) {
-              maybe_emit_exodus(exodus);
-            }
-
-            QVariantMap finish_info;
-            finish_info.insert("exit_code", code);
-            finish_info.insert("status",
-                               status == QProcess::NormalExit ? "Normal"
-                                                              : "Crash");
-            finish_info.insert("exodus", exodus);
-            finish_info.insert("history", history);
-            emit job_finished(finish_info);
-          });
-
-  append_log("Launching: " + spec.program + " " + spec.args.join(" "));
-  runner_->start(spec);
+  spec.working_dir = workdir;
+  job.kind = RunnerKindFromIndex(runner_kind_->currentIndex());
+  job.cores = ranks * ThreadsPerRank(extra);
+  job.priority = job_priority_->value();
+
+  // The full output goes to a file per job; the view keeps the last lines.
+  const QDir log_dir(QDir(spec.working_dir.isEmpty() ? QDir::currentPath()
+                                                     : spec.working_dir)
+                         .filePath("gmp_logs"));
+  const QString base = QFileInfo(input_path).completeBaseName();
+  // The sequence number keeps jobs submitted within one second apart.
+  static int log_serial = 0;
+  job.log_path = log_dir.filePath(
+      QString("%1_%2_%3.log")
+          .arg(base.isEmpty() ? QString("job") : base)
+          .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"))
+          .arg(++log_serial));
+
+  const int id = queue_->submit(job);
+  QVariantMap info;
+  info.insert("job_id", id);
+  info.insert("exec", exec_path);
+  info.insert("input", input_path);
+  info.insert("workdir", spec.working_dir);
+  info.insert("mesh", mesh_path_ ? mesh_path_->text() : QString());
+  info.insert("use_mpi", use_mpi_->isChecked());
+  info.insert("mpi_ranks", mpi_ranks_->value());
+  info.insert("cores", job.cores);
+  info.insert("priority", job.priority);
+  info.insert("check_only", check_only);
+  info.insert("launcher", spec.program);
+  info.insert("args", spec.args.join(" "));
+  info.insert("log", job.log_path);
+  for (auto it = extra_info.begin(); it != extra_info.end(); ++it) {
+    info.insert(it.key(), it.value());
+  }
+  jobs_.insert(id, info);
+  append_log(QString("Job %1 queued (%2 cores%3).")
+                 .arg(id)
+                 .arg(job.cores)
+                 .arg(check_only ? QString(", input check") : QString()));
+  emit job_queued(info);
   update_exec_history(exec_path);
   save_settings();
+  return id;
 }
 
 QString MoosePanel::upsert_block(const QString& input,
@@ -677,15 +916,14 @@ QString MoosePanel::upsert_block(const QString& input,
   return out;
 }
 
-QString MoosePanel::resolve_exodus_path(const QString& token) const {
+QString MoosePanel::resolve_exodus_path(const QString& token,
+                                        const QString& workdir) const {
   QFileInfo fi(token);
   if (fi.isAbsolute() && fi.exists()) {
     return fi.absoluteFilePath();
   }
-  const QString workdir = workdir_path_->text().isEmpty()
-                              ? QDir::currentPath()
-                              : workdir_path_->text();
-  QFileInfo rel(QDir(workdir), token);
+  QFileInfo rel(QDir(workdir.isEmpty() ? QDir::currentPath() : workdir),
+                token);
   if (rel.exists()) {
     return rel.absoluteFilePath();
   }
@@ -1509,6 +1747,10 @@ void MoosePanel::load_settings() {
           .toInt());
   extra_args_->setText(
       settings.value("moose/extra_args", extra_args_->text()).toString());
+  core_budget_->setValue(
+      settings.value("moose/core_budget", core_budget_->value()).toInt());
+  queue_order_->setCurrentIndex(
+      settings.value("moose/queue_order", queue_order_->currentIndex()).toInt());
 
   if (exec_path_->currentText().trimmed().isEmpty()) {
     const QString detected = auto_detect_exec();
@@ -1529,6 +1771,8 @@ void MoosePanel::save_settings() const {
   settings.setValue("moose/runner_kind", runner_kind_->currentIndex());
   settings.setValue("moose/template_kind", template_kind_->currentIndex());
   settings.setValue("moose/extra_args", extra_args_->text());
+  settings.setValue("moose/core_budget", core_budget_->value());
+  settings.setValue("moose/queue_order", queue_order_->currentIndex());
   QStringList history;
   for (int i = 0; i < exec_path_->count(); ++i) {
     history << exec_path_->itemText(i);
@@ -1595,90 +1839,30 @@ QString MoosePanel::find_exec_in_parents(const QString& relative,
 }
 
 QStringList MoosePanel::read_boundary_groups_from_mesh(const QString& mesh_path) const {
-  QStringList names;
-#ifndef GMP_ENABLE_GMSH_GUI
   return parse_msh_physical_groups(mesh_path);
-#else
-  try {
-    if (!gmsh::isInitialized()) {
-      gmsh::initialize();
-    }
-    gmsh::clear();
-    gmsh::open(mesh_path.toStdString());
-    std::vector<std::pair<int, int>> phys_groups;
-    gmsh::model::getPhysicalGroups(phys_groups);
-    int max_dim = 0;
-    {
-      std::vector<std::pair<int, int>> ents;
-      gmsh::model::getEntities(ents);
-      for (const auto& e : ents) {
-        if (e.first > max_dim) {
-          max_dim = e.first;
-        }
-      }
-    }
-    const int boundary_dim = std::max(0, max_dim - 1);
-    for (const auto& p : phys_groups) {
-      if (p.first != boundary_dim) {
-        continue;
-      }
-      std::string name;
-      gmsh::model::getPhysicalName(p.first, p.second, name);
-      if (name.empty()) {
-        name = "boundary_" + std::to_string(p.second);
-      }
-      names << QString::fromStdString(name);
-    }
-  } catch (const std::exception& ex) {
-    Q_UNUSED(ex);
-    return parse_msh_physical_groups(mesh_path);
-  }
-  return names;
-#endif
 }
 
 QStringList MoosePanel::parse_msh_physical_groups(const QString& mesh_path) const {
   QStringList names;
-  QFile file(mesh_path);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  MshHeaderInfo header;
+  if (!ScanMshHeader(mesh_path, &header)) {
     return names;
   }
 
-  QMap<int, QStringList> names_by_dim;
-  int max_dim = 0;
-  bool in_section = false;
-  while (!file.atEnd()) {
-    const QByteArray raw = file.readLine();
-    const QString line = QString::fromUtf8(raw).trimmed();
-    if (line == "$PhysicalNames") {
-      in_section = true;
-      // Next line is count; ignore.
-      file.readLine();
-      continue;
-    }
-    if (in_section) {
-      if (line == "$EndPhysicalNames") {
-        break;
-      }
-      // Format: <dim> <tag> "<name>"
-      const QRegularExpression re(
-          R"m(^\s*(\d+)\s+(\d+)\s+"(.*)"\s*$)m");
-      const QRegularExpressionMatch m = re.match(line);
-      if (m.hasMatch()) {
-        const int dim = m.captured(1).toInt();
-        const QString name = m.captured(3);
-        if (dim > max_dim) {
-          max_dim = dim;
-        }
-        if (!name.isEmpty()) {
-          names_by_dim[dim] << name;
-        }
-      }
+  // MSH 2 has no $Entities; fall back to the highest named group dimension.
+  int max_dim = header.max_entity_dim;
+  if (max_dim < 0) {
+    for (const auto& g : header.physical_groups) {
+      max_dim = std::max(max_dim, g.dim);
     }
   }
-
   const int boundary_dim = std::max(0, max_dim - 1);
-  names = names_by_dim.value(boundary_dim);
+  for (const auto& g : header.physical_groups) {
+    if (g.dim != boundary_dim) {
+      continue;
+    }
+    names << (g.name.isEmpty() ? QString("boundary_%1").arg(g.tag) : g.name);
+  }
   return names;
 }
 
@@ -0,0 +1,262 @@
+#include "gmp/MooseProgress.h"
+
+#include <QFile>
+#include <QRegularExpression>
+#include <QStringView>
+#include <QTextStream>
+#include <cmath>
+
+namespace gmp {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+const char* const kCsvHeader =
+    "step,time,dt,nonlinear_its,linear_its,initial_residual,final_residual,"
+    "wall_s,converged";
+
+// MOOSE colours residuals when it thinks it writes to a terminal.
+QString StripAnsi(const QString& line) {
+  static const QRegularExpression ansi("\\x1b\\[[0-9;]*[A-Za-z]");
+  QString out = line;
+  out.remove(ansi);
+  return out;
+}
+
+// "<n> Nonlinear |R| = <v>" and "<n> Linear |R| = <v>".
+bool ParseResidual(QStringView line, int* index, bool* nonlinear,
+                   double* value) {
+  qsizetype i = 0;
+  int n = 0;
+  while (i < line.size() && line[i].isDigit()) {
+    n = n * 10 + line[i].digitValue();
+    ++i;
+  }
+  if (i == 0 || i >= line.size() || line[i] != u' ') {
+    return false;
+  }
+  QStringView rest = line.mid(i).trimmed();
+  if (rest.startsWith(u"Nonlinear |R|")) {
+    *nonlinear = true;
+  } else if (rest.startsWith(u"Linear |R|")) {
+    *nonlinear = false;
+  } else {
+    return false;
+  }
+  const qsizetype eq = rest.indexOf(u'=');
+  if (eq < 0) {
+    return false;
+  }
+  rest = rest.mid(eq + 1).trimmed();
+  const qsizetype space = rest.indexOf(u' ');
+  if (space >= 0) {
+    rest = rest.left(space);
+  }
+  bool ok = false;
+  *value = rest.toDouble(&ok);
+  *index = n;
+  return ok;
+}
+
+double ToDouble(const QString& text) {
+  bool ok = false;
+  const double value = text.toDouble(&ok);
+  return ok ? value : kNaN;
+}
+
+QString CsvNumber(double value) {
+  return std::isfinite(value) ? QString::number(value, 'g', 10) : QString();
+}
+
+}  // namespace
+
+void MooseProgress::clear() {
+  *this = MooseProgress();
+}
+
+bool MooseProgress::feed(const QStringList& lines) {
+  finished_ = false;
+  for (const QString& line : lines) {
+    feed_line(line);
+  }
+  return finished_;
+}
+
+void MooseProgress::feed_line(const QString& raw) {
+  const QString line = raw.contains(QChar(0x1b)) ? StripAnsi(raw) : raw;
+  const QStringView view = QStringView(line).trimmed();
+  if (view.isEmpty()) {
+    return;
+  }
+  const QChar first = view.front();
+  if (first.isDigit()) {
+    int index = 0;
+    bool nonlinear = false;
+    double value = 0.0;
+    if (!ParseResidual(view, &index, &nonlinear, &value)) {
+      return;
+    }
+    if (!open_) {
+      // Steady solves print residuals without a step header.
+      open_step(steps_.empty() ? 0 : steps_.back().step + 1);
+    }
+    if (nonlinear) {
+      current_.nonlinear_its = index;
+      if (index == 0 || std::isnan(current_.initial_residual)) {
+        current_.initial_residual = value;
+      }
+      current_.final_residual = value;
+    } else if (index > 0) {
+      ++current_.linear_its;
+    }
+    return;
+  }
+  if (first == u'T' && view.startsWith(u"Time Step")) {
+    static const QRegularExpression header(
+        "^Time Step\\s+(\\d+)(?:,\\s*time\\s*=\\s*([^,\\s]+))?"
+        "(?:,\\s*dt\\s*=\\s*([^,\\s]+))?");
+    const QRegularExpressionMatch match = header.match(view.toString());
+    if (!match.hasMatch()) {
+      return;
+    }
+    if (open_ && std::isnan(current_.initial_residual)) {
+      // "Time Step 0" is the initial condition; no solve, so no step.
+      open_ = false;
+      if (steps_.empty()) {
+        first_step_ms_ = -1;
+      }
+    } else if (open_) {
+      // MOOSE only moves on without a failure message after converging.
+      close_step(true);
+    }
+    open_step(match.captured(1).toInt());
+    current_.time = ToDouble(match.captured(2));
+    current_.dt = ToDouble(match.captured(3));
+    return;
+  }
+  if (first == u'd' && open_ && view.startsWith(u"dt")) {
+    // Older MOOSE prints dt on its own line below the header.
+    static const QRegularExpression dt("^dt\\s*=\\s*([^,\\s]+)");
+    const QRegularExpressionMatch match = dt.match(view.toString());
+    if (match.hasMatch()) {
+      current_.dt = ToDouble(match.captured(1));
+    }
+    return;
+  }
+  if (first == u'S' && open_) {
+    if (view.startsWith(u"Solve Converged")) {
+      close_step(true);
+    } else if (view.startsWith(u"Solve Did NOT Converge")) {
+      close_step(false);
+    }
+  }
+}
+
+void MooseProgress::open_step(int step) {
+  if (!clock_.isValid()) {
+    clock_.start();
+  }
+  current_ = MooseStep();
+  current_.step = step;
+  step_start_ms_ = clock_.elapsed();
+  if (first_step_ms_ < 0) {
+    first_step_ms_ = step_start_ms_;
+  }
+  open_ = true;
+}
+
+void MooseProgress::close_step(bool converged) {
+  last_close_ms_ = clock_.elapsed();
+  current_.converged = converged;
+  current_.wall_s = static_cast<double>(last_close_ms_ - step_start_ms_) / 1000.0;
+  steps_.push_back(current_);
+  open_ = false;
+  finished_ = true;
+}
+
+QVariantMap MooseProgress::summary() const {
+  QVariantMap out;
+  out.insert("steps", static_cast<int>(steps_.size()));
+  if (steps_.empty()) {
+    return out;
+  }
+  int failed = 0;
+  double nonlinear = 0.0;
+  double linear = 0.0;
+  for (const MooseStep& s : steps_) {
+    failed += s.converged ? 0 : 1;
+    nonlinear += s.nonlinear_its;
+    linear += s.linear_its;
+  }
+  const double count = static_cast<double>(steps_.size());
+  out.insert("failed_steps", failed);
+  out.insert("avg_nl_its", nonlinear / count);
+  out.insert("avg_linear_its", linear / count);
+  out.insert("last_residual", steps_.back().final_residual);
+  const double span_s =
+      static_cast<double>(last_close_ms_ - first_step_ms_) / 1000.0;
+  if (span_s > 0.0) {
+    out.insert("steps_per_s", count / span_s);
+  }
+  return out;
+}
+
+bool MooseProgress::WriteCsv(const std::vector<MooseStep>& steps,
+                             const QString& path, QString* error) {
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+    if (error) {
+      *error = file.errorString();
+    }
+    return false;
+  }
+  QTextStream out(&file);
+  out << kCsvHeader << '\n';
+  for (const MooseStep& s : steps) {
+    out << s.step << ',' << CsvNumber(s.time) << ',' << CsvNumber(s.dt) << ','
+        << s.nonlinear_its << ',' << s.linear_its << ','
+        << CsvNumber(s.initial_residual) << ',' << CsvNumber(s.final_residual)
+        << ',' << CsvNumber(s.wall_s) << ',' << (s.converged ? 1 : 0) << '\n';
+  }
+  out.flush();
+  if (out.status() != QTextStream::Ok) {
+    if (error) {
+      *error = file.errorString();
+    }
+    return false;
+  }
+  return true;
+}
+
+std::vector<MooseStep> MooseProgress::ReadCsv(const QString& path) {
+  std::vector<MooseStep> steps;
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    return steps;
+  }
+  QTextStream in(&file);
+  if (in.readLine() != QLatin1String(kCsvHeader)) {
+    return steps;
+  }
+  while (!in.atEnd()) {
+    const QStringList cols = in.readLine().split(',');
+    if (cols.size() < 9) {
+      continue;
+    }
+    MooseStep s;
+    s.step = cols[0].toInt();
+    s.time = ToDouble(cols[1]);
+    s.dt = ToDouble(cols[2]);
+    s.nonlinear_its = cols[3].toInt();
+    s.linear_its = cols[4].toInt();
+    s.initial_residual = ToDouble(cols[5]);
+    s.final_residual = ToDouble(cols[6]);
+    s.wall_s = ToDouble(cols[7]);
+    s.converged = cols[8].toInt() != 0;
+    steps.push_back(s);
+  }
+  return steps;
+}
+
+}  // namespace gmp
@@ -0,0 +1,744 @@
+#include "gmp/MshReader.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace gmp {
+
+namespace {
+
+constexpr MshElementType kElementTypes[] = {
+    {1, 1, 2, 2, "Line 2"},          {2, 2, 3, 3, "Triangle 3"},
+    {3, 2, 4, 4, "Quadrilateral 4"}, {4, 3, 4, 4, "Tetrahedron 4"},
+    {5, 3, 8, 8, "Hexahedron 8"},    {6, 3, 6, 6, "Prism 6"},
+    {7, 3, 5, 5, "Pyramid 5"},       {8, 1, 3, 2, "Line 3"},
+    {9, 2, 6, 3, "Triangle 6"},      {10, 2, 9, 4, "Quadrilateral 9"},
+    {11, 3, 10, 4, "Tetrahedron 10"}, {12, 3, 27, 8, "Hexahedron 27"},
+    {13, 3, 18, 6, "Prism 18"},      {14, 3, 14, 5, "Pyramid 14"},
+    {15, 0, 1, 1, "Point"},          {16, 2, 8, 4, "Quadrilateral 8"},
+    {17, 3, 20, 8, "Hexahedron 20"}, {18, 3, 15, 6, "Prism 15"},
+    {19, 3, 13, 5, "Pyramid 13"},    {20, 2, 9, 3, "Triangle 9"},
+    {21, 2, 10, 3, "Triangle 10"},   {22, 2, 12, 3, "Triangle 12"},
+    {23, 2, 15, 3, "Triangle 15"},   {24, 2, 15, 3, "Triangle 15I"},
+    {25, 2, 21, 3, "Triangle 21"},   {26, 1, 4, 2, "Line 4"},
+    {27, 1, 5, 2, "Line 5"},         {28, 1, 6, 2, "Line 6"},
+    {29, 3, 20, 4, "Tetrahedron 20"}, {30, 3, 35, 4, "Tetrahedron 35"},
+    {31, 3, 56, 4, "Tetrahedron 56"}, {36, 2, 16, 4, "Quadrilateral 16"},
+    {37, 2, 25, 4, "Quadrilateral 25"}, {92, 3, 64, 8, "Hexahedron 64"},
+    {93, 3, 125, 8, "Hexahedron 125"},
+};
+
+struct ParseError {
+  QString what;
+};
+
+[[noreturn]] void Fail(const QString& what) {
+  throw ParseError{what};
+}
+
+// Read cursor over the mapped file. ASCII and binary accessors share the
+// position so sections can mix header lines with binary payloads.
+class Cursor {
+ public:
+  Cursor(const char* begin, const char* end) : pos_(begin), end_(end) {}
+
+  bool at_end() const { return pos_ >= end_; }
+
+  void skip_ws() {
+    while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' ||
+                           *pos_ == '\t')) {
+      ++pos_;
+    }
+  }
+
+  void skip_line() {
+    while (pos_ < end_ && *pos_ != '\n') {
+      ++pos_;
+    }
+    if (pos_ < end_) {
+      ++pos_;
+    }
+  }
+
+  std::string line() {
+    const char* start = pos_;
+    while (pos_ < end_ && *pos_ != '\n') {
+      ++pos_;
+    }
+    const char* stop = pos_;
+    if (pos_ < end_) {
+      ++pos_;
+    }
+    while (stop > start && (stop[-1] == '\r' || stop[-1] == ' ')) {
+      --stop;
+    }
+    return std::string(start, stop);
+  }
+
+  long long ascii_int() {
+    skip_ws();
+    bool neg = false;
+    if (pos_ < end_ && (*pos_ == '-' || *pos_ == '+')) {
+      neg = *pos_ == '-';
+      ++pos_;
+    }
+    if (pos_ >= end_ || *pos_ < '0' || *pos_ > '9') {
+      Fail("expected integer");
+    }
+    long long v = 0;
+    while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9') {
+      v = v * 10 + (*pos_ - '0');
+      ++pos_;
+    }
+    return neg ? -v : v;
+  }
+
+  double ascii_double() {
+    skip_ws();
+    // The mapping is not NUL-terminated, so strtod gets a bounded copy of
+    // the token rather than the buffer itself.
+    char token[64];
+    std::size_t n = 0;
+    while (pos_ + n < end_ && n + 1 < sizeof(token) &&
+           !std::isspace(static_cast<unsigned char>(pos_[n]))) {
+      token[n] = pos_[n];
+      ++n;
+    }
+    token[n] = '\0';
+    char* next = nullptr;
+    const double v = std::strtod(token, &next);
+    if (next == token) {
+      Fail("expected number");
+    }
+    pos_ += next - token;
+    return v;
+  }
+
+  template <typename T>
+  T binary() {
+    T v;
+    bytes(&v, sizeof(T));
+    return v;
+  }
+
+  void skip(std::size_t n) {
+    if (static_cast<std::size_t>(end_ - pos_) < n) {
+      Fail("unexpected end of file");
+    }
+    pos_ += n;
+  }
+
+  void bytes(void* dst, std::size_t n) {
+    if (static_cast<std::size_t>(end_ - pos_) < n) {
+      Fail("unexpected end of file");
+    }
+    std::memcpy(dst, pos_, n);
+    pos_ += n;
+  }
+
+  // Positions the cursor on the line after `marker`.
+  bool seek_past(const char* marker) {
+    const std::size_t len = std::strlen(marker);
+    const char* hit = std::search(pos_, end_, marker, marker + len);
+    if (hit == end_) {
+      pos_ = end_;
+      return false;
+    }
+    pos_ = hit + len;
+    skip_line();
+    return true;
+  }
+
+ private:
+  const char* pos_;
+  const char* end_;
+};
+
+class Parser {
+ public:
+  Parser(Cursor cursor, MshVisitor& visitor, const MshReadOptions& options)
+      : in_(cursor), visitor_(visitor), options_(options) {}
+
+  void run() {
+    while (true) {
+      in_.skip_ws();
+      if (in_.at_end()) {
+        break;
+      }
+      const std::string header = in_.line();
+      if (header.empty() || header[0] != '$') {
+        continue;
+      }
+      const std::string name = header.substr(1);
+      if (name == "MeshFormat") {
+        read_format();
+      } else if (fmt_.version == 0.0) {
+        Fail("missing $MeshFormat");
+      } else if (name == "PhysicalNames") {
+        read_physical_names();
+      } else if (name == "Entities" && v4()) {
+        read_entities();
+      } else if (name == "Nodes" || name == "Elements") {
+        if (!options_.read_mesh) {
+          if (header_complete()) {
+            break;
+          }
+          skip_mesh_section(name);
+          continue;
+        }
+        if (name == "Nodes") {
+          v4() ? read_nodes_v4() : read_nodes_v2();
+        } else {
+          v4() ? read_elements_v4() : read_elements_v2();
+          break;
+        }
+      } else {
+        skip_section(name);
+        continue;
+      }
+      expect_end(name);
+    }
+  }
+
+ private:
+  bool v4() const { return fmt_.version >= 4.0; }
+
+  void expect_end(const std::string& name) {
+    in_.skip_ws();
+    const std::string end = in_.line();
+    if (end != "$End" + name) {
+      Fail(QString("expected $End%1").arg(QString::fromStdString(name)));
+    }
+  }
+
+  // gmsh writes $PhysicalNames (only when groups are named) and then
+  // $Entities ahead of the mesh, so in v4 $Entities ends the header. v2
+  // has no $Entities; other writers may not follow the order, in which
+  // case the scan continues past the mesh.
+  bool header_complete() const {
+    return v4() ? seen_entities_ : seen_names_;
+  }
+
+  // Skips $Nodes/$Elements. Binary payloads are jumped over using the
+  // declared block sizes; ASCII falls back to searching for the end marker.
+  void skip_mesh_section(const std::string& name) {
+    if (!fmt_.binary) {
+      skip_section(name);
+      return;
+    }
+    const std::size_t ds = static_cast<std::size_t>(fmt_.data_size);
+    if (name == "Nodes") {
+      if (v4()) {
+        const std::size_t n_blocks = size_field();
+        in_.skip(3 * ds);
+        for (std::size_t b = 0; b < n_blocks; ++b) {
+          const int dim = int_field();
+          int_field();
+          const bool parametric = int_field() != 0;
+          const std::size_t count = size_field();
+          const std::size_t n_coords = 3 + (parametric ? dim : 0);
+          in_.skip(count * (ds + n_coords * sizeof(double)));
+        }
+      } else {
+        const std::size_t total = static_cast<std::size_t>(in_.ascii_int());
+        in_.skip_line();
+        in_.skip(total * (sizeof(int32_t) + 3 * sizeof(double)));
+      }
+    } else {
+      if (v4()) {
+        const std::size_t n_blocks = size_field();
+        in_.skip(3 * ds);
+        for (std::size_t b = 0; b < n_blocks; ++b) {
+          int_field();
+          int_field();
+          const MshElementType info = element_type(int_field());
+          const std::size_t count = size_field();
+          in_.skip(count * (1 + static_cast<std::size_t>(info.num_nodes)) * ds);
+        }
+      } else {
+        const std::size_t total = static_cast<std::size_t>(in_.ascii_int());
+        in_.skip_line();
+        std::size_t done = 0;
+        while (done < total) {
+          const MshElementType info = element_type(in_.binary<int32_t>());
+          const std::size_t follow =
+              static_cast<std::size_t>(std::max(in_.binary<int32_t>(), 0));
+          const std::size_t n_tags =
+              static_cast<std::size_t>(std::max(in_.binary<int32_t>(), 0));
+          in_.skip(follow * (1 + n_tags + static_cast<std::size_t>(
+                                              info.num_nodes)) *
+                   sizeof(int32_t));
+          done += follow;
+        }
+      }
+    }
+    expect_end(name);
+  }
+
+  void skip_section(const std::string& name) {
+    const std::string marker = "$End" + name;
+    if (!in_.seek_past(marker.c_str())) {
+      Fail(QString("unterminated section $%1").arg(QString::fromStdString(name)));
+    }
+  }
+
+  void read_format() {
+    fmt_.version = in_.ascii_double();
+    fmt_.binary = in_.ascii_int() != 0;
+    fmt_.data_size = static_cast<int>(in_.ascii_int());
+    in_.skip_line();
+    const bool supported = (fmt_.version >= 4.1 && fmt_.version < 5.0) ||
+                           (fmt_.version >= 2.0 && fmt_.version < 3.0);
+    if (!supported) {
+      Fail(QString("unsupported MSH version %1").arg(fmt_.version));
+    }
+    if (fmt_.data_size != 4 && fmt_.data_size != 8) {
+      Fail(QString("unsupported data size %1").arg(fmt_.data_size));
+    }
+    if (fmt_.binary) {
+      if (in_.binary<int32_t>() != 1) {
+        Fail("byte-swapped binary MSH is not supported");
+      }
+      in_.skip_line();
+    }
+    visitor_.format(fmt_);
+  }
+
+  void read_physical_names() {
+    seen_names_ = true;
+    const long long count = in_.ascii_int();
+    in_.skip_line();
+    for (long long i = 0; i < count; ++i) {
+      const int dim = static_cast<int>(in_.ascii_int());
+      const int tag = static_cast<int>(in_.ascii_int());
+      const std::string rest = in_.line();
+      const auto first = rest.find('"');
+      const auto last = rest.rfind('"');
+      QString name;
+      if (first != std::string::npos && last > first) {
+        name = QString::fromUtf8(rest.data() + first + 1,
+                                 static_cast<int>(last - first - 1));
+      }
+      visitor_.physical_name(dim, tag, name);
+    }
+  }
+
+  // size_t-typed fields of MSH 4 (counts and tags).
+  std::size_t size_field() {
+    if (!fmt_.binary) {
+      return static_cast<std::size_t>(in_.ascii_int());
+    }
+    if (fmt_.data_size == 8) {
+      return static_cast<std::size_t>(in_.binary<uint64_t>());
+    }
+    return static_cast<std::size_t>(in_.binary<uint32_t>());
+  }
+
+  int int_field() {
+    return fmt_.binary ? in_.binary<int32_t>()
+                       : static_cast<int>(in_.ascii_int());
+  }
+
+  double double_field() {
+    return fmt_.binary ? in_.binary<double>() : in_.ascii_double();
+  }
+
+  void size_fields(std::size_t* dst, std::size_t n) {
+    if (fmt_.binary && fmt_.data_size == static_cast<int>(sizeof(std::size_t))) {
+      in_.bytes(dst, n * sizeof(std::size_t));
+      return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = size_field();
+    }
+  }
+
+  void read_entities() {
+    seen_entities_ = true;
+    std::size_t counts[4] = {0, 0, 0, 0};
+    for (auto& c : counts) {
+      c = size_field();
+    }
+    std::vector<int> phys;
+    for (int dim = 0; dim < 4; ++dim) {
+      for (std::size_t i = 0; i < counts[dim]; ++i) {
+        const int tag = int_field();
+        const int n_coords = dim == 0 ? 3 : 6;
+        for (int c = 0; c < n_coords; ++c) {
+          double_field();
+        }
+        phys.resize(size_field());
+        for (auto& p : phys) {
+          p = int_field();
+        }
+        if (dim > 0) {
+          const std::size_t n_bound = size_field();
+          for (std::size_t b = 0; b < n_bound; ++b) {
+            int_field();
+          }
+        }
+        entity_phys_[{dim, tag}] = phys.empty() ? 0 : phys.back();
+        visitor_.entity(dim, tag, phys);
+      }
+    }
+    if (!fmt_.binary) {
+      in_.skip_line();
+    }
+  }
+
+  void read_nodes_v4() {
+    const std::size_t n_blocks = size_field();
+    const std::size_t total = size_field();
+    size_field();  // min tag
+    size_field();  // max tag
+    visitor_.nodes_begin(total);
+    for (std::size_t b = 0; b < n_blocks; ++b) {
+      const int dim = int_field();
+      int_field();  // entity tag
+      const bool parametric = int_field() != 0;
+      const std::size_t count = size_field();
+      tags_.resize(count);
+      size_fields(tags_.data(), count);
+      coords_.resize(3 * count);
+      const int extra = parametric ? dim : 0;
+      if (fmt_.binary && extra == 0) {
+        in_.bytes(coords_.data(), coords_.size() * sizeof(double));
+      } else {
+        for (std::size_t i = 0; i < count; ++i) {
+          for (int c = 0; c < 3; ++c) {
+            coords_[3 * i + static_cast<std::size_t>(c)] = double_field();
+          }
+          for (int c = 0; c < extra; ++c) {
+            double_field();
+          }
+        }
+      }
+      visitor_.node_block(tags_.data(), coords_.data(), count);
+    }
+    if (!fmt_.binary) {
+      in_.skip_line();
+    }
+  }
+
+  void read_nodes_v2() {
+    const std::size_t total = static_cast<std::size_t>(in_.ascii_int());
+    in_.skip_line();
+    visitor_.nodes_begin(total);
+    constexpr std::size_t kChunk = 1 << 16;
+    std::size_t done = 0;
+    while (done < total) {
+      const std::size_t count = std::min(kChunk, total - done);
+      tags_.resize(count);
+      coords_.resize(3 * count);
+      for (std::size_t i = 0; i < count; ++i) {
+        tags_[i] = static_cast<std::size_t>(int_field());
+        for (int c = 0; c < 3; ++c) {
+          coords_[3 * i + static_cast<std::size_t>(c)] = double_field();
+        }
+      }
+      visitor_.node_block(tags_.data(), coords_.data(), count);
+      done += count;
+    }
+    if (!fmt_.binary) {
+      in_.skip_line();
+    }
+  }
+
+  MshElementType element_type(int type) const {
+    MshElementType info;
+    if (!LookupMshElementType(type, &info)) {
+      Fail(QString("unsupported element type %1").arg(type));
+    }
+    return info;
+  }
+
+  void read_elements_v4() {
+    const std::size_t n_blocks = size_field();
+    const std::size_t total = size_field();
+    size_field();  // min tag
+    size_field();  // max tag
+    visitor_.elements_begin(total);
+    std::vector<std::size_t> raw;
+    for (std::size_t b = 0; b < n_blocks; ++b) {
+      MshElementBlock block;
+      block.entity_dim = int_field();
+      block.entity_tag = int_field();
+      block.type = element_type(int_field());
+      block.count = size_field();
+      const auto phys_it =
+          entity_phys_.find({block.entity_dim, block.entity_tag});
+      block.phys_id = phys_it == entity_phys_.end() ? 0 : phys_it->second;
+      const std::size_t stride =
+          1 + static_cast<std::size_t>(block.type.num_nodes);
+      raw.resize(block.count * stride);
+      size_fields(raw.data(), raw.size());
+      tags_.resize(block.count);
+      nodes_tmp_.resize(block.count * (stride - 1));
+      for (std::size_t e = 0; e < block.count; ++e) {
+        tags_[e] = raw[e * stride];
+        std::copy(raw.begin() + static_cast<std::ptrdiff_t>(e * stride + 1),
+                  raw.begin() + static_cast<std::ptrdiff_t>((e + 1) * stride),
+                  nodes_tmp_.begin() +
+                      static_cast<std::ptrdiff_t>(e * (stride - 1)));
+      }
+      block.tags = tags_.data();
+      block.nodes = nodes_tmp_.data();
+      visitor_.element_block(block);
+    }
+    if (!fmt_.binary) {
+      in_.skip_line();
+    }
+  }
+
+  // MSH 2 stores physical and elementary tags per element; consecutive
+  // elements sharing both are coalesced into one block.
+  void read_elements_v2() {
+    const std::size_t total = static_cast<std::size_t>(in_.ascii_int());
+    in_.skip_line();
+    visitor_.elements_begin(total);
+
+    MshElementBlock run;
+    bool run_open = false;
+    auto flush = [&]() {
+      if (run_open && run.count > 0) {
+        run.tags = tags_.data();
+        run.nodes = nodes_tmp_.data();
+        visitor_.element_block(run);
+      }
+      tags_.clear();
+      nodes_tmp_.clear();
+      run.count = 0;
+      run_open = false;
+    };
+    auto push = [&](int type, int phys, int entity, std::size_t tag,
+                    const std::vector<std::size_t>& nodes) {
+      if (!run_open || run.type.type != type || run.phys_id != phys ||
+          run.entity_tag != entity) {
+        flush();
+        run.type = element_type(type);
+        run.phys_id = phys;
+        run.entity_tag = entity;
+        run.entity_dim = run.type.dim;
+        run_open = true;
+      }
+      tags_.push_back(tag);
+      nodes_tmp_.insert(nodes_tmp_.end(), nodes.begin(), nodes.end());
+      ++run.count;
+    };
+
+    std::vector<std::size_t> nodes;
+    std::vector<int> tags;
+    std::size_t done = 0;
+    while (done < total) {
+      if (fmt_.binary) {
+        const int type = in_.binary<int32_t>();
+        const int follow = in_.binary<int32_t>();
+        const int n_tags = in_.binary<int32_t>();
+        const MshElementType info = element_type(type);
+        tags.resize(static_cast<std::size_t>(n_tags));
+        nodes.resize(static_cast<std::size_t>(info.num_nodes));
+        for (int e = 0; e < follow; ++e) {
+          const int number = in_.binary<int32_t>();
+          for (auto& t : tags) {
+            t = in_.binary<int32_t>();
+          }
+          for (auto& n : nodes) {
+            n = static_cast<std::size_t>(in_.binary<int32_t>());
+          }
+          push(type, n_tags > 0 ? tags[0] : 0, n_tags > 1 ? tags[1] : 0,
+               static_cast<std::size_t>(number), nodes);
+        }
+        done += static_cast<std::size_t>(std::max(follow, 0));
+      } else {
+        const std::size_t number = static_cast<std::size_t>(in_.ascii_int());
+        const int type = static_cast<int>(in_.ascii_int());
+        const int n_tags = static_cast<int>(in_.ascii_int());
+        const MshElementType info = element_type(type);
+        tags.resize(static_cast<std::size_t>(n_tags));
+        for (auto& t : tags) {
+          t = static_cast<int>(in_.ascii_int());
+        }
+        nodes.resize(static_cast<std::size_t>(info.num_nodes));
+        for (auto& n : nodes) {
+          n = static_cast<std::size_t>(in_.ascii_int());
+        }
+        push(type, n_tags > 0 ? tags[0] : 0, n_tags > 1 ? tags[1] : 0, number,
+             nodes);
+        ++done;
+      }
+    }
+    flush();
+    if (!fmt_.binary) {
+      in_.skip_line();
+    }
+  }
+
+  Cursor in_;
+  MshVisitor& visitor_;
+  const MshReadOptions& options_;
+  MshFileFormat fmt_;
+  bool seen_names_ = false;
+  bool seen_entities_ = false;
+  std::map<std::pair<int, int>, int> entity_phys_;
+  std::vector<std::size_t> tags_;
+  std::vector<std::size_t> nodes_tmp_;
+  std::vector<double> coords_;
+};
+
+class HeaderCollector : public MshVisitor {
+ public:
+  explicit HeaderCollector(MshHeaderInfo* info) : info_(info) {}
+
+  void format(const MshFileFormat& fmt) override { info_->format = fmt; }
+  void physical_name(int dim, int tag, const QString& name) override {
+    groups_[{dim, tag}] = name;
+  }
+  void entity(int dim, int, const std::vector<int>& phys_tags) override {
+    info_->max_entity_dim = std::max(info_->max_entity_dim, dim);
+    for (const int p : phys_tags) {
+      groups_.insert({{dim, p}, QString()});
+    }
+  }
+
+  void finish() {
+    info_->physical_groups.clear();
+    info_->physical_groups.reserve(groups_.size());
+    for (const auto& g : groups_) {
+      info_->physical_groups.push_back({g.first.first, g.first.second, g.second});
+    }
+  }
+
+ private:
+  MshHeaderInfo* info_;
+  std::map<std::pair<int, int>, QString> groups_;
+};
+
+struct HeaderCacheEntry {
+  qint64 size = -1;
+  QDateTime mtime;
+  MshHeaderInfo info;
+};
+
+constexpr int kHeaderCacheLimit = 64;
+
+QMutex& HeaderCacheMutex() {
+  static QMutex mutex;
+  return mutex;
+}
+
+QHash<QString, HeaderCacheEntry>& HeaderCache() {
+  static QHash<QString, HeaderCacheEntry> cache;
+  return cache;
+}
+
+}  // namespace
+
+bool ScanMshHeader(const QString& path, MshHeaderInfo* info, QString* error) {
+  const QFileInfo fi(path);
+  if (!fi.exists()) {
+    if (error) {
+      *error = "file not found";
+    }
+    return false;
+  }
+  const QString key = fi.absoluteFilePath();
+  const qint64 size = fi.size();
+  const QDateTime mtime = fi.lastModified();
+  {
+    QMutexLocker lock(&HeaderCacheMutex());
+    const auto it = HeaderCache().constFind(key);
+    if (it != HeaderCache().constEnd() && it->size == size &&
+        it->mtime == mtime) {
+      if (info) {
+        *info = it->info;
+      }
+      return true;
+    }
+  }
+
+  MshHeaderInfo scanned;
+  HeaderCollector collector(&scanned);
+  MshReadOptions options;
+  options.read_mesh = false;
+  if (!ReadMsh(path, collector, options, error)) {
+    return false;
+  }
+  collector.finish();
+
+  {
+    QMutexLocker lock(&HeaderCacheMutex());
+    auto& cache = HeaderCache();
+    if (cache.size() >= kHeaderCacheLimit && !cache.contains(key)) {
+      cache.clear();
+    }
+    cache.insert(key, HeaderCacheEntry{size, mtime, scanned});
+  }
+  if (info) {
+    *info = std::move(scanned);
+  }
+  return true;
+}
+
+bool LookupMshElementType(int type, MshElementType* info) {
+  for (const auto& entry : kElementTypes) {
+    if (entry.type == type) {
+      if (info) {
+        *info = entry;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ReadMsh(const QString& path, MshVisitor& visitor,
+             const MshReadOptions& options, QString* error) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    if (error) {
+      *error = file.errorString();
+    }
+    return false;
+  }
+  const qint64 size = file.size();
+  uchar* data = size > 0 ? file.map(0, size) : nullptr;
+  if (!data) {
+    if (error) {
+      *error = size > 0 ? "failed to map file" : "empty file";
+    }
+    return false;
+  }
+  const char* begin = reinterpret_cast<const char*>(data);
+  bool ok = true;
+  try {
+    Parser parser(Cursor(begin, begin + size), visitor, options);
+    parser.run();
+  } catch (const ParseError& ex) {
+    if (error) {
+      *error = ex.what;
+    }
+    ok = false;
+  } catch (const std::exception& ex) {
+    if (error) {
+      *error = QString::fromUtf8(ex.what());
+    }
+    ok = false;
+  }
+  file.unmap(data);
+  return ok;
+}
+
+}  // namespace gmp
@@ -0,0 +1,216 @@
+#include "gmp/OutputFramer.h"
+
+#include <QIODevice>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace gmp {
+
+namespace {
+
+constexpr std::size_t kRingBytes = 4u << 20;
+// The worker pauses framing while this many lines wait for the UI.
+constexpr int kMaxPendingLines = 50000;
+// A "line" longer than this is cut, so a stream without newlines cannot
+// grow the carry buffer without bound.
+constexpr int kMaxLineBytes = 1 << 20;
+constexpr int kDeliverMs = 50;
+constexpr qint64 kRateWindowMs = 500;
+
+}  // namespace
+
+OutputFramer::OutputFramer(QObject* parent)
+    : QObject(parent), ring_(kRingBytes) {
+  timer_.setInterval(kDeliverMs);
+  connect(&timer_, &QTimer::timeout, this, [this]() {
+    if (stalled_) {
+      pump();
+    }
+    deliver();
+  });
+  worker_ = std::thread([this]() { worker_loop(); });
+}
+
+OutputFramer::~OutputFramer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  worker_.join();
+}
+
+void OutputFramer::set_watch_pattern(const QRegularExpression& pattern,
+                                     int group) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  watch_ = pattern;
+  watch_.optimize();
+  watch_group_ = group;
+}
+
+void OutputFramer::attach(QIODevice* device) {
+  device_ = device;
+  connect(device_, &QIODevice::readyRead, this, [this]() { pump(); });
+  rate_clock_.start();
+  timer_.start();
+}
+
+bool OutputFramer::pump() {
+  if (!device_) {
+    return true;
+  }
+  const qint64 capacity = static_cast<qint64>(ring_.size());
+  while (device_->bytesAvailable() > 0) {
+    qint64 head = 0;
+    qint64 tail = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      head = head_;
+      tail = tail_;
+    }
+    const qint64 free = capacity - (head - tail);
+    if (free <= 0) {
+      stalled_ = true;
+      return false;
+    }
+    // Only this thread writes [head, tail + capacity), so the read into
+    // the ring needs no lock.
+    const qint64 offset = head % capacity;
+    const qint64 span = std::min(free, capacity - offset);
+    const qint64 read = device_->read(ring_.data() + offset, span);
+    if (read <= 0) {
+      break;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      head_ += read;
+    }
+    wake_.notify_one();
+  }
+  stalled_ = false;
+  return true;
+}
+
+void OutputFramer::worker_loop() {
+  const qint64 capacity = static_cast<qint64>(ring_.size());
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this]() {
+      return stop_ ||
+             (head_ != tail_ && pending_.lines.size() < kMaxPendingLines);
+    });
+    if (stop_) {
+      break;
+    }
+    const qint64 offset = tail_ % capacity;
+    const qint64 span = std::min(head_ - tail_, capacity - offset);
+    lock.unlock();
+
+    OutputBatch framed;
+    frame(ring_.data() + offset, span, &framed);
+
+    lock.lock();
+    pending_.lines.append(framed.lines);
+    pending_.matches.append(framed.matches);
+    tail_ += span;
+    drained_.notify_all();
+  }
+}
+
+void OutputFramer::frame(const char* data, qint64 size, OutputBatch* out) {
+  const char* p = data;
+  const char* end = data + size;
+  while (p < end) {
+    const auto* newline =
+        static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (!newline) {
+      carry_.append(p, static_cast<int>(end - p));
+      if (carry_.size() >= kMaxLineBytes) {
+        add_line(carry_.constData(), carry_.size(), out);
+        carry_.clear();
+      }
+      return;
+    }
+    if (carry_.isEmpty()) {
+      add_line(p, newline - p, out);
+    } else {
+      carry_.append(p, static_cast<int>(newline - p));
+      add_line(carry_.constData(), carry_.size(), out);
+      carry_.clear();
+    }
+    p = newline + 1;
+  }
+}
+
+void OutputFramer::add_line(const char* data, qint64 size, OutputBatch* out) {
+  const QString line =
+      QString::fromUtf8(data, static_cast<int>(size)).trimmed();
+  if (line.isEmpty()) {
+    return;
+  }
+  if (!watch_.pattern().isEmpty()) {
+    auto it = watch_.globalMatch(line);
+    while (it.hasNext()) {
+      out->matches << it.next().captured(watch_group_);
+    }
+  }
+  out->lines << line;
+}
+
+void OutputFramer::deliver() {
+  OutputBatch batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(batch, pending_);
+  }
+  wake_.notify_one();
+  total_lines_ += batch.lines.size();
+  window_lines_ += batch.lines.size();
+  const qint64 elapsed = rate_clock_.elapsed();
+  bool rate_changed = false;
+  if (elapsed >= kRateWindowMs) {
+    const double rate =
+        static_cast<double>(window_lines_) * 1000.0 / static_cast<double>(elapsed);
+    rate_changed = rate != rate_;
+    rate_ = rate;
+    window_lines_ = 0;
+    rate_clock_.restart();
+  }
+  if (batch.lines.isEmpty() && !rate_changed) {
+    return;
+  }
+  batch.total_lines = total_lines_;
+  batch.lines_per_second = rate_;
+  emit batch_ready(batch);
+}
+
+void OutputFramer::flush() {
+  timer_.stop();
+  while (true) {
+    pump();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      drained_.wait_for(lock, std::chrono::milliseconds(10),
+                        [this]() { return head_ == tail_; });
+    }
+    // Delivering also unblocks a worker held back by kMaxPendingLines.
+    deliver();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (head_ == tail_ && (!device_ || device_->bytesAvailable() <= 0)) {
+      // The worker is idle with an empty ring, so carry_ is safe to use.
+      if (!carry_.isEmpty()) {
+        add_line(carry_.constData(), carry_.size(), &pending_);
+        carry_.clear();
+      }
+      break;
+    }
+  }
+  deliver();
+  if (device_) {
+    disconnect(device_, nullptr, this, nullptr);
+  }
+  device_ = nullptr;
+}
+
+}  // namespace gmp
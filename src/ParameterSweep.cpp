@@ -0,0 +1,275 @@
+#include "gmp/ParameterSweep.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <cmath>
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+#include <mutex>
+
+#include <vtkExodusIIReader.h>
+#include <vtkSmartPointer.h>
+
+#include "gmp/ExodusStepCache.h"
+#endif
+
+namespace gmp {
+
+namespace {
+
+// Beyond this a full factorial is almost certainly a typo in a range.
+constexpr std::size_t kMaxCases = 10000;
+
+QString CsvField(const QString& text) {
+  if (!text.contains(',') && !text.contains('"') && !text.contains('\n')) {
+    return text;
+  }
+  QString quoted = text;
+  quoted.replace("\"", "\"\"");
+  return "\"" + quoted + "\"";
+}
+
+QString CsvNumber(const QVariant& value) {
+  bool ok = false;
+  const double v = value.toDouble(&ok);
+  return ok && std::isfinite(v) ? QString::number(v, 'g', 10) : QString();
+}
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+void ReadExodusGlobals(const QString& exodus, const QStringList& names,
+                       QVariantMap* out, QString* error) {
+  std::lock_guard<std::mutex> io(ExodusIoMutex());
+  auto reader = vtkSmartPointer<vtkExodusIIReader>::New();
+  const QByteArray path = exodus.toUtf8();
+  if (!reader->CanReadFile(path.constData())) {
+    *error = "Cannot read " + exodus;
+    return;
+  }
+  reader->SetFileName(path.constData());
+  reader->UpdateInformation();
+  // Only the globals are wanted; skip every field array.
+  for (const int type : {vtkExodusIIReader::NODAL, vtkExodusIIReader::ELEM_BLOCK}) {
+    for (int i = 0; i < reader->GetNumberOfObjectArrays(type); ++i) {
+      reader->SetObjectArrayStatus(type, i, 0);
+    }
+  }
+  bool any = false;
+  const int global = vtkExodusIIReader::GLOBAL;
+  for (int i = 0; i < reader->GetNumberOfObjectArrays(global); ++i) {
+    const bool wanted =
+        names.contains(QString::fromUtf8(reader->GetObjectArrayName(global, i)));
+    reader->SetObjectArrayStatus(global, i, wanted ? 1 : 0);
+    any = any || wanted;
+  }
+  if (!any) {
+    return;
+  }
+  int range[2] = {0, 0};
+  reader->GetTimeStepRange(range);
+  reader->SetTimeStep(range[1]);
+  reader->Update();
+  for (const QString& name : names) {
+    const double value =
+        ExodusGlobalValue(reader->GetOutput(), name.toUtf8().constData());
+    if (std::isfinite(value)) {
+      out->insert(name, value);
+    }
+  }
+}
+#endif
+
+// MOOSE writes postprocessors to <file base>.csv next to <file base>.e.
+void ReadCsvGlobals(const QString& exodus, const QStringList& names,
+                    QVariantMap* out) {
+  const QFileInfo info(exodus);
+  QFile file(info.dir().filePath(info.completeBaseName() + ".csv"));
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    return;
+  }
+  QTextStream in(&file);
+  const QStringList header = in.readLine().split(',');
+  QString last;
+  while (!in.atEnd()) {
+    const QString line = in.readLine();
+    if (!line.trimmed().isEmpty()) {
+      last = line;
+    }
+  }
+  const QStringList row = last.split(',');
+  for (const QString& name : names) {
+    const int col = header.indexOf(name);
+    if (out->contains(name) || col < 0 || col >= row.size()) {
+      continue;
+    }
+    bool ok = false;
+    const double value = row[col].toDouble(&ok);
+    if (ok) {
+      out->insert(name, value);
+    }
+  }
+}
+
+}  // namespace
+
+QStringList ParseSweepValues(const QString& text, QString* error) {
+  const QString trimmed = text.trimmed();
+  const QStringList range = trimmed.split(':');
+  if (range.size() == 3) {
+    bool ok_start = false;
+    bool ok_stop = false;
+    bool ok_count = false;
+    const double start = range[0].trimmed().toDouble(&ok_start);
+    const double stop = range[1].trimmed().toDouble(&ok_stop);
+    const int count = range[2].trimmed().toInt(&ok_count);
+    if (!ok_start || !ok_stop || !ok_count || count < 1) {
+      if (error) {
+        *error = "Expected start:stop:count, got \"" + trimmed + "\".";
+      }
+      return {};
+    }
+    QStringList values;
+    for (int i = 0; i < count; ++i) {
+      const double t = count == 1 ? 0.0 : static_cast<double>(i) / (count - 1);
+      values << QString::number(start + t * (stop - start), 'g', 12);
+    }
+    return values;
+  }
+  QStringList values;
+  for (const QString& part : trimmed.split(',')) {
+    if (!part.trimmed().isEmpty()) {
+      values << part.trimmed();
+    }
+  }
+  if (values.isEmpty() && error) {
+    *error = "No values given.";
+  }
+  return values;
+}
+
+std::vector<SweepCase> ExpandSweep(const std::vector<SweepFactor>& factors,
+                                   SweepDesign design, QString* error) {
+  auto fail = [error](const QString& text) {
+    if (error) {
+      *error = text;
+    }
+    return std::vector<SweepCase>();
+  };
+  if (factors.empty()) {
+    return fail("Add at least one parameter to sweep.");
+  }
+  std::size_t count = 1;
+  for (const SweepFactor& f : factors) {
+    if (f.values.isEmpty()) {
+      return fail(f.target + " has no values.");
+    }
+    if (design == SweepDesign::Paired) {
+      if (f.values.size() != factors.front().values.size()) {
+        return fail("Paired sweeps need the same number of values for every "
+                    "parameter.");
+      }
+      count = static_cast<std::size_t>(f.values.size());
+    } else {
+      count *= static_cast<std::size_t>(f.values.size());
+      if (count > kMaxCases) {
+        return fail(QString("More than %1 cases.").arg(kMaxCases));
+      }
+    }
+  }
+
+  std::vector<SweepCase> cases(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    SweepCase& c = cases[i];
+    c.index = static_cast<int>(i) + 1;
+    c.status = "Pending";
+    // Full factorial: the last factor varies fastest.
+    std::size_t rest = i;
+    QStringList mesh_parts;
+    for (std::size_t k = factors.size(); k-- > 0;) {
+      const SweepFactor& f = factors[k];
+      const std::size_t n = static_cast<std::size_t>(f.values.size());
+      const std::size_t pick = design == SweepDesign::Paired ? i : rest % n;
+      rest /= design == SweepDesign::Paired ? 1 : n;
+      c.values.prepend(f.values[static_cast<int>(pick)]);
+      if (f.is_mesh()) {
+        mesh_parts.prepend(f.key() + "=" + f.values[static_cast<int>(pick)]);
+      }
+    }
+    c.mesh_key = mesh_parts.join(';');
+  }
+  return cases;
+}
+
+bool WriteSweepCsv(const QString& path, const std::vector<SweepFactor>& factors,
+                   const QStringList& globals,
+                   const std::vector<SweepCase>& cases, QString* error) {
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+    if (error) {
+      *error = file.errorString();
+    }
+    return false;
+  }
+  QTextStream out(&file);
+  QStringList header{"case"};
+  for (const SweepFactor& f : factors) {
+    header << CsvField(f.target);
+  }
+  header << "status" << "job";
+  for (const QString& name : globals) {
+    header << CsvField(name);
+  }
+  header << "exodus";
+  out << header.join(',') << '\n';
+  for (const SweepCase& c : cases) {
+    QStringList row{QString::number(c.index)};
+    for (const QString& value : c.values) {
+      row << CsvField(value);
+    }
+    row << c.status << (c.job_id > 0 ? QString::number(c.job_id) : QString());
+    for (const QString& name : globals) {
+      row << CsvNumber(c.results.value(name));
+    }
+    row << CsvField(c.exodus);
+    out << row.join(',') << '\n';
+  }
+  out.flush();
+  if (out.status() != QTextStream::Ok) {
+    if (error) {
+      *error = file.errorString();
+    }
+    return false;
+  }
+  return true;
+}
+
+QVariantMap ReadFinalGlobals(const QString& exodus, const QStringList& names,
+                             QString* error) {
+  QVariantMap out;
+  if (exodus.isEmpty() || names.isEmpty()) {
+    return out;
+  }
+  QString read_error;
+#ifdef GMP_ENABLE_VTK_VIEWER
+  ReadExodusGlobals(exodus, names, &out, &read_error);
+#endif
+  if (out.size() < names.size()) {
+    ReadCsvGlobals(exodus, names, &out);
+  }
+  if (out.size() < names.size() && read_error.isEmpty()) {
+    QStringList missing;
+    for (const QString& name : names) {
+      if (!out.contains(name)) {
+        missing << name;
+      }
+    }
+    read_error = "Not found: " + missing.join(", ");
+  }
+  if (error) {
+    *error = read_error;
+  }
+  return out;
+}
+
+}  // namespace gmp
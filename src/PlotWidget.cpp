@@ -0,0 +1,215 @@
+#include "gmp/PlotWidget.h"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QPolygonF>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace gmp {
+
+namespace {
+
+constexpr double kLeft = 64.0;
+constexpr double kRight = 12.0;
+constexpr double kTop = 22.0;
+constexpr double kBottom = 30.0;
+
+QString TickText(double value) {
+  return QString::number(value, 'g', 4);
+}
+
+}  // namespace
+
+PlotWidget::PlotWidget(QWidget* parent)
+    : QWidget(parent), marker_(std::numeric_limits<double>::quiet_NaN()) {
+  setBackgroundRole(QPalette::Base);
+  setAutoFillBackground(true);
+}
+
+void PlotWidget::set_histogram(const std::vector<qint64>& counts, double lo,
+                               double hi, const QString& title) {
+  kind_ = Kind::Histogram;
+  title_ = title;
+  message_.clear();
+  xs_.clear();
+  ys_.assign(counts.begin(), counts.end());
+  lo_ = lo;
+  hi_ = hi;
+  update();
+}
+
+void PlotWidget::set_series(const std::vector<double>& x,
+                            const std::vector<double>& y,
+                            const QString& title) {
+  kind_ = Kind::Series;
+  title_ = title;
+  message_.clear();
+  const std::size_t n = std::min(x.size(), y.size());
+  xs_.assign(x.begin(), x.begin() + n);
+  ys_.assign(y.begin(), y.begin() + n);
+  update();
+}
+
+void PlotWidget::set_marker(double x) {
+  marker_ = x;
+  if (kind_ == Kind::Series) {
+    update();
+  }
+}
+
+void PlotWidget::set_message(const QString& text) {
+  kind_ = Kind::Message;
+  message_ = text;
+  xs_.clear();
+  ys_.clear();
+  update();
+}
+
+QSize PlotWidget::sizeHint() const {
+  return QSize(360, 200);
+}
+
+QSize PlotWidget::minimumSizeHint() const {
+  return QSize(160, 96);
+}
+
+void PlotWidget::paintEvent(QPaintEvent* event) {
+  Q_UNUSED(event);
+  QPainter painter(this);
+  const QColor text = palette().text().color();
+  painter.setPen(text);
+  if (kind_ == Kind::Message || ys_.empty()) {
+    painter.drawText(rect(), Qt::AlignCenter,
+                     message_.isEmpty() ? QString("No data") : message_);
+    return;
+  }
+
+  double x0 = lo_;
+  double x1 = hi_;
+  double y0 = 0.0;
+  double y1 = 0.0;
+  if (kind_ == Kind::Histogram) {
+    y1 = std::max(1.0, *std::max_element(ys_.begin(), ys_.end()));
+  } else {
+    x0 = y0 = std::numeric_limits<double>::infinity();
+    x1 = y1 = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < xs_.size(); ++i) {
+      if (!std::isfinite(xs_[i]) || !std::isfinite(ys_[i])) {
+        continue;
+      }
+      x0 = std::min(x0, xs_[i]);
+      x1 = std::max(x1, xs_[i]);
+      y0 = std::min(y0, ys_[i]);
+      y1 = std::max(y1, ys_[i]);
+    }
+    if (x0 > x1) {
+      painter.drawText(rect(), Qt::AlignCenter, "No finite values");
+      return;
+    }
+    const double pad = (y1 - y0) * 0.05;
+    y0 -= pad;
+    y1 += pad;
+  }
+  if (!(x1 > x0)) {
+    x0 -= 0.5;
+    x1 += 0.5;
+  }
+  if (!(y1 > y0)) {
+    y0 -= 0.5;
+    y1 += 0.5;
+  }
+
+  const QRectF area(kLeft, kTop, std::max(1.0, width() - kLeft - kRight),
+                    std::max(1.0, height() - kTop - kBottom));
+  auto map_x = [&](double x) {
+    return area.left() + (x - x0) / (x1 - x0) * area.width();
+  };
+  auto map_y = [&](double y) {
+    return area.bottom() - (y - y0) / (y1 - y0) * area.height();
+  };
+
+  painter.drawText(QRectF(kLeft, 2.0, area.width(), kTop - 4.0),
+                   Qt::AlignLeft | Qt::AlignVCenter, title_);
+  painter.drawText(QRectF(0.0, area.top() - 8.0, kLeft - 6.0, 16.0),
+                   Qt::AlignRight | Qt::AlignVCenter, TickText(y1));
+  painter.drawText(QRectF(0.0, area.bottom() - 8.0, kLeft - 6.0, 16.0),
+                   Qt::AlignRight | Qt::AlignVCenter, TickText(y0));
+  painter.drawText(QRectF(area.left(), area.bottom() + 4.0, area.width(), 16.0),
+                   Qt::AlignLeft | Qt::AlignTop, TickText(x0));
+  painter.drawText(QRectF(area.left(), area.bottom() + 4.0, area.width(), 16.0),
+                   Qt::AlignRight | Qt::AlignTop, TickText(x1));
+
+  painter.setRenderHint(QPainter::Antialiasing, kind_ == Kind::Series);
+  const QColor accent = palette().highlight().color();
+  if (kind_ == Kind::Histogram) {
+    const double bar = area.width() / static_cast<double>(ys_.size());
+    for (std::size_t i = 0; i < ys_.size(); ++i) {
+      if (ys_[i] <= 0.0) {
+        continue;
+      }
+      const double top = map_y(ys_[i]);
+      painter.fillRect(QRectF(area.left() + bar * static_cast<double>(i), top,
+                              std::max(1.0, bar - 1.0), area.bottom() - top),
+                       accent);
+    }
+  } else {
+    painter.setPen(QPen(accent, 1.5));
+    const int columns = static_cast<int>(area.width()) + 1;
+    if (xs_.size() > static_cast<std::size_t>(2 * columns)) {
+      // Min/max per pixel column; gaps stay gaps.
+      std::vector<double> lo(columns, std::numeric_limits<double>::infinity());
+      std::vector<double> hi(columns, -std::numeric_limits<double>::infinity());
+      for (std::size_t i = 0; i < xs_.size(); ++i) {
+        if (!std::isfinite(xs_[i]) || !std::isfinite(ys_[i])) {
+          continue;
+        }
+        const int c = std::clamp(static_cast<int>(map_x(xs_[i]) - area.left()),
+                                 0, columns - 1);
+        lo[c] = std::min(lo[c], ys_[i]);
+        hi[c] = std::max(hi[c], ys_[i]);
+      }
+      QPolygonF line;
+      for (int c = 0; c < columns; ++c) {
+        if (lo[c] > hi[c]) {
+          continue;
+        }
+        const double x = area.left() + c;
+        line << QPointF(x, map_y(lo[c])) << QPointF(x, map_y(hi[c]));
+      }
+      painter.drawPolyline(line);
+    } else {
+      QPolygonF line;
+      for (std::size_t i = 0; i < xs_.size(); ++i) {
+        if (!std::isfinite(xs_[i]) || !std::isfinite(ys_[i])) {
+          painter.drawPolyline(line);
+          line.clear();
+          continue;
+        }
+        line << QPointF(map_x(xs_[i]), map_y(ys_[i]));
+      }
+      painter.drawPolyline(line);
+      if (xs_.size() <= 64) {
+        painter.setBrush(accent);
+        for (std::size_t i = 0; i < xs_.size(); ++i) {
+          if (std::isfinite(xs_[i]) && std::isfinite(ys_[i])) {
+            painter.drawEllipse(QPointF(map_x(xs_[i]), map_y(ys_[i])), 2.0,
+                                2.0);
+          }
+        }
+      }
+    }
+    if (std::isfinite(marker_) && marker_ >= x0 && marker_ <= x1) {
+      painter.setPen(QPen(QColor(220, 60, 60), 1.0, Qt::DashLine));
+      const double x = map_x(marker_);
+      painter.drawLine(QPointF(x, area.top()), QPointF(x, area.bottom()));
+    }
+  }
+  painter.setRenderHint(QPainter::Antialiasing, false);
+  painter.setBrush(Qt::NoBrush);
+  painter.setPen(text);
+  painter.drawRect(area);
+}
+
+}  // namespace gmp
@@ -3,15 +3,35 @@
 namespace gmp {
 
 ProcessRunner::ProcessRunner(QObject* parent) : Runner(parent) {
+  // One pipe for both streams keeps their lines in the order written.
+  proc_.setProcessChannelMode(QProcess::MergedChannels);
   connect(&proc_, &QProcess::started, this, &Runner::started);
-  connect(&proc_, &QProcess::readyReadStandardOutput, this, [this]() {
-    emit std_out(QString::fromUtf8(proc_.readAllStandardOutput()));
-  });
-  connect(&proc_, &QProcess::readyReadStandardError, this, [this]() {
-    emit std_err(QString::fromUtf8(proc_.readAllStandardError()));
-  });
+  connect(&framer_, &OutputFramer::batch_ready, this, &Runner::output);
   connect(&proc_, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-          this, &Runner::finished);
+          this, [this](int exit_code, QProcess::ExitStatus exit_status) {
+            framer_.flush();
+            emit finished(exit_code, exit_status);
+          });
+  // QProcess never reports finished() for a program that did not start;
+  // without this a queued job would hold its cores forever.
+  connect(&proc_, &QProcess::errorOccurred, this,
+          [this](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+              framer_.flush();
+              emit finished(-1, QProcess::CrashExit);
+            }
+          });
+}
+
+ProcessRunner::~ProcessRunner() {
+  // Runners can be destroyed with their process still running (e.g. on
+  // exit). Nothing may reach the framer or the half-destroyed runner while
+  // the process is taken down.
+  proc_.disconnect();
+  if (proc_.state() != QProcess::NotRunning) {
+    proc_.kill();
+    proc_.waitForFinished();
+  }
 }
 
 void ProcessRunner::start_process(const RunSpec& spec) {
@@ -23,6 +43,8 @@ void ProcessRunner::start_process(const RunSpec& spec) {
   if (!spec.env.isEmpty()) {
     proc_.setProcessEnvironment(spec.env);
   }
+  framer_.set_watch_pattern(watch_pattern_, watch_group_);
+  framer_.attach(&proc_);
   proc_.start();
 }
 
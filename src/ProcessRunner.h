@@ -2,6 +2,7 @@
 
 #include <QProcess>
 
+#include "gmp/OutputFramer.h"
 #include "gmp/Runner.h"
 
 namespace gmp {
@@ -10,12 +11,16 @@ class ProcessRunner : public Runner {
   Q_OBJECT
  public:
   explicit ProcessRunner(QObject* parent = nullptr);
+  ~ProcessRunner() override;
 
   void stop() override;
 
  protected:
   void start_process(const RunSpec& spec);
 
+  // Declared first so it outlives proc_, whose destructor still delivers
+  // output and finished() for a process that is running.
+  OutputFramer framer_;
   QProcess proc_;
 };
 
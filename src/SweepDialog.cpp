@@ -0,0 +1,286 @@
+#include "gmp/SweepDialog.h"
+
+#include <QComboBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QRegularExpression>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QThread>
+#include <QVBoxLayout>
+#include <algorithm>
+#include <cmath>
+
+#include "gmp/ComboPopupFix.h"
+
+namespace gmp {
+
+SweepDialog::SweepDialog(QWidget* parent) : QDialog(parent) {
+  setWindowTitle("Parameter Sweep");
+  resize(900, 620);
+  auto* layout = new QVBoxLayout(this);
+
+  auto* pick_row = new QHBoxLayout();
+  target_ = new QComboBox(this);
+  target_->setEditable(true);
+  target_->setMinimumWidth(280);
+  install_combo_popup_fix(target_);
+  values_ = new QLineEdit(this);
+  values_->setPlaceholderText("1, 2.5, 4  or  start:stop:count");
+  auto* add_btn = new QPushButton("Add", this);
+  auto* remove_btn = new QPushButton("Remove", this);
+  pick_row->addWidget(target_, 2);
+  pick_row->addWidget(values_, 2);
+  pick_row->addWidget(add_btn);
+  pick_row->addWidget(remove_btn);
+  layout->addLayout(pick_row);
+
+  factor_table_ = new QTableWidget(0, 2, this);
+  factor_table_->setHorizontalHeaderLabels({"Parameter", "Values"});
+  factor_table_->horizontalHeader()->setStretchLastSection(true);
+  factor_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+  factor_table_->setMaximumHeight(150);
+  layout->addWidget(factor_table_);
+
+  auto* form = new QFormLayout();
+  design_ = new QComboBox(this);
+  design_->addItem("Full factorial");
+  design_->addItem("Paired (i-th value of every parameter)");
+  install_combo_popup_fix(design_);
+  form->addRow("Design", design_);
+  max_parallel_ = new QSpinBox(this);
+  max_parallel_->setRange(1, 256);
+  max_parallel_->setValue(std::max(1, QThread::idealThreadCount() / 2));
+  max_parallel_->setToolTip(
+      "Cases queued at once; the job queue's core budget still applies.");
+  form->addRow("Parallel cases", max_parallel_);
+  globals_ = new QLineEdit(this);
+  globals_->setPlaceholderText("Postprocessor / global variable names");
+  form->addRow("Collect globals", globals_);
+  auto* dir_row = new QHBoxLayout();
+  dir_ = new QLineEdit(this);
+  auto* dir_btn = new QPushButton("...", this);
+  dir_row->addWidget(dir_, 1);
+  dir_row->addWidget(dir_btn);
+  form->addRow("Output dir", dir_row);
+  layout->addLayout(form);
+
+  auto* button_row = new QHBoxLayout();
+  start_btn_ = new QPushButton("Start", this);
+  cancel_btn_ = new QPushButton("Cancel Sweep", this);
+  cancel_btn_->setEnabled(false);
+  export_btn_ = new QPushButton("Export CSV", this);
+  export_btn_->setEnabled(false);
+  status_ = new QLabel(this);
+  button_row->addWidget(start_btn_);
+  button_row->addWidget(cancel_btn_);
+  button_row->addWidget(status_, 1);
+  button_row->addWidget(export_btn_);
+  layout->addLayout(button_row);
+
+  results_ = new QTableWidget(0, 0, this);
+  results_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  results_->setSelectionBehavior(QAbstractItemView::SelectRows);
+  results_->verticalHeader()->setVisible(false);
+  layout->addWidget(results_, 1);
+
+  connect(add_btn, &QPushButton::clicked, this, &SweepDialog::on_add_factor);
+  connect(values_, &QLineEdit::returnPressed, this,
+          &SweepDialog::on_add_factor);
+  connect(remove_btn, &QPushButton::clicked, this,
+          &SweepDialog::on_remove_factor);
+  connect(dir_btn, &QPushButton::clicked, this, &SweepDialog::on_pick_dir);
+  connect(export_btn_, &QPushButton::clicked, this,
+          &SweepDialog::on_export_csv);
+  connect(start_btn_, &QPushButton::clicked, this,
+          &SweepDialog::start_requested);
+  connect(cancel_btn_, &QPushButton::clicked, this,
+          &SweepDialog::cancel_requested);
+}
+
+void SweepDialog::set_targets(const QStringList& targets) {
+  const QString current = target_->currentText();
+  target_->clear();
+  target_->addItems(targets);
+  target_->setCurrentText(current);
+}
+
+void SweepDialog::set_default_dir(const QString& dir) {
+  // A directory the user typed or picked stays; an earlier default does not.
+  if (dir_->text().isEmpty() || dir_->text() == default_dir_) {
+    dir_->setText(dir);
+  }
+  default_dir_ = dir;
+}
+
+void SweepDialog::set_output_dir(const QString& dir) {
+  dir_->setText(dir);
+}
+
+std::vector<SweepFactor> SweepDialog::factors(QString* error) const {
+  std::vector<SweepFactor> out;
+  for (int row = 0; row < factor_table_->rowCount(); ++row) {
+    const QTableWidgetItem* target = factor_table_->item(row, 0);
+    const QTableWidgetItem* values = factor_table_->item(row, 1);
+    SweepFactor factor;
+    factor.target = target ? target->text().trimmed() : QString();
+    QString parse_error;
+    factor.values =
+        ParseSweepValues(values ? values->text() : QString(), &parse_error);
+    if (factor.target.isEmpty() || factor.values.isEmpty()) {
+      if (error) {
+        *error = QString("Row %1: %2")
+                     .arg(row + 1)
+                     .arg(factor.target.isEmpty() ? QString("no parameter")
+                                                  : parse_error);
+      }
+      return {};
+    }
+    out.push_back(factor);
+  }
+  return out;
+}
+
+SweepDesign SweepDialog::design() const {
+  return design_->currentIndex() == 1 ? SweepDesign::Paired
+                                      : SweepDesign::FullFactorial;
+}
+
+int SweepDialog::max_parallel() const {
+  return max_parallel_->value();
+}
+
+QStringList SweepDialog::globals() const {
+  static const QRegularExpression separators("[,\\s]+");
+  return globals_->text().split(separators, Qt::SkipEmptyParts);
+}
+
+QString SweepDialog::output_dir() const {
+  return dir_->text().trimmed();
+}
+
+void SweepDialog::show_cases(const std::vector<SweepFactor>& factors,
+                             const QStringList& globals,
+                             const std::vector<SweepCase>& cases) {
+  shown_factors_ = factors;
+  shown_globals_ = globals;
+  cases_ = cases;
+  QStringList headers{"Case"};
+  for (const SweepFactor& f : factors) {
+    headers << f.target;
+  }
+  headers << "Status" << "Job";
+  headers.append(globals);
+  headers << "Exodus";
+  results_->clear();
+  results_->setColumnCount(headers.size());
+  results_->setHorizontalHeaderLabels(headers);
+  results_->setRowCount(static_cast<int>(cases.size()));
+  for (const SweepCase& c : cases) {
+    update_case(c);
+  }
+  export_btn_->setEnabled(!cases.empty());
+}
+
+void SweepDialog::update_case(const SweepCase& c) {
+  const int row = c.index - 1;
+  if (row < 0 || row >= results_->rowCount()) {
+    return;
+  }
+  cases_[static_cast<std::size_t>(row)] = c;
+  QStringList cells{QString::number(c.index)};
+  cells.append(c.values);
+  cells << c.status << (c.job_id > 0 ? QString::number(c.job_id) : QString());
+  for (const QString& name : shown_globals_) {
+    bool ok = false;
+    const double value = c.results.value(name).toDouble(&ok);
+    cells << (ok && std::isfinite(value) ? QString::number(value, 'g', 8)
+                                         : QString());
+  }
+  cells << QFileInfo(c.exodus).fileName();
+  for (int col = 0; col < cells.size() && col < results_->columnCount(); ++col) {
+    QTableWidgetItem* item = results_->item(row, col);
+    if (!item) {
+      item = new QTableWidgetItem();
+      results_->setItem(row, col, item);
+    }
+    item->setText(cells[col]);
+  }
+  if (QTableWidgetItem* exodus = results_->item(row, static_cast<int>(cells.size()) - 1)) {
+    exodus->setToolTip(c.exodus);
+  }
+}
+
+void SweepDialog::set_status(const QString& text) {
+  status_->setText(text);
+}
+
+void SweepDialog::set_running(bool running) {
+  start_btn_->setEnabled(!running);
+  cancel_btn_->setEnabled(running);
+  factor_table_->setEnabled(!running);
+}
+
+void SweepDialog::on_add_factor() {
+  const QString target = target_->currentText().trimmed();
+  const QString values = values_->text().trimmed();
+  if (target.isEmpty() || values.isEmpty()) {
+    return;
+  }
+  // One row per parameter; adding it again replaces its values.
+  int row = 0;
+  while (row < factor_table_->rowCount() &&
+         (!factor_table_->item(row, 0) ||
+          factor_table_->item(row, 0)->text() != target)) {
+    ++row;
+  }
+  if (row == factor_table_->rowCount()) {
+    factor_table_->insertRow(row);
+    factor_table_->setItem(row, 0, new QTableWidgetItem(target));
+  }
+  factor_table_->setItem(row, 1, new QTableWidgetItem(values));
+  values_->clear();
+}
+
+void SweepDialog::on_remove_factor() {
+  const QList<QTableWidgetSelectionRange> ranges =
+      factor_table_->selectedRanges();
+  for (auto it = ranges.rbegin(); it != ranges.rend(); ++it) {
+    for (int row = it->bottomRow(); row >= it->topRow(); --row) {
+      factor_table_->removeRow(row);
+    }
+  }
+}
+
+void SweepDialog::on_pick_dir() {
+  const QString dir =
+      QFileDialog::getExistingDirectory(this, "Sweep Output Directory",
+                                        dir_->text());
+  if (!dir.isEmpty()) {
+    dir_->setText(dir);
+  }
+}
+
+void SweepDialog::on_export_csv() {
+  const QString start =
+      output_dir().isEmpty() ? QString() : output_dir() + "/sweep_results.csv";
+  const QString path = QFileDialog::getSaveFileName(
+      this, "Export Sweep Results", start, "CSV (*.csv)");
+  if (path.isEmpty()) {
+    return;
+  }
+  QString error;
+  if (WriteSweepCsv(path, shown_factors_, shown_globals_, cases_, &error)) {
+    set_status("Results written to " + path);
+  } else {
+    set_status("Export failed: " + error);
+  }
+}
+
+}  // namespace gmp
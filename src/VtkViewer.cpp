@@ -10,24 +10,38 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QListWidget>
-#include <QPlainTextEdit>
 #include <QPushButton>
 #include <QSpinBox>
 #include <QSlider>
 #include <QSplitter>
 #include <QTabWidget>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
+#include <QElapsedTimer>
+#include <QThread>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QStringList>
 #include <QtCore/Qt>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <unordered_map>
 
+#include "gmp/ArrayStats.h"
+#include "gmp/ArrayTableModel.h"
 #include "gmp/ComboPopupFix.h"
+#include "gmp/ExodusStepCache.h"
+#include "gmp/ExodusTimeHistory.h"
+#include "gmp/FrameExporter.h"
+#include "gmp/MshReader.h"
+#include "gmp/PlotWidget.h"
 
 #ifdef GMP_ENABLE_VTK_VIEWER
 #include <QVTKOpenGLNativeWidget.h>
@@ -37,6 +51,7 @@
 #include <vtkDataArray.h>
 #include <vtkDataObject.h>
 #include <vtkDataSet.h>
+#include <vtkDataSetAttributes.h>
 #include <vtkDataSetSurfaceFilter.h>
 #include <vtkDataSetMapper.h>
 #include <vtkExodusIIReader.h>
@@ -51,18 +66,30 @@
 #include <vtkPlane.h>
 #include <vtkCutter.h>
 #include <vtkShrinkFilter.h>
-#include <vtkThreshold.h>
+#include <vtkStaticCellLocator.h>
+#include <vtkStaticPointLocator.h>
+#include <vtkExtractCells.h>
+#include <vtkIdList.h>
 #include <vtkProperty.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataMapper.h>
+#include <vtkPointDataToCellData.h>
+#include <vtkQuadricClustering.h>
 #include <vtkIntArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkCellArray.h>
+#include <vtkSMPTools.h>
 #include <vtkUnstructuredGrid.h>
 #include <vtkPoints.h>
 #include <vtkCellType.h>
 #include <vtkVertexGlyphFilter.h>
 #include <vtkRenderer.h>
 #include <vtkScalarBarActor.h>
+#include <vtkTextActor.h>
+#include <vtkTextProperty.h>
 #include <vtkWindowToImageFilter.h>
 #include <vtkPNGWriter.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
@@ -71,6 +98,7 @@
 #include <vtkRenderWindowInteractor.h>
 #include <vtkInteractorStyle.h>
 #include <vtkCommand.h>
+#include <vtkVersionMacros.h>
 #endif
 
 #ifdef GMP_ENABLE_GMSH_GUI
@@ -82,65 +110,6 @@ namespace gmp {
 #ifdef GMP_ENABLE_VTK_VIEWER
 namespace {
 
-struct VectorStats {
-  bool has_data = false;
-  int components = 0;
-  vtkIdType tuples = 0;
-  double min_mag = 0.0;
-  double max_mag = 0.0;
-  double mean_mag = 0.0;
-  double rms_mag = 0.0;
-};
-
-double ComputeMagnitude(vtkDataArray* arr, vtkIdType idx) {
-  if (!arr || idx < 0 || idx >= arr->GetNumberOfTuples()) {
-    return 0.0;
-  }
-  const int comps = arr->GetNumberOfComponents();
-  double sum_sq = 0.0;
-  for (int c = 0; c < comps; ++c) {
-    const double v = arr->GetComponent(idx, c);
-    sum_sq += v * v;
-  }
-  return std::sqrt(sum_sq);
-}
-
-VectorStats AnalyzeVectorArray(vtkDataArray* arr) {
-  VectorStats stats;
-  if (!arr) {
-    return stats;
-  }
-  const int comps = arr->GetNumberOfComponents();
-  if (comps < 2) {
-    return stats;
-  }
-  const vtkIdType tuples = arr->GetNumberOfTuples();
-  if (tuples <= 0) {
-    return stats;
-  }
-
-  stats.has_data = true;
-  stats.components = comps;
-  stats.tuples = tuples;
-
-  double min_mag = std::numeric_limits<double>::infinity();
-  double max_mag = -std::numeric_limits<double>::infinity();
-  double sum_mag = 0.0;
-  double sum_sq = 0.0;
-  for (vtkIdType i = 0; i < tuples; ++i) {
-    const double m = ComputeMagnitude(arr, i);
-    min_mag = std::min(min_mag, m);
-    max_mag = std::max(max_mag, m);
-    sum_mag += m;
-    sum_sq += m * m;
-  }
-  stats.min_mag = min_mag;
-  stats.max_mag = max_mag;
-  stats.mean_mag = sum_mag / static_cast<double>(tuples);
-  stats.rms_mag = std::sqrt(sum_sq / static_cast<double>(tuples));
-  return stats;
-}
-
 QString ArrayValueSample(vtkDataArray* arr, vtkIdType idx) {
   if (!arr || idx < 0 || idx >= arr->GetNumberOfTuples()) {
     return "n/a";
@@ -157,8 +126,8 @@ QString ArrayValueSample(vtkDataArray* arr, vtkIdType idx) {
   return QString("(%1)").arg(parts.join(", "));
 }
 
-QString FormatVectorStatsText(const VectorStats& stats) {
-  if (!stats.has_data) {
+QString FormatVectorStatsText(const ArrayStats& stats) {
+  if (!stats.has_data || stats.components < 2) {
     return "No compatible vector data";
   }
   return QString(
@@ -218,19 +187,111 @@ QString ElementTypeLabel(int element_type) {
   } catch (...) {
   }
 #endif
+  MshElementType info;
+  if (LookupMshElementType(element_type, &info)) {
+    return QString::fromUtf8(info.name);
+  }
   return QString("Type %1").arg(element_type);
 }
 
+// Maps gmsh node tags to VTK point ids. Gmsh tags are usually dense, so a
+// flat table is used whenever it stays within a small factor of the node
+// count; very sparse numberings fall back to a hash map.
+class NodeIndex {
+ public:
+  explicit NodeIndex(const std::vector<std::size_t>& tags) {
+    std::size_t max_tag = 0;
+    for (const auto t : tags) {
+      max_tag = std::max(max_tag, t);
+    }
+    if (max_tag <= 4 * tags.size() + 1024) {
+      dense_.assign(max_tag + 1, 0);
+      for (size_t i = 0; i < tags.size(); ++i) {
+        dense_[tags[i]] = static_cast<vtkIdType>(i);
+      }
+    } else {
+      sparse_.reserve(tags.size());
+      for (size_t i = 0; i < tags.size(); ++i) {
+        sparse_[tags[i]] = static_cast<vtkIdType>(i);
+      }
+    }
+  }
+
+  vtkIdType lookup(std::size_t tag) const {
+    if (!dense_.empty()) {
+      return tag < dense_.size() ? dense_[tag] : 0;
+    }
+    const auto it = sparse_.find(tag);
+    return it == sparse_.end() ? 0 : it->second;
+  }
+
+ private:
+  std::vector<vtkIdType> dense_;
+  std::unordered_map<std::size_t, vtkIdType> sparse_;
+};
+
 #ifdef GMP_ENABLE_GMSH_GUI
+struct GridBuildTimings {
+  double open_ms = 0.0;
+  double nodes_ms = 0.0;
+  double topology_ms = 0.0;
+  double elements_ms = 0.0;
+  double fill_ms = 0.0;
+  double assemble_ms = 0.0;
+  vtkIdType cells = 0;
+  vtkIdType points = 0;
+  size_t blocks = 0;
+
+  QString summary() const {
+    return QString("Mesh preview: points=%1 cells=%2 blocks=%3 | open=%4ms "
+                   "nodes=%5ms topology=%6ms elements=%7ms fill=%8ms "
+                   "assemble=%9ms")
+        .arg(points)
+        .arg(cells)
+        .arg(blocks)
+        .arg(open_ms, 0, 'f', 1)
+        .arg(nodes_ms, 0, 'f', 1)
+        .arg(topology_ms, 0, 'f', 1)
+        .arg(elements_ms, 0, 'f', 1)
+        .arg(fill_ms, 0, 'f', 1)
+        .arg(assemble_ms, 0, 'f', 1);
+  }
+};
+
+struct ElementBlock {
+  int elem_type = 0;
+  int cell_type = VTK_EMPTY_CELL;
+  int num_nodes = 0;
+  int num_primary = 0;
+  int ent_dim = 0;
+  int ent_tag = 0;
+  int phys_dim = 0;
+  int phys_id = 0;
+  std::vector<std::size_t> tags;
+  std::vector<std::size_t> nodes;
+  vtkIdType first_cell = 0;
+  vtkIdType first_conn = 0;
+};
+
 vtkSmartPointer<vtkUnstructuredGrid> BuildGridFromGmsh(
-    const QString& path) {
+    const QString& path, GridBuildTimings* timings) {
+  GridBuildTimings local_timings;
+  GridBuildTimings& t = timings ? *timings : local_timings;
+  QElapsedTimer phase;
+  auto lap = [&phase]() {
+    const double ms = static_cast<double>(phase.nsecsElapsed()) / 1.0e6;
+    phase.restart();
+    return ms;
+  };
   try {
+    phase.start();
     if (!gmsh::isInitialized()) {
       gmsh::initialize(0, nullptr, false, false);
     }
     gmsh::option::setNumber("General.Terminal", 0);
     gmsh::clear();
     gmsh::open(path.toStdString());
+    t.open_ms = lap();
 
     std::vector<std::size_t> node_tags;
     std::vector<double> coords;
@@ -240,138 +301,177 @@ vtkSmartPointer<vtkUnstructuredGrid> BuildGridFromGmsh(
       return nullptr;
     }
 
+    const vtkIdType n_points = static_cast<vtkIdType>(node_tags.size());
     auto points = vtkSmartPointer<vtkPoints>::New();
-    points->SetNumberOfPoints(static_cast<vtkIdType>(node_tags.size()));
-    std::unordered_map<std::size_t, vtkIdType> id_map;
-    id_map.reserve(node_tags.size());
+    points->SetDataTypeToDouble();
+    points->SetNumberOfPoints(n_points);
+    auto* point_data =
+        vtkDoubleArray::SafeDownCast(points->GetData())->GetPointer(0);
+    std::copy(coords.begin(), coords.begin() + 3 * n_points, point_data);
 
     auto node_tags_arr = vtkSmartPointer<vtkIntArray>::New();
     node_tags_arr->SetName("node_tag");
-    node_tags_arr->SetNumberOfValues(
-        static_cast<vtkIdType>(node_tags.size()));
-    for (size_t i = 0; i < node_tags.size(); ++i) {
-      id_map[node_tags[i]] = static_cast<vtkIdType>(i);
-      points->SetPoint(static_cast<vtkIdType>(i), coords[3 * i],
-                       coords[3 * i + 1], coords[3 * i + 2]);
-      node_tags_arr->SetValue(static_cast<vtkIdType>(i),
-                              static_cast<int>(node_tags[i]));
-    }
-
-    auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    grid->SetPoints(points);
-    grid->GetPointData()->AddArray(node_tags_arr);
-
-    std::unordered_map<std::size_t, int> elem_phys;
-    std::unordered_map<std::size_t, int> elem_phys_dim;
-    std::unordered_map<std::size_t, int> elem_ent_tag;
-    std::unordered_map<std::size_t, int> elem_ent_dim;
+    node_tags_arr->SetNumberOfValues(n_points);
+    int* node_tag_ptr = node_tags_arr->GetPointer(0);
+    for (vtkIdType i = 0; i < n_points; ++i) {
+      node_tag_ptr[i] = static_cast<int>(node_tags[static_cast<size_t>(i)]);
+    }
+    const NodeIndex node_index(node_tags);
+    t.points = n_points;
+    t.nodes_ms = lap();
+
+    // Physical membership is resolved per entity, so every element simply
+    // inherits the tags of the block it was fetched with.
+    std::map<std::pair<int, int>, std::pair<int, int>> entity_phys;
     std::vector<std::pair<int, int>> phys_groups;
     gmsh::model::getPhysicalGroups(phys_groups);
     for (const auto& pg : phys_groups) {
       std::vector<int> entities;
       gmsh::model::getEntitiesForPhysicalGroup(pg.first, pg.second, entities);
       for (const auto ent : entities) {
-        std::vector<int> etypes;
-        std::vector<std::vector<std::size_t>> etags;
-        std::vector<std::vector<std::size_t>> enodes;
-        gmsh::model::mesh::getElements(etypes, etags, enodes, pg.first, ent);
-        for (const auto& list : etags) {
-          for (const auto tag : list) {
-            elem_phys[tag] = pg.second;
-            elem_phys_dim[tag] = pg.first;
-          }
-        }
+        entity_phys[{pg.first, ent}] = {pg.first, pg.second};
       }
     }
-
     std::vector<std::pair<int, int>> entities;
     gmsh::model::getEntities(entities);
-    for (const auto& ent : entities) {
-      std::vector<int> etypes;
-      std::vector<std::vector<std::size_t>> etags;
-      std::vector<std::vector<std::size_t>> enodes;
-      gmsh::model::mesh::getElements(etypes, etags, enodes, ent.first, ent.second);
-      for (const auto& list : etags) {
-        for (const auto tag : list) {
-          elem_ent_tag[tag] = ent.second;
-          elem_ent_dim[tag] = ent.first;
-        }
-      }
-    }
+    t.topology_ms = lap();
 
-    auto phys_id_arr = vtkSmartPointer<vtkIntArray>::New();
-    phys_id_arr->SetName("phys_id");
-    auto phys_dim_arr = vtkSmartPointer<vtkIntArray>::New();
-    phys_dim_arr->SetName("phys_dim");
-    auto elem_type_arr = vtkSmartPointer<vtkIntArray>::New();
-    elem_type_arr->SetName("elem_type");
-    auto elem_tag_arr = vtkSmartPointer<vtkIntArray>::New();
-    elem_tag_arr->SetName("elem_tag");
-    auto cell_id_arr = vtkSmartPointer<vtkIntArray>::New();
-    cell_id_arr->SetName("cell_id");
-    auto ent_dim_arr = vtkSmartPointer<vtkIntArray>::New();
-    ent_dim_arr->SetName("entity_dim");
-    auto ent_tag_arr = vtkSmartPointer<vtkIntArray>::New();
-    ent_tag_arr->SetName("entity_tag");
-
-    std::vector<int> element_types;
-    std::vector<std::vector<std::size_t>> element_tags;
-    std::vector<std::vector<std::size_t>> element_node_tags;
-    gmsh::model::mesh::getElements(element_types, element_tags,
-                                   element_node_tags);
-
-    int cell_index = 0;
-    for (size_t k = 0; k < element_types.size(); ++k) {
+    struct TypeInfo {
       int dim = 0;
-      int order = 0;
       int num_nodes = 0;
       int num_primary = 0;
+    };
+    std::map<int, TypeInfo> type_info;
+    auto info_for = [&type_info](int elem_type) -> const TypeInfo& {
+      auto it = type_info.find(elem_type);
+      if (it != type_info.end()) {
+        return it->second;
+      }
+      TypeInfo info;
+      int order = 0;
       std::string name;
       std::vector<double> local;
-      gmsh::model::mesh::getElementProperties(element_types[k], name, dim,
-                                              order, num_nodes, local,
-                                              num_primary);
-      if (num_nodes <= 0 || num_primary <= 0) {
-        continue;
-      }
-      const int cell_type = VtkCellFromDimAndNodes(dim, num_primary);
-      if (cell_type == VTK_EMPTY_CELL) {
-        continue;
-      }
-
-      const auto& nodes = element_node_tags[k];
-      const size_t elem_count = nodes.size() / static_cast<size_t>(num_nodes);
-      std::vector<vtkIdType> ids(static_cast<size_t>(num_primary));
-      for (size_t e = 0; e < elem_count; ++e) {
-        const size_t base = e * static_cast<size_t>(num_nodes);
-        for (int j = 0; j < num_primary; ++j) {
-          const std::size_t tag = nodes[base + static_cast<size_t>(j)];
-          auto it = id_map.find(tag);
-          ids[static_cast<size_t>(j)] =
-              it == id_map.end() ? 0 : it->second;
+      gmsh::model::mesh::getElementProperties(elem_type, name, info.dim, order,
+                                              info.num_nodes, local,
+                                              info.num_primary);
+      return type_info.emplace(elem_type, info).first->second;
+    };
+
+    std::vector<ElementBlock> blocks;
+    vtkIdType total_cells = 0;
+    vtkIdType total_conn = 0;
+    for (const auto& ent : entities) {
+      std::vector<int> etypes;
+      std::vector<std::vector<std::size_t>> etags;
+      std::vector<std::vector<std::size_t>> enodes;
+      gmsh::model::mesh::getElements(etypes, etags, enodes, ent.first,
+                                     ent.second);
+      const auto phys_it = entity_phys.find(ent);
+      for (size_t k = 0; k < etypes.size(); ++k) {
+        const TypeInfo& info = info_for(etypes[k]);
+        if (info.num_nodes <= 0 || info.num_primary <= 0) {
+          continue;
+        }
+        const int cell_type = VtkCellFromDimAndNodes(info.dim, info.num_primary);
+        if (cell_type == VTK_EMPTY_CELL) {
+          continue;
         }
-        grid->InsertNextCell(cell_type, num_primary, ids.data());
-        const std::size_t elem_tag = element_tags[k][e];
-        const auto phys_it = elem_phys.find(elem_tag);
-        const int phys_id =
-            phys_it == elem_phys.end() ? 0 : phys_it->second;
-        const int phys_dim =
-            phys_it == elem_phys.end() ? dim : elem_phys_dim[elem_tag];
-        const auto ent_it = elem_ent_tag.find(elem_tag);
-        const int ent_tag = ent_it == elem_ent_tag.end() ? 0 : ent_it->second;
-        const int ent_dim =
-            ent_it == elem_ent_tag.end() ? dim : elem_ent_dim[elem_tag];
-        phys_id_arr->InsertNextValue(phys_id);
-        phys_dim_arr->InsertNextValue(phys_dim);
-        elem_type_arr->InsertNextValue(element_types[k]);
-        elem_tag_arr->InsertNextValue(static_cast<int>(elem_tag));
-        cell_id_arr->InsertNextValue(cell_index);
-        ent_dim_arr->InsertNextValue(ent_dim);
-        ent_tag_arr->InsertNextValue(ent_tag);
-        ++cell_index;
+        ElementBlock block;
+        block.elem_type = etypes[k];
+        block.cell_type = cell_type;
+        block.num_nodes = info.num_nodes;
+        block.num_primary = info.num_primary;
+        block.ent_dim = ent.first;
+        block.ent_tag = ent.second;
+        block.phys_dim =
+            phys_it == entity_phys.end() ? info.dim : phys_it->second.first;
+        block.phys_id = phys_it == entity_phys.end() ? 0 : phys_it->second.second;
+        block.tags = std::move(etags[k]);
+        block.nodes = std::move(enodes[k]);
+        const vtkIdType count = static_cast<vtkIdType>(
+            block.nodes.size() / static_cast<size_t>(info.num_nodes));
+        block.first_cell = total_cells;
+        block.first_conn = total_conn;
+        total_cells += count;
+        total_conn += count * info.num_primary;
+        blocks.push_back(std::move(block));
       }
     }
+    t.cells = total_cells;
+    t.blocks = blocks.size();
+    t.elements_ms = lap();
+
+    auto offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets->SetNumberOfValues(total_cells + 1);
+    auto connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity->SetNumberOfValues(total_conn);
+    auto cell_types = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    cell_types->SetNumberOfValues(total_cells);
+
+    auto make_cell_array = [total_cells](const char* name) {
+      auto arr = vtkSmartPointer<vtkIntArray>::New();
+      arr->SetName(name);
+      arr->SetNumberOfValues(total_cells);
+      return arr;
+    };
+    auto phys_id_arr = make_cell_array("phys_id");
+    auto phys_dim_arr = make_cell_array("phys_dim");
+    auto elem_type_arr = make_cell_array("elem_type");
+    auto elem_tag_arr = make_cell_array("elem_tag");
+    auto cell_id_arr = make_cell_array("cell_id");
+    auto ent_dim_arr = make_cell_array("entity_dim");
+    auto ent_tag_arr = make_cell_array("entity_tag");
+
+    vtkIdType* offset_ptr = offsets->GetPointer(0);
+    vtkIdType* conn_ptr = connectivity->GetPointer(0);
+    unsigned char* type_ptr = cell_types->GetPointer(0);
+    int* phys_id_ptr = phys_id_arr->GetPointer(0);
+    int* phys_dim_ptr = phys_dim_arr->GetPointer(0);
+    int* elem_type_ptr = elem_type_arr->GetPointer(0);
+    int* elem_tag_ptr = elem_tag_arr->GetPointer(0);
+    int* cell_id_ptr = cell_id_arr->GetPointer(0);
+    int* ent_dim_ptr = ent_dim_arr->GetPointer(0);
+    int* ent_tag_ptr = ent_tag_arr->GetPointer(0);
+    offset_ptr[total_cells] = total_conn;
+
+    // Every block owns a disjoint [first_cell, first_cell + count) range of
+    // the preallocated arrays, so blocks can be written concurrently.
+    auto fill_blocks = [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType b = begin; b < end; ++b) {
+        const ElementBlock& block = blocks[static_cast<size_t>(b)];
+        const size_t stride = static_cast<size_t>(block.num_nodes);
+        const vtkIdType count =
+            static_cast<vtkIdType>(block.nodes.size() / stride);
+        for (vtkIdType e = 0; e < count; ++e) {
+          const vtkIdType cell = block.first_cell + e;
+          const vtkIdType conn = block.first_conn + e * block.num_primary;
+          const size_t base = static_cast<size_t>(e) * stride;
+          for (int j = 0; j < block.num_primary; ++j) {
+            conn_ptr[conn + j] =
+                node_index.lookup(block.nodes[base + static_cast<size_t>(j)]);
+          }
+          offset_ptr[cell] = conn;
+          type_ptr[cell] = static_cast<unsigned char>(block.cell_type);
+          phys_id_ptr[cell] = block.phys_id;
+          phys_dim_ptr[cell] = block.phys_dim;
+          elem_type_ptr[cell] = block.elem_type;
+          elem_tag_ptr[cell] =
+              static_cast<int>(block.tags[static_cast<size_t>(e)]);
+          cell_id_ptr[cell] = static_cast<int>(cell);
+          ent_dim_ptr[cell] = block.ent_dim;
+          ent_tag_ptr[cell] = block.ent_tag;
+        }
+      }
+    };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), fill_blocks);
+    t.fill_ms = lap();
 
+    auto cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetData(offsets, connectivity);
+    auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    grid->SetPoints(points);
+    grid->SetCells(cell_types, cells);
+    grid->GetPointData()->AddArray(node_tags_arr);
     grid->GetCellData()->AddArray(phys_id_arr);
     grid->GetCellData()->AddArray(phys_dim_arr);
     grid->GetCellData()->AddArray(elem_type_arr);
@@ -380,6 +480,7 @@ vtkSmartPointer<vtkUnstructuredGrid> BuildGridFromGmsh(
     grid->GetCellData()->AddArray(ent_dim_arr);
     grid->GetCellData()->AddArray(ent_tag_arr);
     grid->GetCellData()->SetScalars(phys_id_arr);
+    t.assemble_ms = lap();
 
     return grid;
   } catch (...) {
@@ -388,10 +489,388 @@ vtkSmartPointer<vtkUnstructuredGrid> BuildGridFromGmsh(
 }
 #endif
 
+// Builds the preview grid straight from MshReader callbacks. Cell arrays are
+// sized from the declared element count; each element block is converted in
+// parallel as it streams in.
+class MshGridSink : public MshVisitor {
+ public:
+  MshGridSink() {
+    points_ = vtkSmartPointer<vtkPoints>::New();
+    points_->SetDataTypeToDouble();
+    node_tag_arr_ = vtkSmartPointer<vtkIntArray>::New();
+    node_tag_arr_->SetName("node_tag");
+    offsets_ = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity_ = vtkSmartPointer<vtkIdTypeArray>::New();
+    cell_types_ = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    const char* names[] = {"phys_id",  "phys_dim", "elem_type", "elem_tag",
+                           "cell_id",  "entity_dim", "entity_tag"};
+    for (int i = 0; i < kCellArrays; ++i) {
+      cell_arrays_[i] = vtkSmartPointer<vtkIntArray>::New();
+      cell_arrays_[i]->SetName(names[i]);
+    }
+  }
+
+  void physical_name(int dim, int tag, const QString& name) override {
+    names_[{dim, tag}] = name;
+  }
+
+  void entity(int dim, int tag, const std::vector<int>& phys_tags) override {
+    entities_.insert({dim, tag});
+    for (const int p : phys_tags) {
+      groups_.insert({dim, p});
+    }
+  }
+
+  void nodes_begin(std::size_t total) override {
+    points_->SetNumberOfPoints(static_cast<vtkIdType>(total));
+    node_tag_arr_->SetNumberOfValues(static_cast<vtkIdType>(total));
+    node_tags_.reserve(total);
+  }
+
+  void node_block(const std::size_t* tags, const double* xyz,
+                  std::size_t count) override {
+    const vtkIdType needed = n_points_ + static_cast<vtkIdType>(count);
+    if (needed > points_->GetNumberOfPoints()) {
+      points_->Resize(needed);
+      points_->SetNumberOfPoints(needed);
+      node_tag_arr_->SetNumberOfValues(needed);
+    }
+    double* dst =
+        vtkDoubleArray::SafeDownCast(points_->GetData())->GetPointer(0);
+    std::copy(xyz, xyz + 3 * count, dst + 3 * n_points_);
+    int* tag_dst = node_tag_arr_->GetPointer(0);
+    for (std::size_t i = 0; i < count; ++i) {
+      tag_dst[n_points_ + static_cast<vtkIdType>(i)] = static_cast<int>(tags[i]);
+    }
+    node_tags_.insert(node_tags_.end(), tags, tags + count);
+    n_points_ = needed;
+  }
+
+  void elements_begin(std::size_t total) override {
+    node_index_ = std::make_unique<NodeIndex>(node_tags_);
+    const vtkIdType cells = static_cast<vtkIdType>(total);
+    offsets_->SetNumberOfValues(cells + 1);
+    cell_types_->SetNumberOfValues(cells);
+    connectivity_->Allocate(cells * 4);
+    for (auto& arr : cell_arrays_) {
+      arr->SetNumberOfValues(cells);
+    }
+  }
+
+  void element_block(const MshElementBlock& block) override {
+    const int cell_type =
+        VtkCellFromDimAndNodes(block.type.dim, block.type.num_primary);
+    elem_types_.insert(block.type.type);
+    entities_.insert({block.entity_dim, block.entity_tag});
+    if (block.phys_id != 0) {
+      groups_.insert({block.entity_dim, block.phys_id});
+    }
+    if (cell_type == VTK_EMPTY_CELL || block.count == 0) {
+      return;
+    }
+    const vtkIdType count = static_cast<vtkIdType>(block.count);
+    const vtkIdType first_cell = n_cells_;
+    const vtkIdType first_conn = n_conn_;
+    const int primary = block.type.num_primary;
+    const size_t stride = static_cast<size_t>(block.type.num_nodes);
+    if (first_cell + count > cell_types_->GetNumberOfValues()) {
+      offsets_->Resize(first_cell + count + 1);
+      offsets_->SetNumberOfValues(first_cell + count + 1);
+      cell_types_->Resize(first_cell + count);
+      cell_types_->SetNumberOfValues(first_cell + count);
+      for (auto& arr : cell_arrays_) {
+        arr->Resize(first_cell + count);
+        arr->SetNumberOfValues(first_cell + count);
+      }
+    }
+    connectivity_->SetNumberOfValues(first_conn + count * primary);
+
+    vtkIdType* offset_ptr = offsets_->GetPointer(0);
+    vtkIdType* conn_ptr = connectivity_->GetPointer(0);
+    unsigned char* type_ptr = cell_types_->GetPointer(0);
+    int* arr_ptr[kCellArrays];
+    for (int i = 0; i < kCellArrays; ++i) {
+      arr_ptr[i] = cell_arrays_[i]->GetPointer(0);
+    }
+    const NodeIndex& index = *node_index_;
+    auto fill = [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType e = begin; e < end; ++e) {
+        const vtkIdType cell = first_cell + e;
+        const vtkIdType conn = first_conn + e * primary;
+        const size_t base = static_cast<size_t>(e) * stride;
+        for (int j = 0; j < primary; ++j) {
+          conn_ptr[conn + j] =
+              index.lookup(block.nodes[base + static_cast<size_t>(j)]);
+        }
+        offset_ptr[cell] = conn;
+        type_ptr[cell] = static_cast<unsigned char>(cell_type);
+        arr_ptr[0][cell] = block.phys_id;
+        arr_ptr[1][cell] = block.entity_dim;
+        arr_ptr[2][cell] = block.type.type;
+        arr_ptr[3][cell] = static_cast<int>(block.tags[e]);
+        arr_ptr[4][cell] = static_cast<int>(cell);
+        arr_ptr[5][cell] = block.entity_dim;
+        arr_ptr[6][cell] = block.entity_tag;
+      }
+    };
+    vtkSMPTools::For(0, count, fill);
+    n_cells_ += count;
+    n_conn_ += count * primary;
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> finish() {
+    if (n_points_ == 0) {
+      return nullptr;
+    }
+    points_->SetNumberOfPoints(n_points_);
+    node_tag_arr_->SetNumberOfValues(n_points_);
+    offsets_->SetNumberOfValues(n_cells_ + 1);
+    offsets_->SetValue(n_cells_, n_conn_);
+    cell_types_->SetNumberOfValues(n_cells_);
+    connectivity_->SetNumberOfValues(n_conn_);
+    connectivity_->Squeeze();
+    auto cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetData(offsets_, connectivity_);
+    auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    grid->SetPoints(points_);
+    grid->SetCells(cell_types_, cells);
+    grid->GetPointData()->AddArray(node_tag_arr_);
+    for (auto& arr : cell_arrays_) {
+      arr->SetNumberOfValues(n_cells_);
+      grid->GetCellData()->AddArray(arr);
+    }
+    grid->GetCellData()->SetScalars(cell_arrays_[0]);
+    return grid;
+  }
+
+  vtkIdType cell_count() const { return n_cells_; }
+  vtkIdType point_count() const { return n_points_; }
+  const std::set<std::pair<int, int>>& groups() const { return groups_; }
+  const std::set<std::pair<int, int>>& entities() const { return entities_; }
+  const std::set<int>& element_types() const { return elem_types_; }
+  QString group_name(int dim, int tag) const {
+    const auto it = names_.find({dim, tag});
+    return it == names_.end() ? QString() : it->second;
+  }
+
+ private:
+  static constexpr int kCellArrays = 7;
+
+  vtkSmartPointer<vtkPoints> points_;
+  vtkSmartPointer<vtkIntArray> node_tag_arr_;
+  vtkSmartPointer<vtkIdTypeArray> offsets_;
+  vtkSmartPointer<vtkIdTypeArray> connectivity_;
+  vtkSmartPointer<vtkUnsignedCharArray> cell_types_;
+  vtkSmartPointer<vtkIntArray> cell_arrays_[kCellArrays];
+  std::vector<std::size_t> node_tags_;
+  std::unique_ptr<NodeIndex> node_index_;
+  vtkIdType n_points_ = 0;
+  vtkIdType n_cells_ = 0;
+  vtkIdType n_conn_ = 0;
+  std::map<std::pair<int, int>, QString> names_;
+  std::set<std::pair<int, int>> groups_;
+  std::set<std::pair<int, int>> entities_;
+  std::set<int> elem_types_;
+};
+
+QString FormatFaceCount(vtkIdType count) {
+  if (count >= 1000000) {
+    return QString("%1M").arg(static_cast<double>(count) / 1e6, 0, 'f', 1);
+  }
+  if (count >= 10000) {
+    return QString("%1k").arg(static_cast<double>(count) / 1e3, 0, 'f', 0);
+  }
+  return QString::number(count);
+}
+
+// Quadric clustering of `input`'s surface towards each face target, finest
+// first. A level that does not at least halve the previous one is dropped.
+// `point_array` is moved to cell data first because clustering only carries
+// cell attributes. Runs off the GUI thread on a shallow copy.
+std::vector<vtkSmartPointer<vtkPolyData>> BuildLodLevels(
+    vtkDataSet* input, const std::string& point_array,
+    const std::vector<vtkIdType>& targets) {
+  std::vector<vtkSmartPointer<vtkPolyData>> levels;
+  vtkSmartPointer<vtkPolyData> surface = vtkPolyData::SafeDownCast(input);
+  if (!surface) {
+    auto filter = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
+    filter->SetInputData(input);
+    filter->Update();
+    surface = filter->GetOutput();
+  }
+  if (!point_array.empty() &&
+      surface->GetPointData()->GetArray(point_array.c_str())) {
+    auto to_cells = vtkSmartPointer<vtkPointDataToCellData>::New();
+    to_cells->SetInputData(surface);
+    to_cells->ProcessAllArraysOff();
+    to_cells->AddPointDataArray(point_array.c_str());
+    to_cells->PassPointDataOff();
+    to_cells->Update();
+    surface = vtkPolyData::SafeDownCast(to_cells->GetOutput());
+  }
+  if (!surface) {
+    return levels;
+  }
+  vtkIdType previous = surface->GetNumberOfCells();
+  for (vtkIdType target : targets) {
+    // A closed surface in d^3 cubic bins clusters to roughly 12 d^2
+    // triangles.
+    const int divisions = std::clamp(
+        static_cast<int>(std::sqrt(static_cast<double>(target) / 12.0)), 8,
+        2048);
+    auto cluster = vtkSmartPointer<vtkQuadricClustering>::New();
+    cluster->SetInputData(surface);
+    cluster->SetNumberOfDivisions(divisions, divisions, divisions);
+    cluster->AutoAdjustNumberOfDivisionsOn();
+    cluster->CopyCellDataOn();
+    cluster->Update();
+    const vtkIdType faces = cluster->GetOutput()->GetNumberOfCells();
+    if (faces == 0 || faces * 2 > previous) {
+      continue;
+    }
+    auto level = vtkSmartPointer<vtkPolyData>::New();
+    level->ShallowCopy(cluster->GetOutput());
+    levels.push_back(level);
+    previous = faces;
+  }
+  return levels;
+}
+
+// Points `extract` at the cells of `grid` matching `query`, looked up in
+// `index`. The ids come out sorted and unique, so the filter skips its own
+// sort. Returns the number of cells selected.
+vtkIdType ExtractIndexedCells(const MeshSelectionIndex& index,
+                              const MeshSelectionIndex::Query& query,
+                              vtkUnstructuredGrid* grid,
+                              vtkExtractCells* extract) {
+  std::vector<MeshSelectionIndex::CellId> cells;
+  index.select(query, &cells);
+  auto ids = vtkSmartPointer<vtkIdList>::New();
+  ids->SetNumberOfIds(static_cast<vtkIdType>(cells.size()));
+  std::copy(cells.begin(), cells.end(), ids->GetPointer(0));
+  extract->SetInputData(grid);
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 1, 0)
+  extract->AssumeSortedAndUniqueIdsOn();
+#endif
+  extract->SetCellList(ids);
+  return ids->GetNumberOfIds();
+}
+
+constexpr double kSelectColor[3] = {1.0, 0.9, 0.2};
+constexpr double kHoverColor[3] = {0.35, 0.8, 1.0};
+
+// Value of an integer cell array, or -1 when the array is missing.
+int CellArrayValue(vtkDataSet* data, const char* name, vtkIdType cell) {
+  auto* arr = vtkIntArray::SafeDownCast(data->GetCellData()->GetArray(name));
+  if (!arr || cell < 0 || cell >= arr->GetNumberOfTuples()) {
+    return -1;
+  }
+  return arr->GetValue(cell);
+}
+
+// Hides every cell of `overlay` outside `query` through its ghost array. The
+// keys come from the cell arrays the surface carries over from the grid, so
+// nothing is re-extracted; the mapper only rebuilds its index buffer.
+// Returns the number of cells left visible.
+vtkIdType MaskHighlightCells(vtkDataSet* overlay,
+                             const MeshSelectionIndex::Query& query) {
+  auto* cd = overlay->GetCellData();
+  auto values = [cd](const char* name) -> const int* {
+    auto* arr = vtkIntArray::SafeDownCast(cd->GetArray(name));
+    return arr ? arr->GetPointer(0) : nullptr;
+  };
+  const int* phys_dim = values("phys_dim");
+  const int* phys_id = values("phys_id");
+  const int* elem_type = values("elem_type");
+  const int* cell_id = values("cell_id");
+  const int* ent_dim = values("entity_dim");
+  const int* ent_tag = values("entity_tag");
+  const bool by_entity = query.entity_dim >= 0 && query.entity_tag >= 0;
+
+  const vtkIdType cells = overlay->GetNumberOfCells();
+  auto ghosts = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfValues(cells);
+  unsigned char* ghost_ptr = ghosts->GetPointer(0);
+  std::atomic<vtkIdType> shown{0};
+  vtkSMPTools::For(0, cells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType local = 0;
+    for (vtkIdType c = begin; c < end; ++c) {
+      bool keep = true;
+      if (query.cell >= 0) {
+        keep = cell_id && cell_id[c] == query.cell;
+      }
+      if (keep && query.dim >= 0) {
+        keep = phys_dim && phys_dim[c] == query.dim;
+      }
+      if (keep && query.phys_id >= 0) {
+        keep = phys_id && phys_id[c] == query.phys_id;
+      }
+      if (keep && query.elem_type >= 0) {
+        keep = elem_type && elem_type[c] == query.elem_type;
+      }
+      if (keep && by_entity) {
+        keep = ent_dim && ent_tag && ent_dim[c] == query.entity_dim &&
+               ent_tag[c] == query.entity_tag;
+      }
+      ghost_ptr[c] = keep ? 0 : vtkDataSetAttributes::HIDDENCELL;
+      local += keep ? 1 : 0;
+    }
+    shown += local;
+  });
+  cd->AddArray(ghosts);
+  return shown.load();
+}
+
+// Cheap identity of a dataset's geometry: sizes, bounds and a strided sample
+// of point coordinates. An unchanged signature across time steps means the
+// cached locators still apply.
+std::uint64_t GeometrySignature(vtkDataSet* data) {
+  std::uint64_t hash = 1469598103934665603ULL;
+  auto mix = [&hash](const void* bytes, std::size_t size) {
+    const auto* p = static_cast<const unsigned char*>(bytes);
+    for (std::size_t i = 0; i < size; ++i) {
+      hash = (hash ^ p[i]) * 1099511628211ULL;
+    }
+  };
+  const vtkIdType points = data->GetNumberOfPoints();
+  const vtkIdType cells = data->GetNumberOfCells();
+  mix(&points, sizeof(points));
+  mix(&cells, sizeof(cells));
+  double bounds[6];
+  data->GetBounds(bounds);
+  mix(bounds, sizeof(bounds));
+  const vtkIdType stride = std::max<vtkIdType>(1, points / 1024);
+  for (vtkIdType i = 0; i < points; i += stride) {
+    double xyz[3];
+    data->GetPoint(i, xyz);
+    mix(xyz, sizeof(xyz));
+  }
+  return hash;
+}
+
 void AttachComboPopupFix(QComboBox* combo) {
   gmp::install_combo_popup_fix(combo);
 }
 
+// Exodus objects offered in the Blocks tab, with their selection-key prefix.
+struct ExodusObjectKind {
+  int type;
+  const char* prefix;
+  const char* label;
+};
+constexpr ExodusObjectKind kExodusObjectKinds[] = {
+    {vtkExodusIIReader::ELEM_BLOCK, "E:", "Block"},
+    {vtkExodusIIReader::NODE_SET, "N:", "Nodeset"},
+    {vtkExodusIIReader::SIDE_SET, "S:", "Sideset"}};
+
+QString ExodusObjectKey(vtkExodusIIReader* reader, const ExodusObjectKind& kind,
+                        int index) {
+  const char* name = reader->GetObjectName(kind.type, index);
+  return QString::fromLatin1(kind.prefix) +
+         (name ? QString::fromUtf8(name) : QString::number(index));
+}
+
 }  // namespace
 #endif
 
@@ -443,8 +922,35 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
   connect(array_filter_, QOverload<int>::of(&QComboBox::currentIndexChanged),
           this, [this](int) { update_array_list(); });
   left_layout->addWidget(array_filter_);
+  lazy_arrays_ = new QCheckBox("Load on demand", left_panel);
+  lazy_arrays_->setChecked(true);
+  lazy_arrays_->setToolTip(
+      "Read only the colour array, the deformation vector and checked "
+      "arrays from Exodus files");
+  connect(lazy_arrays_, &QCheckBox::toggled, this, [this](bool) {
+    update_array_list();
+    if (sync_exodus_array_status() && render_window_) {
+      render_window_->Render();
+    }
+  });
+  left_layout->addWidget(lazy_arrays_);
   array_list_ = new QListWidget(left_panel);
   array_list_->setSelectionMode(QAbstractItemView::SingleSelection);
+  connect(array_list_, &QListWidget::itemChanged, this,
+          [this](QListWidgetItem* item) {
+            if (!item || !(item->flags() & Qt::ItemIsUserCheckable)) {
+              return;
+            }
+            const QString key = item->data(Qt::UserRole).toString();
+            if (item->checkState() == Qt::Checked) {
+              pinned_arrays_.insert(key);
+            } else {
+              pinned_arrays_.remove(key);
+            }
+            if (sync_exodus_array_status() && render_window_) {
+              render_window_->Render();
+            }
+          });
   connect(array_list_, &QListWidget::currentItemChanged, this,
           [this](QListWidgetItem* current, QListWidgetItem*) {
             if (!current || !array_combo_) {
@@ -618,6 +1124,7 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
                                   : "Pick: disabled");
     }
     update_selection_pipeline();
+    schedule_locator_build();
   });
   pick_mode_ = new QComboBox();
   pick_mode_->addItem("Group", 0);
@@ -626,6 +1133,12 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
   AttachComboPopupFix(pick_mode_);
   connect(pick_mode_, QOverload<int>::of(&QComboBox::currentIndexChanged),
           this, [this](int) { update_selection_pipeline(); });
+  pick_hover_ = new QCheckBox("Hover");
+  pick_hover_->setToolTip(
+      "Preview the group, entity or cell under the cursor while picking");
+  pick_hover_->setChecked(false);
+  connect(pick_hover_, &QCheckBox::toggled, this,
+          [this](bool) { update_selection_pipeline(); });
   pick_clear_ = new QPushButton("Clear");
   connect(pick_clear_, &QPushButton::clicked, this, [this]() {
     selected_group_dim_ = -1;
@@ -645,6 +1158,7 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
   mesh_opts->addWidget(mesh_scalar_bar_);
   mesh_opts->addWidget(pick_enable_);
   mesh_opts->addWidget(pick_mode_);
+  mesh_opts->addWidget(pick_hover_);
   mesh_opts->addWidget(pick_clear_);
   mesh_opts->addStretch(1);
   mesh_layout->addLayout(mesh_opts);
@@ -714,6 +1228,44 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
   view_row->addStretch(1);
   view_layout->addLayout(view_row);
 
+  auto* lod_row = new QHBoxLayout();
+  lod_enable_ = new QCheckBox("LOD");
+  lod_enable_->setChecked(true);
+  lod_enable_->setToolTip(
+      "Render a decimated surface while the camera moves");
+  lod_face_threshold_ = new QSpinBox();
+  lod_face_threshold_->setRange(10000, 2000000000);
+  lod_face_threshold_->setSingleStep(100000);
+  lod_face_threshold_->setValue(1000000);
+  lod_min_fps_ = new QDoubleSpinBox();
+  lod_min_fps_->setRange(1.0, 120.0);
+  lod_min_fps_->setSingleStep(5.0);
+  lod_min_fps_->setValue(20.0);
+  lod_timer_ = new QTimer(this);
+  lod_timer_->setSingleShot(true);
+  lod_timer_->setInterval(300);
+  connect(lod_timer_, &QTimer::timeout, this, &VtkViewer::start_lod_build);
+  locator_timer_ = new QTimer(this);
+  locator_timer_->setSingleShot(true);
+  locator_timer_->setInterval(300);
+  connect(locator_timer_, &QTimer::timeout, this,
+          &VtkViewer::start_locator_build);
+  connect(lod_enable_, &QCheckBox::toggled, this, [this](bool) {
+    schedule_lod_build();
+    update_lod_overlay();
+  });
+  connect(lod_face_threshold_, QOverload<int>::of(&QSpinBox::valueChanged),
+          this, [this](int) { schedule_lod_build(); });
+  connect(lod_min_fps_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+          this, [this](double) { schedule_lod_build(); });
+  lod_row->addWidget(lod_enable_);
+  lod_row->addWidget(new QLabel("Faces >="));
+  lod_row->addWidget(lod_face_threshold_);
+  lod_row->addWidget(new QLabel("Min FPS"));
+  lod_row->addWidget(lod_min_fps_);
+  lod_row->addStretch(1);
+  view_layout->addLayout(lod_row);
+
   pick_info_ = new QLabel("Pick: disabled");
   view_layout->addWidget(pick_info_);
 
@@ -780,6 +1332,88 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
   time_row->addWidget(time_label_);
   time_layout->addLayout(time_row);
 
+#ifdef GMP_ENABLE_VTK_VIEWER
+  auto* cache_row = new QHBoxLayout();
+  step_cache_ = new ExodusStepCache(this);
+  step_cache_mb_ = new QSpinBox();
+  step_cache_mb_->setRange(0, 65536);
+  step_cache_mb_->setSingleStep(256);
+  step_cache_mb_->setValue(1024);
+  step_cache_mb_->setToolTip("Memory kept for decoded time steps; 0 disables");
+  step_prefetch_ = new QSpinBox();
+  step_prefetch_->setRange(0, 64);
+  step_prefetch_->setValue(8);
+  step_prefetch_->setToolTip("Steps read ahead in the background");
+  step_cache_info_ = new QLabel("Cache: empty");
+  connect(step_cache_mb_, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          [this](int mb) {
+            step_cache_->set_budget_bytes(static_cast<qint64>(mb) * 1048576);
+            update_step_cache_info();
+          });
+  connect(step_prefetch_, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          [this](int steps) { step_cache_->set_prefetch_depth(steps); });
+  connect(step_cache_, &ExodusStepCache::step_ready, this,
+          [this](int) { update_step_cache_info(); });
+  cache_row->addWidget(new QLabel("Cache MB"));
+  cache_row->addWidget(step_cache_mb_);
+  cache_row->addWidget(new QLabel("Prefetch"));
+  cache_row->addWidget(step_prefetch_);
+  cache_row->addStretch(1);
+  time_layout->addLayout(cache_row);
+  time_layout->addWidget(step_cache_info_);
+
+  auto* play_row = new QHBoxLayout();
+  play_btn_ = new QPushButton("Play");
+  play_btn_->setCheckable(true);
+  play_fps_ = new QDoubleSpinBox();
+  play_fps_->setRange(1.0, 120.0);
+  play_fps_->setSingleStep(5.0);
+  play_fps_->setValue(24.0);
+  play_loop_ = new QCheckBox("Loop");
+  export_btn_ = new QPushButton("Export Frames...");
+  export_btn_->setToolTip("Render every time step to a PNG sequence");
+  play_info_ = new QLabel("Playback: stopped");
+  play_timer_ = new QTimer(this);
+  play_timer_->setTimerType(Qt::PreciseTimer);
+  exporter_ = new FrameExporter(this);
+  connect(play_btn_, &QPushButton::toggled, this, &VtkViewer::set_playing);
+  connect(play_timer_, &QTimer::timeout, this, &VtkViewer::on_play_tick);
+  connect(play_fps_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+          this, [this](double) {
+            if (play_timer_->isActive()) {
+              set_playing(true);
+            }
+          });
+  connect(export_btn_, &QPushButton::clicked, this, [this]() {
+    if (exporter_->running()) {
+      exporter_->cancel();
+      return;
+    }
+    const QString dir = QFileDialog::getExistingDirectory(
+        this, "Export Frames", QFileInfo(current_file_).absolutePath());
+    if (!dir.isEmpty()) {
+      export_frames(dir);
+    }
+  });
+  connect(exporter_, &FrameExporter::progress, this, [this](int done, int total) {
+    play_info_->setText(QString("Export: %1/%2 frames").arg(done).arg(total));
+  });
+  connect(exporter_, &FrameExporter::finished, this,
+          [this](bool ok, const QString& summary) {
+            export_btn_->setText("Export Frames...");
+            play_info_->setText(ok ? "Export: done" : "Export: stopped");
+            emit log_message(summary);
+          });
+  play_row->addWidget(play_btn_);
+  play_row->addWidget(new QLabel("FPS"));
+  play_row->addWidget(play_fps_);
+  play_row->addWidget(play_loop_);
+  play_row->addWidget(export_btn_);
+  play_row->addStretch(1);
+  time_layout->addLayout(play_row);
+  time_layout->addWidget(play_info_);
+#endif
+
   auto* vector_layout = make_tab("Vector");
   vector_array_combo_ = new QComboBox();
   vector_array_combo_->setMinimumWidth(240);
@@ -883,6 +1517,36 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
             }
           });
 
+  auto* block_layout = make_tab("Blocks");
+  block_list_ = new QListWidget();
+  block_list_->setToolTip("Unchecked blocks and sets are not read");
+  block_all_ = new QPushButton("All Blocks");
+  block_none_ = new QPushButton("None");
+  block_info_ = new QLabel("Blocks: no Exodus file");
+  connect(block_list_, &QListWidget::itemChanged, this,
+          [this](QListWidgetItem*) { on_block_item_changed(); });
+  auto set_all_blocks = [this](bool blocks_on) {
+    block_list_->blockSignals(true);
+    for (int i = 0; i < block_list_->count(); ++i) {
+      QListWidgetItem* item = block_list_->item(i);
+      const bool is_block = item->data(Qt::UserRole).toString().startsWith("E:");
+      item->setCheckState(blocks_on && is_block ? Qt::Checked : Qt::Unchecked);
+    }
+    block_list_->blockSignals(false);
+    on_block_item_changed();
+  };
+  connect(block_all_, &QPushButton::clicked, this,
+          [set_all_blocks]() { set_all_blocks(true); });
+  connect(block_none_, &QPushButton::clicked, this,
+          [set_all_blocks]() { set_all_blocks(false); });
+  auto* block_row = new QHBoxLayout();
+  block_row->addWidget(block_all_);
+  block_row->addWidget(block_none_);
+  block_row->addStretch(1);
+  block_layout->addLayout(block_row);
+  block_layout->addWidget(block_list_, 1);
+  block_layout->addWidget(block_info_);
+
   auto* probe_layout = make_tab("Probe");
   probe_enable_ = new QCheckBox("Enable Probe");
   probe_mode_ = new QComboBox();
@@ -890,10 +1554,13 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
   probe_mode_->addItem("Cell", 1);
   AttachComboPopupFix(probe_mode_);
   probe_clear_ = new QPushButton("Clear");
+  probe_follow_ = new QCheckBox("Follow mouse");
+  probe_follow_->setToolTip("Probe continuously under the cursor");
   auto* probe_row = new QHBoxLayout();
   probe_row->addWidget(probe_enable_);
   probe_row->addWidget(new QLabel("Mode"));
   probe_row->addWidget(probe_mode_);
+  probe_row->addWidget(probe_follow_);
   probe_row->addWidget(probe_clear_);
   probe_row->addStretch(1);
   probe_layout->addLayout(probe_row);
@@ -914,7 +1581,10 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
     probe_info_->setText(QString("Probe: enabled (%1 mode)").arg(mode));
   };
   connect(probe_enable_, &QCheckBox::toggled, this,
-          [update_probe_status](bool) { update_probe_status(); });
+          [this, update_probe_status](bool) {
+            update_probe_status();
+            schedule_locator_build();
+          });
   connect(probe_mode_, QOverload<int>::of(&QComboBox::currentIndexChanged),
           this, [update_probe_status](int) { update_probe_status(); });
   connect(probe_clear_, &QPushButton::clicked, this, [this]() {
@@ -925,54 +1595,109 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
 
   auto* plot_layout = make_tab("Plot");
   auto* plot_row = new QHBoxLayout();
+  plot_mode_ = new QComboBox();
+  plot_mode_->addItem("Histogram", 0);
+  plot_mode_->addItem("Time history", 1);
+  AttachComboPopupFix(plot_mode_);
+  plot_bins_ = new QSpinBox();
+  plot_bins_->setRange(4, 512);
+  plot_bins_->setValue(64);
+  plot_bins_->setToolTip("Histogram bins");
   plot_refresh_btn_ = new QPushButton("Refresh");
   plot_stats_ = new QLabel("No data");
+  plot_row->addWidget(plot_mode_);
+  plot_row->addWidget(new QLabel("Bins"));
+  plot_row->addWidget(plot_bins_);
   plot_row->addWidget(plot_refresh_btn_);
   plot_row->addWidget(plot_stats_);
   plot_row->addStretch(1);
   plot_layout->addLayout(plot_row);
-  plot_view_ = new QPlainTextEdit();
-  plot_view_->setReadOnly(true);
-  plot_view_->setLineWrapMode(QPlainTextEdit::NoWrap);
-  QFont plot_font;
-  plot_font.setFamilies({"SFMono-Regular", "Monaco", "Consolas", "Menlo"});
-  plot_font.setStyleHint(QFont::Monospace);
-  plot_font.setPointSize(10);
-  plot_view_->setFont(plot_font);
-  plot_view_->setMinimumHeight(96);
+  auto* history_row = new QHBoxLayout();
+  plot_source_ = new QComboBox();
+  plot_source_->addItem("Probed point/cell", QString());
+  plot_source_->setToolTip(
+      "Probe a point or cell, or pick a global variable, then Extract");
+  AttachComboPopupFix(plot_source_);
+  plot_extract_btn_ = new QPushButton("Extract");
+  plot_history_info_ = new QLabel("History: none");
+  plot_history_info_->setWordWrap(true);
+  history_row->addWidget(new QLabel("History"));
+  history_row->addWidget(plot_source_, 1);
+  history_row->addWidget(plot_extract_btn_);
+  plot_layout->addLayout(history_row);
+  plot_layout->addWidget(plot_history_info_);
+  plot_view_ = new PlotWidget();
   plot_layout->addWidget(plot_view_, 1);
   connect(plot_refresh_btn_, &QPushButton::clicked, this,
           &VtkViewer::update_plot_view);
+  connect(plot_mode_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+          this, [this](int) { update_plot_view(); });
+  connect(plot_bins_, QOverload<int>::of(&QSpinBox::valueChanged), this,
+          [this](int) { update_plot_view(); });
+  connect(plot_extract_btn_, &QPushButton::clicked, this,
+          &VtkViewer::start_time_history);
+#ifdef GMP_ENABLE_VTK_VIEWER
+  history_ = new ExodusTimeHistory(this);
+  connect(history_, &ExodusTimeHistory::progress, this,
+          [this](int done, int total) {
+            plot_history_info_->setText(
+                QString("History: extracting %1/%2 steps").arg(done).arg(total));
+          });
+  connect(history_, &ExodusTimeHistory::finished, this,
+          &VtkViewer::on_time_history_finished);
+#endif
 
   auto* table_layout = make_tab("Table");
   auto* table_row = new QHBoxLayout();
-  table_row->addWidget(new QLabel("Rows"));
+  table_row->addWidget(new QLabel("Snapshot rows"));
   table_rows_spin_ = new QSpinBox();
   table_rows_spin_->setRange(10, 5000);
   table_rows_spin_->setSingleStep(50);
   table_rows_spin_->setValue(100);
   table_refresh_btn_ = new QPushButton("Refresh");
+  table_min_btn_ = new QPushButton("Min");
+  table_min_btn_->setToolTip("Jump to the tuple with the smallest value");
+  table_max_btn_ = new QPushButton("Max");
+  table_max_btn_->setToolTip("Jump to the tuple with the largest value");
   table_stats_ = new QLabel("No data");
   table_row->addWidget(table_rows_spin_);
   table_row->addWidget(table_refresh_btn_);
+  table_row->addWidget(table_min_btn_);
+  table_row->addWidget(table_max_btn_);
   table_row->addWidget(table_stats_);
   table_row->addStretch(1);
   table_layout->addLayout(table_row);
-  table_view_ = new QTableWidget();
+  table_view_ = new QTableView();
   table_view_->setSelectionBehavior(QAbstractItemView::SelectRows);
   table_view_->setSelectionMode(QAbstractItemView::SingleSelection);
   table_view_->setEditTriggers(QAbstractItemView::NoEditTriggers);
   table_view_->setAlternatingRowColors(true);
   table_view_->horizontalHeader()->setSectionResizeMode(
-      QHeaderView::ResizeToContents);
+      QHeaderView::Interactive);
   table_view_->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
   table_view_->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
   table_view_->setMinimumHeight(96);
+  table_view_->verticalHeader()->setVisible(false);
   table_layout->addWidget(table_view_, 1);
+#ifdef GMP_ENABLE_VTK_VIEWER
+  // Cells are formatted on paint, so the view covers every tuple; a fixed
+  // row height keeps scrolling independent of the row count.
+  table_model_ = new ArrayTableModel(this);
+  table_view_->setModel(table_model_);
+  table_view_->setSortingEnabled(true);
+  table_view_->sortByColumn(0, Qt::AscendingOrder);
+  table_view_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+  connect(table_model_, &ArrayTableModel::sorted, this,
+          [this](double) { update_table_view(); });
+#endif
   connect(table_rows_spin_, QOverload<int>::of(&QSpinBox::valueChanged), this,
           &VtkViewer::update_table_view);
   connect(table_refresh_btn_, &QPushButton::clicked, this,
           &VtkViewer::update_table_view);
+  connect(table_min_btn_, &QPushButton::clicked, this,
+          [this]() { jump_to_table_extreme(false); });
+  connect(table_max_btn_, &QPushButton::clicked, this,
+          [this]() { jump_to_table_extreme(true); });
 
 #ifdef GMP_ENABLE_VTK_VIEWER
   vtk_widget_ = new QVTKOpenGLNativeWidget(right_panel);
@@ -986,6 +1711,9 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
   right_layout->addWidget(label, 1);
   reload_btn_->setEnabled(false);
   open_btn_->setEnabled(false);
+  lod_enable_->setEnabled(false);
+  lod_face_threshold_->setEnabled(false);
+  lod_min_fps_->setEnabled(false);
   array_combo_->setEnabled(false);
   preset_combo_->setEnabled(false);
   repr_combo_->setEnabled(false);
@@ -1006,11 +1734,35 @@ VtkViewer::VtkViewer(QWidget* parent) : QWidget(parent) {
   mesh_group_->setEnabled(false);
   slice_enable_->setEnabled(false);
   slice_axis_->setEnabled(false);
+  table_min_btn_->setEnabled(false);
+  plot_extract_btn_->setEnabled(false);
+  table_max_btn_->setEnabled(false);
   slice_slider_->setEnabled(false);
   mesh_legend_->setEnabled(false);
 #endif
 }
 
+VtkViewer::~VtkViewer() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  // The export reads through step_cache_; stop it before the cache goes.
+  delete exporter_;
+  exporter_ = nullptr;
+  delete history_;
+  history_ = nullptr;
+#endif
+  if (lod_thread_) {
+    // The build only reads a shallow copy of the surface; let it finish.
+    lod_thread_->wait();
+    delete lod_thread_;
+    lod_thread_ = nullptr;
+  }
+  if (locator_thread_) {
+    locator_thread_->wait();
+    delete locator_thread_;
+    locator_thread_ = nullptr;
+  }
+}
+
 void VtkViewer::set_exodus_file(const QString& path) {
   current_file_ = path;
   if (!file_label_) {
@@ -1042,9 +1794,12 @@ void VtkViewer::set_exodus_file(const QString& path) {
   if (!scalar_bar_) {
     scalar_bar_ = vtkSmartPointer<vtkScalarBarActor>::New();
   }
+  if (!time_surface_) {
+    time_surface_ = vtkSmartPointer<vtkPolyData>::New();
+  }
   mapper_->SetLookupTable(lut_);
   geom_->SetInputConnection(reader_->GetOutputPort());
-  mapper_->SetInputConnection(geom_->GetOutputPort());
+  mapper_->SetInputData(time_surface_);
   actor_->SetMapper(mapper_);
   if (renderer_ && !actor_added_) {
     renderer_->AddActor(actor_);
@@ -1056,21 +1811,30 @@ void VtkViewer::set_exodus_file(const QString& path) {
 
   first_render_ = true;
   mode_ = DataMode::Exodus;
-  reader_->SetFileName(path.toUtf8().constData());
-  reader_->UpdateInformation();
-  reader_->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
-  reader_->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  last_time_index_ = -1;
+  array_stats_.clear();
+  history_->clear();
+  probe_id_ = -1;
+  update_history_sources();
+  if (exporter_) {
+    exporter_->cancel();
+  }
+  if (play_btn_) {
+    play_btn_->setChecked(false);
+  }
+  {
+    std::lock_guard<std::mutex> io(ExodusIoMutex());
+    reader_->SetFileName(path.toUtf8().constData());
+    reader_->UpdateInformation();
+  }
+  // Result arrays start unloaded when loading on demand; populate_arrays()
+  // lists them from metadata and on_array_changed() enables the one shown.
+  const int load_all = lazy_arrays_ && lazy_arrays_->isChecked() ? 0 : 1;
+  reader_->SetAllArrayStatus(vtkExodusIIReader::NODAL, load_all);
+  reader_->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, load_all);
   reader_->SetAllArrayStatus(vtkExodusIIReader::GLOBAL, 1);
-  const int n_points = reader_->GetNumberOfPointResultArrays();
-  for (int i = 0; i < n_points; ++i) {
-    reader_->SetPointResultArrayStatus(
-        reader_->GetPointResultArrayName(i), 1);
-  }
-  const int n_elems = reader_->GetNumberOfElementResultArrays();
-  for (int i = 0; i < n_elems; ++i) {
-    reader_->SetElementResultArrayStatus(
-        reader_->GetElementResultArrayName(i), 1);
-  }
+  apply_exodus_selection();
+  update_block_list();
   update_time_steps_from_reader(false);
   update_mesh_controls();
   setup_watcher(path);
@@ -1093,6 +1857,10 @@ void VtkViewer::set_mesh_file(const QString& path) {
   if (!renderer_) {
     return;
   }
+  array_stats_.clear();
+  history_->clear();
+  probe_id_ = -1;
+  update_history_sources();
   if (!mapper_) {
     mapper_ = vtkSmartPointer<vtkDataSetMapper>::New();
     actor_ = vtkSmartPointer<vtkActor>::New();
@@ -1106,51 +1874,115 @@ void VtkViewer::set_mesh_file(const QString& path) {
     mesh_geom_ = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
   }
 
-#ifdef GMP_ENABLE_GMSH_GUI
   mesh_quality_ready_ = false;
   mesh_groups_.clear();
   mesh_elem_types_.clear();
   mesh_entities_.clear();
-  mesh_grid_ = BuildGridFromGmsh(path);
+  mesh_grid_ = nullptr;
+  mesh_index_.clear();
+
+  // The streaming reader leaves the gmsh model untouched; the gmsh API is
+  // only used for formats the reader does not understand.
+  QString read_error;
+  {
+    QElapsedTimer timer;
+    timer.start();
+    MshGridSink sink;
+    if (ReadMsh(path, sink, MshReadOptions(), &read_error)) {
+      const double read_ms = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+      timer.restart();
+      mesh_grid_ = sink.finish();
+      const double build_ms =
+          static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+      for (const auto& g : sink.groups()) {
+        mesh_groups_.push_back(
+            {g.first, g.second, sink.group_name(g.first, g.second)});
+      }
+      mesh_elem_types_.assign(sink.element_types().begin(),
+                              sink.element_types().end());
+      for (const auto& ent : sink.entities()) {
+        mesh_entities_.push_back({ent.first, ent.second});
+      }
+      emit log_message(
+          QString("Mesh preview (msh reader): points=%1 cells=%2 | "
+                  "read=%3ms assemble=%4ms")
+              .arg(sink.point_count())
+              .arg(sink.cell_count())
+              .arg(read_ms, 0, 'f', 1)
+              .arg(build_ms, 0, 'f', 1));
+    }
+  }
+
+  if (!mesh_grid_) {
+#ifdef GMP_ENABLE_GMSH_GUI
+    emit log_message(
+        QString("Mesh reader: %1; falling back to gmsh.").arg(read_error));
+    GridBuildTimings timings;
+    mesh_grid_ = BuildGridFromGmsh(path, &timings);
+    if (mesh_grid_) {
+      emit log_message(timings.summary());
+      try {
+        std::vector<std::pair<int, int>> groups;
+        gmsh::model::getPhysicalGroups(groups);
+        for (const auto& pg : groups) {
+          std::string name;
+          gmsh::model::getPhysicalName(pg.first, pg.second, name);
+          mesh_groups_.push_back(
+              {pg.first, pg.second, QString::fromStdString(name)});
+        }
+        std::vector<int> element_types;
+        gmsh::model::mesh::getElementTypes(element_types);
+        std::sort(element_types.begin(), element_types.end());
+        element_types.erase(
+            std::unique(element_types.begin(), element_types.end()),
+            element_types.end());
+        for (int t : element_types) {
+          mesh_elem_types_.push_back(t);
+        }
+
+        std::vector<std::pair<int, int>> entities;
+        gmsh::model::getEntities(entities);
+        std::sort(entities.begin(), entities.end());
+        for (const auto& ent : entities) {
+          mesh_entities_.push_back({ent.first, ent.second});
+        }
+      } catch (...) {
+        // Ignore physical group name errors.
+      }
+    }
+#endif
+  }
   if (!mesh_grid_) {
     file_label_->setText("Failed to load mesh");
+    emit log_message(QString("Mesh preview failed: %1 (%2)")
+                         .arg(path)
+                         .arg(read_error));
     return;
   }
+  {
+    QElapsedTimer timer;
+    timer.start();
+    auto* cd = mesh_grid_->GetCellData();
+    auto values = [cd](const char* name) -> const int* {
+      auto* arr = vtkIntArray::SafeDownCast(cd->GetArray(name));
+      return arr ? arr->GetPointer(0) : nullptr;
+    };
+    mesh_index_.build(values("phys_dim"), values("phys_id"),
+                      values("elem_type"), values("entity_dim"),
+                      values("entity_tag"),
+                      static_cast<std::size_t>(mesh_grid_->GetNumberOfCells()),
+                      QThread::idealThreadCount());
+    emit log_message(
+        QString("Mesh selection index: %1 cells, %2 MB in %3ms")
+            .arg(mesh_index_.cell_count())
+            .arg(static_cast<double>(mesh_index_.memory_bytes()) / 1048576.0,
+                 0, 'f', 1)
+            .arg(static_cast<double>(timer.nsecsElapsed()) / 1.0e6, 0, 'f',
+                 1));
+  }
+  mesh_filter_applied_ = false;
   mesh_grid_->GetBounds(mesh_bounds_);
-  try {
-    std::vector<std::pair<int, int>> groups;
-    gmsh::model::getPhysicalGroups(groups);
-    for (const auto& pg : groups) {
-      std::string name;
-      gmsh::model::getPhysicalName(pg.first, pg.second, name);
-      mesh_groups_.push_back(
-          {pg.first, pg.second, QString::fromStdString(name)});
-    }
-    std::vector<int> element_types;
-    std::vector<std::vector<std::size_t>> element_tags;
-    std::vector<std::vector<std::size_t>> element_nodes;
-    gmsh::model::mesh::getElements(element_types, element_tags, element_nodes);
-    std::sort(element_types.begin(), element_types.end());
-    element_types.erase(std::unique(element_types.begin(), element_types.end()),
-                        element_types.end());
-    for (int t : element_types) {
-      mesh_elem_types_.push_back(t);
-    }
-
-    std::vector<std::pair<int, int>> entities;
-    gmsh::model::getEntities(entities);
-    std::sort(entities.begin(), entities.end());
-    for (const auto& ent : entities) {
-      mesh_entities_.push_back({ent.first, ent.second});
-    }
-  } catch (...) {
-    // Ignore physical group name errors.
-  }
   mesh_geom_->SetInputData(mesh_grid_);
-#else
-  file_label_->setText("Mesh preview requires libgmsh");
-  return;
-#endif
 
   mapper_->SetInputConnection(mesh_geom_->GetOutputPort());
   actor_->SetMapper(mapper_);
@@ -1271,6 +2103,7 @@ QVariantMap VtkViewer::viewer_settings() const {
              mesh_scalar_bar_ && mesh_scalar_bar_->isChecked());
   map.insert("pick_enable", pick_enable_ && pick_enable_->isChecked());
   map.insert("pick_mode", pick_mode_ ? pick_mode_->currentData().toInt() : 0);
+  map.insert("pick_hover", pick_hover_ && pick_hover_->isChecked());
   map.insert("slice_enable", slice_enable_ && slice_enable_->isChecked());
   map.insert("slice_axis", slice_axis_ ? slice_axis_->currentIndex() : 0);
   map.insert("slice_value", slice_slider_ ? slice_slider_->value() : 50);
@@ -1284,6 +2117,7 @@ QVariantMap VtkViewer::viewer_settings() const {
   map.insert("probe_enable", probe_enable_ && probe_enable_->isChecked());
   map.insert("probe_mode",
              probe_mode_ ? probe_mode_->currentData().toInt() : 0);
+  map.insert("probe_follow", probe_follow_ && probe_follow_->isChecked());
   map.insert("deform_enable", deform_enable_ && deform_enable_->isChecked());
   map.insert("deform_vector",
              deform_vector_ ? deform_vector_->currentData().toString() : "");
@@ -1294,6 +2128,19 @@ QVariantMap VtkViewer::viewer_settings() const {
   map.insert("vector_array", vector_array_combo_ ? vector_array_combo_->currentData().toString() : "");
   map.insert("table_rows",
              table_rows_spin_ ? table_rows_spin_->value() : 100);
+  map.insert("plot_bins", plot_bins_ ? plot_bins_->value() : 64);
+  map.insert("lod_enable", lod_enable_ && lod_enable_->isChecked());
+  map.insert("lod_face_threshold",
+             lod_face_threshold_ ? lod_face_threshold_->value() : 1000000);
+  map.insert("lod_min_fps", lod_min_fps_ ? lod_min_fps_->value() : 20.0);
+  map.insert("step_cache_mb",
+             step_cache_mb_ ? step_cache_mb_->value() : 1024);
+  map.insert("step_prefetch", step_prefetch_ ? step_prefetch_->value() : 8);
+  map.insert("play_fps", play_fps_ ? play_fps_->value() : 24.0);
+  map.insert("play_loop", play_loop_ && play_loop_->isChecked());
+  map.insert("lazy_arrays", lazy_arrays_ && lazy_arrays_->isChecked());
+  map.insert("pinned_arrays", QStringList(pinned_arrays_.values()));
+  map.insert("exodus_selection", exodus_selection_);
 
 #ifdef GMP_ENABLE_VTK_VIEWER
   if (mesh_group_) {
@@ -1318,6 +2165,8 @@ QVariantMap VtkViewer::viewer_settings() const {
 }
 
 void VtkViewer::apply_viewer_settings(const QVariantMap& settings) {
+  // Applied while the file opens, so unselected blocks are never read.
+  exodus_selection_ = settings.value("exodus_selection").toStringList();
   const QString file = settings.value("current_file").toString();
   if (!file.isEmpty()) {
     load_file(file);
@@ -1379,6 +2228,10 @@ void VtkViewer::apply_viewer_settings(const QVariantMap& settings) {
       pick_mode_->setCurrentIndex(idx);
     }
   }
+  if (pick_hover_) {
+    pick_hover_->setChecked(
+        settings.value("pick_hover", pick_hover_->isChecked()).toBool());
+  }
   if (slice_enable_) {
     slice_enable_->setChecked(
         settings.value("slice_enable", slice_enable_->isChecked()).toBool());
@@ -1432,6 +2285,16 @@ void VtkViewer::apply_viewer_settings(const QVariantMap& settings) {
     repr_combo_->setCurrentIndex(
         settings.value("repr", repr_combo_->currentIndex()).toInt());
   }
+  if (lazy_arrays_) {
+    lazy_arrays_->setChecked(
+        settings.value("lazy_arrays", lazy_arrays_->isChecked()).toBool());
+  }
+  if (settings.contains("pinned_arrays")) {
+    const QStringList pinned = settings.value("pinned_arrays").toStringList();
+    pinned_arrays_ = QSet<QString>(pinned.begin(), pinned.end());
+    update_array_list();
+    sync_exodus_array_status();
+  }
   if (array_combo_) {
     const QString key = settings.value("array_key").toString();
     if (!key.isEmpty()) {
@@ -1479,6 +2342,11 @@ void VtkViewer::apply_viewer_settings(const QVariantMap& settings) {
       probe_mode_->setCurrentIndex(idx);
     }
   }
+  if (probe_follow_) {
+    probe_follow_->setChecked(
+        settings.value("probe_follow", probe_follow_->isChecked()).toBool());
+  }
+
   if (deform_enable_) {
     deform_enable_->setChecked(
         settings.value("deform_enable", deform_enable_->isChecked()).toBool());
@@ -1513,6 +2381,39 @@ void VtkViewer::apply_viewer_settings(const QVariantMap& settings) {
     const int rows = settings.value("table_rows", table_rows_spin_->value()).toInt();
     table_rows_spin_->setValue(qBound(10, rows, 5000));
   }
+  if (plot_bins_) {
+    const int bins = settings.value("plot_bins", plot_bins_->value()).toInt();
+    plot_bins_->setValue(qBound(4, bins, 512));
+  }
+  if (lod_enable_) {
+    lod_enable_->setChecked(
+        settings.value("lod_enable", lod_enable_->isChecked()).toBool());
+  }
+  if (lod_face_threshold_) {
+    lod_face_threshold_->setValue(
+        settings.value("lod_face_threshold", lod_face_threshold_->value())
+            .toInt());
+  }
+  if (lod_min_fps_) {
+    lod_min_fps_->setValue(
+        settings.value("lod_min_fps", lod_min_fps_->value()).toDouble());
+  }
+  if (step_cache_mb_) {
+    step_cache_mb_->setValue(
+        settings.value("step_cache_mb", step_cache_mb_->value()).toInt());
+  }
+  if (step_prefetch_) {
+    step_prefetch_->setValue(
+        settings.value("step_prefetch", step_prefetch_->value()).toInt());
+  }
+  if (play_fps_) {
+    play_fps_->setValue(
+        settings.value("play_fps", play_fps_->value()).toDouble());
+  }
+  if (play_loop_) {
+    play_loop_->setChecked(
+        settings.value("play_loop", play_loop_->isChecked()).toBool());
+  }
 
   if (settings.contains("mesh_group_dim") && settings.contains("mesh_group_id")) {
     set_mesh_group_filter(settings.value("mesh_group_dim").toInt(),
@@ -1608,6 +2509,13 @@ void VtkViewer::on_time_changed(int index) {
   } else {
     refresh_time_only();
   }
+  if (plot_view_) {
+    plot_view_->set_marker(time_steps_[index]);
+  }
+  if (play_timer_ && play_timer_->isActive()) {
+    // set_playing(false) brings these up to date.
+    return;
+  }
   update_vector_tab();
   if (plot_view_) {
     update_plot_view();
@@ -1634,6 +2542,7 @@ void VtkViewer::on_array_changed(int index) {
   }
   const bool is_point = key.startsWith("P:");
   const QString name = key.mid(2);
+  sync_exodus_array_status();
 
   vtkDataSet* data = nullptr;
   if (mode_ == DataMode::Exodus && mapper_) {
@@ -1737,31 +2646,471 @@ void VtkViewer::init_vtk() {
     });
     interactor->AddObserver(vtkCommand::LeftButtonPressEvent, pick_callback_);
   }
+  if (interactor && !hover_callback_) {
+    hover_callback_ = vtkSmartPointer<vtkCallbackCommand>::New();
+    hover_callback_->SetClientData(this);
+    hover_callback_->SetCallback([](vtkObject* caller, unsigned long,
+                                    void* client_data, void*) {
+      auto* self = static_cast<VtkViewer*>(client_data);
+      auto* iren = vtkRenderWindowInteractor::SafeDownCast(caller);
+      if (!self || !iren) {
+        return;
+      }
+      const bool hover = self->mode_ == DataMode::Mesh && self->pick_hover_ &&
+                         self->pick_hover_->isChecked();
+      const bool follow = self->mode_ == DataMode::Exodus &&
+                          self->probe_enable_ &&
+                          self->probe_enable_->isChecked() &&
+                          self->probe_follow_ &&
+                          self->probe_follow_->isChecked();
+      if (!hover && !follow) {
+        return;
+      }
+      // Leave camera drags alone; the style handles those.
+      auto* style = vtkInteractorStyle::SafeDownCast(iren->GetInteractorStyle());
+      if (style && style->GetState() != VTKIS_NONE) {
+        return;
+      }
+      int pos[2] = {0, 0};
+      iren->GetEventPosition(pos);
+      if (hover) {
+        self->handle_hover(pos[0], pos[1]);
+      } else {
+        self->probe_at(pos[0], pos[1]);
+      }
+    });
+    interactor->AddObserver(vtkCommand::MouseMoveEvent, hover_callback_);
+  }
+  if (!render_callback_) {
+    render_callback_ = vtkSmartPointer<vtkCallbackCommand>::New();
+    render_callback_->SetClientData(this);
+    render_callback_->SetCallback([](vtkObject*, unsigned long event,
+                                     void* client_data, void*) {
+      if (auto* self = static_cast<VtkViewer*>(client_data)) {
+        self->on_render_event(event == vtkCommand::StartEvent);
+      }
+    });
+    render_window_->AddObserver(vtkCommand::StartEvent, render_callback_);
+    render_window_->AddObserver(vtkCommand::EndEvent, render_callback_);
+  }
 #endif
 }
 
-void VtkViewer::update_pipeline() {
 #ifdef GMP_ENABLE_VTK_VIEWER
-  if (!render_window_) {
+struct VtkViewer::LodBuild {
+  vtkSmartPointer<vtkDataSet> input;
+  vtkDataSet* source = nullptr;
+  vtkMTimeType mtime = 0;
+  std::string point_array;
+  std::vector<vtkIdType> targets;
+  std::vector<vtkSmartPointer<vtkPolyData>> levels;
+  qint64 elapsed_ms = 0;
+};
+#endif
+
+void VtkViewer::schedule_lod_build() {
+  if (lod_timer_) {
+    lod_timer_->start();
+  }
+}
+
+void VtkViewer::start_lod_build() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!mapper_ || !renderer_) {
     return;
   }
-  if (current_file_.isEmpty()) {
+  if (lod_thread_) {
+    lod_rebuild_pending_ = true;
     return;
   }
-  if (!pipeline_ready_) {
+  vtkDataSet* data = mapper_->GetInput();
+  const bool enabled = lod_enable_ && lod_enable_->isChecked();
+  const std::string point_array =
+      mapper_->GetScalarMode() == VTK_SCALAR_MODE_USE_POINT_FIELD_DATA &&
+              mapper_->GetArrayName()
+          ? mapper_->GetArrayName()
+          : std::string();
+  const vtkIdType faces = data ? data->GetNumberOfCells() : 0;
+  const vtkIdType threshold =
+      lod_face_threshold_ ? lod_face_threshold_->value() : 1000000;
+  const double min_fps = lod_min_fps_ ? lod_min_fps_->value() : 20.0;
+  set_lod_level(0);
+  lod_levels_.clear();
+  lod_source_ = data;
+  lod_source_mtime_ = data ? data->GetMTime() : 0;
+  lod_full_faces_ = faces;
+  if (!enabled || !data ||
+      (faces < threshold && lod_full_render_s_ * min_fps <= 1.0)) {
+    // Nothing to build; the identity above stops re-scheduling.
+    update_lod_overlay();
     return;
   }
-  if (mode_ == DataMode::Exodus && reader_ && geom_) {
-    if (!time_steps_.empty()) {
-      vtkInformation* info = reader_->GetOutputInformation(0);
-      if (info) {
-        const int idx = time_slider_->value();
-        const double t = time_steps_[idx];
-        info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), t);
+
+  auto build = std::make_shared<LodBuild>();
+  build->input.TakeReference(data->NewInstance());
+  build->input->ShallowCopy(data);
+  build->source = data;
+  build->mtime = lod_source_mtime_;
+  build->point_array = point_array;
+  const vtkIdType base = std::max<vtkIdType>(
+      1000, std::min<vtkIdType>(threshold, faces / 2));
+  for (int i = 0; i < 3; ++i) {
+    build->targets.push_back(base >> (2 * i));
+  }
+  lod_build_ = build;
+  lod_thread_ = QThread::create([build]() {
+    QElapsedTimer timer;
+    timer.start();
+    build->levels =
+        BuildLodLevels(build->input, build->point_array, build->targets);
+    build->input = nullptr;
+    build->elapsed_ms = timer.elapsed();
+  });
+  connect(lod_thread_, &QThread::finished, this,
+          &VtkViewer::on_lod_build_finished);
+  lod_thread_->start(QThread::LowPriority);
+  update_lod_overlay();
+#endif
+}
+
+void VtkViewer::on_lod_build_finished() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (lod_thread_) {
+    lod_thread_->deleteLater();
+    lod_thread_ = nullptr;
+  }
+  auto build = std::move(lod_build_);
+  if (lod_rebuild_pending_) {
+    lod_rebuild_pending_ = false;
+    schedule_lod_build();
+  }
+  if (!build || build->source != lod_source_ ||
+      build->mtime != lod_source_mtime_) {
+    update_lod_overlay();
+    return;
+  }
+  lod_levels_ = std::move(build->levels);
+  QStringList counts;
+  for (const auto& level : lod_levels_) {
+    counts << FormatFaceCount(level->GetNumberOfCells());
+  }
+  emit log_message(QString("LOD: %1 -> %2 faces in %3 ms")
+                       .arg(FormatFaceCount(lod_full_faces_))
+                       .arg(counts.isEmpty() ? "none" : counts.join(" / "))
+                       .arg(build->elapsed_ms));
+  update_lod_overlay();
+  if (render_window_) {
+    render_window_->Render();
+  }
+#endif
+}
+
+void VtkViewer::set_lod_level(int level) {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!actor_ || !mapper_) {
+    lod_level_ = 0;
+    return;
+  }
+  level = std::clamp(level, 0, static_cast<int>(lod_levels_.size()));
+  lod_level_ = level;
+  if (level == 0) {
+    if (actor_->GetMapper() != mapper_) {
+      actor_->SetMapper(mapper_);
+    }
+    return;
+  }
+  if (!lod_mapper_) {
+    lod_mapper_ = vtkSmartPointer<vtkPolyDataMapper>::New();
+  }
+  // Colour settings follow the full-resolution mapper; point arrays were
+  // moved to cell data when the proxies were built.
+  lod_mapper_->ShallowCopy(mapper_);
+  if (mapper_->GetScalarMode() == VTK_SCALAR_MODE_USE_POINT_FIELD_DATA) {
+    lod_mapper_->SetScalarModeToUseCellFieldData();
+  }
+  lod_mapper_->SetInputData(lod_levels_[static_cast<std::size_t>(level - 1)]);
+  actor_->SetMapper(lod_mapper_);
+#else
+  Q_UNUSED(level);
+#endif
+}
+
+void VtkViewer::on_render_event(bool start) {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!renderer_ || !mapper_ || !actor_) {
+    return;
+  }
+  auto* iren = render_window_->GetInteractor();
+  // The interactor raises the desired update rate while the camera moves
+  // and drops it back to the still rate for the final render.
+  const bool interacting =
+      iren && render_window_->GetDesiredUpdateRate() > iren->GetStillUpdateRate();
+  if (!start) {
+    lod_last_render_s_ = renderer_->GetLastRenderTimeInSeconds();
+    if (lod_level_ == 0 && !interacting) {
+      lod_full_render_s_ = lod_last_render_s_;
+    }
+    return;
+  }
+
+  // Re-validate the locators once the rendered geometry has settled.
+  if (vtkDataSet* input = mapper_->GetInput()) {
+    if (locator_timer_ && !locator_timer_->isActive() && !locator_thread_ &&
+        (input != locator_source_ ||
+         input->GetMTime() != locator_source_mtime_)) {
+      schedule_locator_build();
+    }
+  }
+
+  const bool enabled = lod_enable_ && lod_enable_->isChecked();
+  vtkDataSet* data = mapper_->GetInput();
+  const bool current = data && data == lod_source_ &&
+                       data->GetMTime() == lod_source_mtime_;
+  if (!enabled || !interacting || !current || lod_levels_.empty()) {
+    set_lod_level(0);
+    if (enabled && !current && !lod_thread_) {
+      schedule_lod_build();
+    }
+    update_lod_overlay();
+    return;
+  }
+  const double min_fps = lod_min_fps_ ? lod_min_fps_->value() : 20.0;
+  const vtkIdType threshold =
+      lod_face_threshold_ ? lod_face_threshold_->value() : 1000000;
+  const bool too_slow = lod_last_render_s_ * min_fps > 1.0;
+  if (lod_level_ == 0) {
+    if (lod_full_faces_ >= threshold || too_slow ||
+        lod_full_render_s_ * min_fps > 1.0) {
+      set_lod_level(1);
+    }
+  } else if (too_slow) {
+    set_lod_level(lod_level_ + 1);
+  }
+  update_lod_overlay();
+#else
+  Q_UNUSED(start);
+#endif
+}
+
+void VtkViewer::update_lod_overlay() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!renderer_) {
+    return;
+  }
+  const bool enabled =
+      lod_enable_ && lod_enable_->isChecked() && mapper_ && actor_;
+  if (!lod_text_) {
+    if (!enabled) {
+      return;
+    }
+    lod_text_ = vtkSmartPointer<vtkTextActor>::New();
+    lod_text_->SetPickable(0);
+    lod_text_->SetDisplayPosition(8, 8);
+    lod_text_->GetTextProperty()->SetFontSize(12);
+    lod_text_->GetTextProperty()->SetColor(0.8, 0.8, 0.8);
+    renderer_->AddActor2D(lod_text_);
+  }
+  lod_text_->SetVisibility(enabled ? 1 : 0);
+  if (!enabled) {
+    return;
+  }
+  QString text;
+  if (lod_level_ == 0) {
+    vtkDataSet* data = mapper_->GetInput();
+    text = QString("LOD full: %1 faces")
+               .arg(FormatFaceCount(data ? data->GetNumberOfCells() : 0));
+  } else {
+    text = QString("LOD %1/%2: %3 faces")
+               .arg(lod_level_)
+               .arg(lod_levels_.size())
+               .arg(FormatFaceCount(
+                   lod_levels_[static_cast<std::size_t>(lod_level_ - 1)]
+                       ->GetNumberOfCells()));
+  }
+  if (lod_last_render_s_ > 0.0) {
+    text += QString(" | %1 fps").arg(1.0 / lod_last_render_s_, 0, 'f', 1);
+  }
+  if (lod_thread_) {
+    text += " | building proxies";
+  }
+  lod_text_->SetInput(text.toUtf8().constData());
+#endif
+}
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+struct VtkViewer::LocatorBuild {
+  vtkSmartPointer<vtkDataSet> input;
+  vtkDataSet* source = nullptr;
+  vtkMTimeType mtime = 0;
+  std::uint64_t signature = 0;
+  vtkSmartPointer<vtkStaticPointLocator> points;
+  vtkSmartPointer<vtkStaticCellLocator> cells;
+  qint64 elapsed_ms = 0;
+};
+#endif
+
+void VtkViewer::schedule_locator_build() {
+  if (locator_timer_) {
+    locator_timer_->start();
+  }
+}
+
+void VtkViewer::start_locator_build() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!mapper_) {
+    return;
+  }
+  const bool wanted =
+      (mode_ == DataMode::Mesh && pick_enable_ && pick_enable_->isChecked()) ||
+      (mode_ == DataMode::Exodus && probe_enable_ &&
+       probe_enable_->isChecked());
+  vtkDataSet* data = mapper_->GetInput();
+  if (!wanted || !data || data->GetNumberOfCells() == 0) {
+    return;
+  }
+  if (locator_thread_) {
+    locator_rebuild_pending_ = true;
+    return;
+  }
+  if (auto* input = mapper_->GetInputAlgorithm()) {
+    input->Update();
+  }
+  data = mapper_->GetInput();
+  const std::uint64_t signature = GeometrySignature(data);
+  if (cell_locator_ && signature == locator_signature_) {
+    locator_source_ = data;
+    locator_source_mtime_ = data->GetMTime();
+    return;
+  }
+
+  auto build = std::make_shared<LocatorBuild>();
+  build->input.TakeReference(data->NewInstance());
+  build->input->ShallowCopy(data);
+  build->source = data;
+  build->mtime = data->GetMTime();
+  build->signature = signature;
+  locator_build_ = build;
+  locator_thread_ = QThread::create([build]() {
+    QElapsedTimer timer;
+    timer.start();
+    build->points = vtkSmartPointer<vtkStaticPointLocator>::New();
+    build->points->SetDataSet(build->input);
+    build->points->BuildLocator();
+    build->cells = vtkSmartPointer<vtkStaticCellLocator>::New();
+    build->cells->SetDataSet(build->input);
+    build->cells->BuildLocator();
+    build->elapsed_ms = timer.elapsed();
+  });
+  connect(locator_thread_, &QThread::finished, this,
+          &VtkViewer::on_locator_build_finished);
+  locator_thread_->start(QThread::LowPriority);
+#endif
+}
+
+void VtkViewer::on_locator_build_finished() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (locator_thread_) {
+    locator_thread_->deleteLater();
+    locator_thread_ = nullptr;
+  }
+  auto build = std::move(locator_build_);
+  if (locator_rebuild_pending_) {
+    locator_rebuild_pending_ = false;
+    schedule_locator_build();
+  }
+  if (!build || !build->cells) {
+    return;
+  }
+  // The locators keep the snapshot alive and answer for any input with the
+  // same signature; locator_current() checks that before each query.
+  point_locator_ = build->points;
+  cell_locator_ = build->cells;
+  locator_source_ = build->source;
+  locator_source_mtime_ = build->mtime;
+  locator_signature_ = build->signature;
+  locator_tolerance_ = 0.0005 * build->input->GetLength();
+  emit log_message(QString("Locators: %1 points, %2 cells in %3 ms")
+                       .arg(build->input->GetNumberOfPoints())
+                       .arg(build->input->GetNumberOfCells())
+                       .arg(build->elapsed_ms));
+#endif
+}
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+bool VtkViewer::locator_current() {
+  vtkDataSet* data = mapper_ ? mapper_->GetInput() : nullptr;
+  if (!data) {
+    return false;
+  }
+  if (cell_locator_ && data == locator_source_ &&
+      data->GetMTime() == locator_source_mtime_) {
+    return true;
+  }
+  if (cell_locator_ && GeometrySignature(data) == locator_signature_) {
+    // Same points and cells, e.g. a new time step without deformation.
+    locator_source_ = data;
+    locator_source_mtime_ = data->GetMTime();
+    return true;
+  }
+  if (!locator_thread_) {
+    schedule_locator_build();
+  }
+  return false;
+}
+
+vtkIdType VtkViewer::pick_cell(int x, int y, double pos[3]) {
+  if (!renderer_) {
+    return -1;
+  }
+  if (locator_current()) {
+    double ends[2][4];
+    for (int i = 0; i < 2; ++i) {
+      renderer_->SetDisplayPoint(x, y, static_cast<double>(i));
+      renderer_->DisplayToWorld();
+      renderer_->GetWorldPoint(ends[i]);
+      if (ends[i][3] != 0.0) {
+        for (int c = 0; c < 3; ++c) {
+          ends[i][c] /= ends[i][3];
+        }
       }
     }
-    reader_->Update();
-    geom_->Update();
+    double t = 0.0;
+    double pcoords[3] = {0.0, 0.0, 0.0};
+    int sub_id = 0;
+    vtkIdType cell = -1;
+    if (!cell_locator_->IntersectWithLine(ends[0], ends[1],
+                                          locator_tolerance_, t, pos,
+                                          pcoords, sub_id, cell)) {
+      return -1;
+    }
+    return cell;
+  }
+  if (!picker_) {
+    picker_ = vtkSmartPointer<vtkCellPicker>::New();
+    picker_->SetTolerance(0.0005);
+  }
+  // Overlays and glyphs are pickable too; their cell ids index other data.
+  if (!picker_->Pick(x, y, 0, renderer_) || picker_->GetActor() != actor_) {
+    return -1;
+  }
+  picker_->GetPickPosition(pos);
+  return picker_->GetCellId();
+}
+#endif
+
+void VtkViewer::update_pipeline() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!render_window_) {
+    return;
+  }
+  if (current_file_.isEmpty()) {
+    return;
+  }
+  if (!pipeline_ready_) {
+    return;
+  }
+  if (mode_ == DataMode::Exodus && reader_ && geom_) {
+    load_time_step();
     update_deformation_pipeline();
   } else if (mode_ == DataMode::Mesh) {
     update_mesh_pipeline();
@@ -1808,11 +3157,23 @@ void VtkViewer::populate_arrays() {
   array_combo_->blockSignals(true);
   array_combo_->clear();
 
+  // Exodus result arrays come from the file metadata, so arrays that are
+  // not loaded are listed too. Reader-generated arrays (ids) follow.
+  if (mode_ == DataMode::Exodus) {
+    for (const ExodusArray& info : exodus_arrays_) {
+      const QString name = info.key.mid(2);
+      array_combo_->addItem(
+          QString(info.key.startsWith("P:") ? "Point: %1" : "Cell: %1")
+              .arg(name),
+          info.key);
+    }
+  }
+
   auto* pd = data->GetPointData();
   if (pd) {
     for (int i = 0; i < pd->GetNumberOfArrays(); ++i) {
       const char* name = pd->GetArrayName(i);
-      if (name) {
+      if (name && array_combo_->findData(QString("P:%1").arg(name)) < 0) {
         array_combo_->addItem(QString("Point: %1").arg(name),
                               QString("P:%1").arg(name));
       }
@@ -1823,7 +3184,7 @@ void VtkViewer::populate_arrays() {
   if (cd) {
     for (int i = 0; i < cd->GetNumberOfArrays(); ++i) {
       const char* name = cd->GetArrayName(i);
-      if (name) {
+      if (name && array_combo_->findData(QString("C:%1").arg(name)) < 0) {
         array_combo_->addItem(QString("Cell: %1").arg(name),
                               QString("C:%1").arg(name));
       }
@@ -1877,6 +3238,17 @@ void VtkViewer::update_array_list() {
     }
     auto* item = new QListWidgetItem(array_combo_->itemText(i), array_list_);
     item->setData(Qt::UserRole, key);
+#ifdef GMP_ENABLE_VTK_VIEWER
+    if (mode_ == DataMode::Exodus && lazy_arrays_ &&
+        lazy_arrays_->isChecked() &&
+        std::any_of(exodus_arrays_.begin(), exodus_arrays_.end(),
+                    [&key](const ExodusArray& a) { return a.key == key; })) {
+      item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+      item->setCheckState(pinned_arrays_.contains(key) ? Qt::Checked
+                                                       : Qt::Unchecked);
+      item->setToolTip("Checked arrays stay loaded at every time step");
+    }
+#endif
     if (key == current) {
       array_list_->setCurrentItem(item);
       item->setSelected(true);
@@ -1969,6 +3341,29 @@ void VtkViewer::update_vector_tab() {
       }
     }
   }
+  if (mode_ == DataMode::Exodus) {
+    for (const ExodusArray& info : exodus_arrays_) {
+      if (info.components < 2 ||
+          vector_array_combo_->findData(info.key) >= 0) {
+        continue;
+      }
+      const QString name = info.key.mid(2);
+      const int idx = vector_array_combo_->count();
+      vector_array_combo_->addItem(
+          QString(info.key.startsWith("P:") ? "Point: %1" : "Cell: %1")
+              .arg(name),
+          info.key);
+      if (selected_index < 0 && info.key == prev) {
+        selected_index = idx;
+      }
+      if (best_index < 0) {
+        const QString lower_name = name.toLower();
+        if (lower_name.contains("disp") || lower_name.contains("displacement")) {
+          best_index = idx;
+        }
+      }
+    }
+  }
 
   int target_index = -1;
   if (!prev.isEmpty()) {
@@ -2009,11 +3404,19 @@ void VtkViewer::update_vector_tab() {
                  : nullptr;
   }
   if (!target) {
-    vector_info_->setText("No selectable vector array");
+    const bool declared =
+        mode_ == DataMode::Exodus &&
+        std::any_of(exodus_arrays_.begin(), exodus_arrays_.end(),
+                    [&key](const ExodusArray& a) { return a.key == key; });
+    vector_info_->setText(
+        declared ? QString("%1 is not loaded; check it under Variables to "
+                           "keep it loaded")
+                       .arg(name)
+                 : QString("No selectable vector array"));
     return;
   }
-  const VectorStats stats = AnalyzeVectorArray(target);
-  if (!stats.has_data) {
+  const ArrayStats& stats = array_stats(target, key);
+  if (!stats.has_data || stats.components < 2) {
     vector_info_->setText("Array must have 2+ components");
     return;
   }
@@ -2048,7 +3451,7 @@ void VtkViewer::update_vector_tab() {
 void VtkViewer::update_plot_view() {
 #ifndef GMP_ENABLE_VTK_VIEWER
   if (plot_view_) {
-    plot_view_->setPlainText("vtk disabled");
+    plot_view_->set_message("vtk disabled");
     if (plot_stats_) {
       plot_stats_->setText("vtk disabled");
     }
@@ -2062,6 +3465,47 @@ void VtkViewer::update_plot_view() {
     cached_plot_stats_ = QString::fromUtf8("No plot widget");
     return;
   }
+  auto show_message = [this](const QString& text, const QString& stats) {
+    plot_view_->set_message(text);
+    if (plot_stats_) {
+      plot_stats_->setText(stats);
+    }
+    cached_plot_text_ = text;
+    cached_plot_stats_ = stats;
+  };
+
+  if (plot_mode_ && plot_mode_->currentData().toInt() == 1) {
+    const TimeHistory& history = history_->result();
+    if (!history.ok) {
+      show_message(history_->running() ? "Extracting time history..."
+                                       : "No time history; press Extract",
+                   "History: none");
+      return;
+    }
+    plot_view_->set_series(history.times, history.values, history.label);
+    const int index = time_slider_ ? time_slider_->value() : -1;
+    if (index >= 0 && index < static_cast<int>(time_steps_.size())) {
+      plot_view_->set_marker(time_steps_[static_cast<std::size_t>(index)]);
+    }
+    QStringList lines;
+    lines << QString("History: %1").arg(history.label);
+    lines << history.cost_text();
+    lines << "";
+    lines << "Time\tValue\tms";
+    for (std::size_t i = 0; i < history.values.size(); ++i) {
+      lines << QString("%1\t%2\t%3")
+                   .arg(history.times[i], 0, 'g', 6)
+                   .arg(history.values[i], 0, 'g', 6)
+                   .arg(history.step_ms[i], 0, 'f', 2);
+    }
+    cached_plot_text_ = lines.join('\n');
+    if (plot_stats_) {
+      plot_stats_->setText(QString("history: %1 steps").arg(history.values.size()));
+    }
+    cached_plot_stats_ = plot_stats_ ? plot_stats_->text() : QString("No stats");
+    return;
+  }
+
   vtkDataSet* data = nullptr;
   if (mode_ == DataMode::Exodus && mapper_) {
     data = vtkDataSet::SafeDownCast(mapper_->GetInput());
@@ -2077,12 +3521,7 @@ void VtkViewer::update_plot_view() {
     }
   }
   if (!data) {
-    plot_view_->setPlainText("No data");
-    if (plot_stats_) {
-      plot_stats_->setText("No data");
-    }
-    cached_plot_text_ = QString::fromUtf8("No data");
-    cached_plot_stats_ = QString::fromUtf8("No data");
+    show_message("No data", "No data");
     return;
   }
 
@@ -2094,12 +3533,7 @@ void VtkViewer::update_plot_view() {
     key = vector_array_combo_->currentData().toString();
   }
   if (key.isEmpty()) {
-    plot_view_->setPlainText("No array selected");
-    if (plot_stats_) {
-      plot_stats_->setText("No array selected");
-    }
-    cached_plot_text_ = QString::fromUtf8("No array selected");
-    cached_plot_stats_ = QString::fromUtf8("No array selected");
+    show_message("No array selected", "No array selected");
     return;
   }
 
@@ -2116,88 +3550,171 @@ void VtkViewer::update_plot_view() {
                 : nullptr;
   }
   if (!array) {
-    plot_view_->setPlainText("Selected array not found");
-    if (plot_stats_) {
-      plot_stats_->setText("Invalid array");
-    }
-    cached_plot_text_ = QString::fromUtf8("Selected array not found");
-    cached_plot_stats_ = QString::fromUtf8("Invalid array");
+    show_message("Selected array not found", "Invalid array");
     return;
   }
 
+  // The stats pass (memoized) gives the bin range; binning is a second
+  // parallel pass over the same values.
   const int comps = array->GetNumberOfComponents();
   const vtkIdType tuples = array->GetNumberOfTuples();
-  const vtkIdType limit = std::min<vtkIdType>(
-      tuples, static_cast<vtkIdType>(500));
+  const ArrayStats& stats = array_stats(array, key);
+  if (!stats.has_data) {
+    show_message("Selected array is empty", "No data");
+    return;
+  }
+  const int bins = plot_bins_ ? plot_bins_->value() : 64;
+  const ArrayHistogram histogram = ComputeArrayHistogram(
+      array, bins, stats.value_min(), stats.value_max());
+  const QString quantity = comps > 1 ? QString("|%1|").arg(key.mid(2))
+                                     : key.mid(2);
+  plot_view_->set_histogram(histogram.counts, histogram.lo, histogram.hi,
+                            QString("%1 (%2 tuples)").arg(quantity).arg(tuples));
+
   QStringList lines;
   lines << QString("Array: %1").arg(key);
   lines << QString("Components: %1").arg(comps);
   lines << QString("Tuples: %1").arg(tuples);
+  lines << QString("%1 stats: min=%2 max=%3 mean=%4 rms=%5")
+               .arg(comps > 1 ? "Magnitude" : "Scalar")
+               .arg(comps > 1 ? stats.min_mag : stats.min, 0, 'g', 6)
+               .arg(comps > 1 ? stats.max_mag : stats.max, 0, 'g', 6)
+               .arg(comps > 1 ? stats.mean_mag : stats.mean, 0, 'g', 6)
+               .arg(comps > 1 ? stats.rms_mag : stats.rms, 0, 'g', 6);
+  lines << QString("Stats pass: %1 ms, binning: %2 ms")
+               .arg(stats.compute_ms, 0, 'f', 2)
+               .arg(histogram.compute_ms, 0, 'f', 2);
+  lines << "";
+  lines << "Bin low\tBin high\tCount";
+  const double width =
+      bins > 0 ? (histogram.hi - histogram.lo) / static_cast<double>(bins) : 0.0;
+  for (std::size_t b = 0; b < histogram.counts.size(); ++b) {
+    const double low = histogram.lo + width * static_cast<double>(b);
+    lines << QString("%1\t%2\t%3")
+                 .arg(low, 0, 'g', 6)
+                 .arg(low + width, 0, 'g', 6)
+                 .arg(histogram.counts[b]);
+  }
+  cached_plot_text_ = lines.join('\n');
+  if (plot_stats_) {
+    plot_stats_->setText(QString("mode=%1 tuples=%2 bins=%3 | %4 ms")
+                             .arg(mode_ == DataMode::Mesh ? "mesh" : "exodus")
+                             .arg(tuples)
+                             .arg(bins)
+                             .arg(histogram.compute_ms, 0, 'f', 2));
+  }
+  cached_plot_stats_ = plot_stats_ ? plot_stats_->text() : QString("No stats");
+}
 
-  double min_v = std::numeric_limits<double>::infinity();
-  double max_v = -std::numeric_limits<double>::infinity();
-  double mean_acc = 0.0;
-  double rms_acc = 0.0;
-  for (vtkIdType i = 0; i < tuples; ++i) {
-    const double v = (comps > 1) ? ComputeMagnitude(array, i)
-                                 : array->GetComponent(i, 0);
-    min_v = std::min(min_v, v);
-    max_v = std::max(max_v, v);
-    mean_acc += v;
-    rms_acc += v * v;
-  }
-  if (tuples > 0) {
-    const double mean = mean_acc / static_cast<double>(tuples);
-    const double rms = std::sqrt(rms_acc / static_cast<double>(tuples));
-    if (comps > 1) {
-      lines << QString("Magnitude stats: min=%1 max=%2 mean=%3 rms=%4")
-                   .arg(min_v, 0, 'g', 6)
-                   .arg(max_v, 0, 'g', 6)
-                   .arg(mean, 0, 'g', 6)
-                   .arg(rms, 0, 'g', 6);
-    } else {
-      lines << QString("Scalar stats: min=%1 max=%2 mean=%3 rms=%4")
-                   .arg(min_v, 0, 'g', 6)
-                   .arg(max_v, 0, 'g', 6)
-                   .arg(mean, 0, 'g', 6)
-                   .arg(rms, 0, 'g', 6);
-    }
+void VtkViewer::update_history_sources() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!plot_source_) {
+    return;
   }
-  lines << "";
-  lines << QString("Preview (first %1 rows)").arg(limit);
-  for (vtkIdType i = 0; i < limit; ++i) {
-    if (comps <= 1) {
-      lines << QString("%1: %2").arg(i).arg(array->GetComponent(i, 0), 0, 'g', 6);
-    } else {
-      lines << QString("%1: %2").arg(i).arg(ArrayValueSample(array, i));
+  const QString current = plot_source_->currentData().toString();
+  plot_source_->blockSignals(true);
+  plot_source_->clear();
+  plot_source_->addItem(
+      probe_id_ >= 0 ? QString("Probed %1 %2 (%3)")
+                           .arg(probe_is_point_ ? "point" : "cell")
+                           .arg(probe_id_)
+                           .arg(probe_array_)
+                     : QString("Probed point/cell"),
+      QString());
+  if (mode_ == DataMode::Exodus && reader_) {
+    const int count =
+        reader_->GetNumberOfObjectArrays(vtkExodusIIReader::GLOBAL);
+    for (int i = 0; i < count; ++i) {
+      if (const char* name =
+              reader_->GetObjectArrayName(vtkExodusIIReader::GLOBAL, i)) {
+        plot_source_->addItem(QString("Global: %1").arg(name),
+                              QString::fromUtf8(name));
+      }
     }
   }
-  if (tuples > limit) {
-    lines << QString("... %1 rows omitted ...").arg(tuples - limit);
+  const int index = plot_source_->findData(current);
+  plot_source_->setCurrentIndex(index >= 0 ? index : 0);
+  plot_source_->blockSignals(false);
+#endif
+}
+
+void VtkViewer::start_time_history() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (mode_ != DataMode::Exodus || !reader_ || time_steps_.empty()) {
+    plot_history_info_->setText("History: needs an Exodus file with time steps");
+    return;
   }
-  plot_view_->setPlainText(lines.join('\n'));
-  if (plot_stats_) {
-    plot_stats_->setText(QString("mode=%1 tuples=%2").arg(mode_ == DataMode::Mesh ? "mesh"
-                                                                              : "exodus")
-                                                  .arg(tuples));
+  TimeHistoryRequest request;
+  const QString global = plot_source_->currentData().toString();
+  if (!global.isEmpty()) {
+    request.source = TimeHistoryRequest::Source::Global;
+    request.array = global.toStdString();
+    request.label = global;
+  } else if (probe_id_ >= 0) {
+    request.source = probe_is_point_ ? TimeHistoryRequest::Source::Point
+                                     : TimeHistoryRequest::Source::Cell;
+    request.array = probe_array_.toStdString();
+    request.id = probe_id_;
+    request.label = QString("%1 at %2 %3")
+                        .arg(probe_array_)
+                        .arg(probe_is_point_ ? "point" : "cell")
+                        .arg(probe_id_);
+  } else {
+    plot_history_info_->setText(
+        "History: probe a point or cell first (Probe tab)");
+    return;
   }
-  cached_plot_text_ = lines.join('\n');
-  cached_plot_stats_ = plot_stats_ ? plot_stats_->text() : QString("No stats");
+  request.spec = ExodusReadSpec::Capture(reader_, current_file_);
+  request.times = time_steps_;
+  history_->start(request);
+  plot_history_info_->setText(
+      QString("History: extracting %1 (%2 steps)")
+          .arg(request.label)
+          .arg(request.times.size()));
+  if (plot_mode_) {
+    plot_mode_->setCurrentIndex(plot_mode_->findData(1));
+  }
+  update_plot_view();
+#endif
+}
+
+void VtkViewer::on_time_history_finished() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  const TimeHistory& history = history_->result();
+  if (!history.ok) {
+    plot_history_info_->setText(QString("History: %1").arg(history.error));
+    emit log_message(QString("Time history failed: %1").arg(history.error));
+    update_plot_view();
+    return;
+  }
+  plot_history_info_->setText(
+      QString("History: %1 | %2").arg(history.label).arg(history.cost_text()));
+  emit log_message(QString("Time history %1: %2")
+                       .arg(history.label)
+                       .arg(history.cost_text()));
+  update_plot_view();
+#endif
+}
+
+#ifdef GMP_ENABLE_VTK_VIEWER
+const ArrayStats& VtkViewer::array_stats(vtkDataArray* array,
+                                         const QString& key) {
+  const int step =
+      mode_ == DataMode::Exodus && time_slider_ ? time_slider_->value() : -1;
+  return array_stats_.get(array, key, step);
 }
+#endif
 
 void VtkViewer::update_table_view() {
 #ifndef GMP_ENABLE_VTK_VIEWER
-  if (table_view_) {
-    table_view_->setRowCount(0);
-    if (table_stats_) {
-      table_stats_->setText("vtk disabled");
-    }
+  if (table_stats_) {
+    table_stats_->setText("vtk disabled");
   }
   cached_table_text_ = QString::fromUtf8("vtk disabled");
   cached_table_stats_ = QString::fromUtf8("vtk disabled");
   return;
 #endif
-  if (!table_view_) {
+  if (!table_view_ || !table_model_) {
     cached_table_text_ = QString::fromUtf8("No table widget");
     cached_table_stats_ = QString::fromUtf8("No table widget");
     return;
@@ -2217,7 +3734,7 @@ void VtkViewer::update_table_view() {
     }
   }
   if (!data) {
-    table_view_->setRowCount(0);
+    table_model_->clear();
     if (table_stats_) {
       table_stats_->setText("No data");
     }
@@ -2234,7 +3751,7 @@ void VtkViewer::update_table_view() {
     key = vector_array_combo_->currentData().toString();
   }
   if (key.isEmpty()) {
-    table_view_->setRowCount(0);
+    table_model_->clear();
     if (table_stats_) {
       table_stats_->setText("No array selected");
     }
@@ -2256,7 +3773,7 @@ void VtkViewer::update_table_view() {
                 : nullptr;
   }
   if (!array) {
-    table_view_->setRowCount(0);
+    table_model_->clear();
     if (table_stats_) {
       table_stats_->setText("Invalid array");
     }
@@ -2265,56 +3782,33 @@ void VtkViewer::update_table_view() {
     return;
   }
 
+  const bool new_key = table_model_->key() != key;
+  table_model_->set_array(array, key);
+  if (new_key) {
+    table_view_->resizeColumnsToContents();
+  }
+
+  // The snapshot follows the view's sort order.
   const int comps = array->GetNumberOfComponents();
   const vtkIdType tuples = array->GetNumberOfTuples();
   const int show_rows =
       qBound(1, table_rows_spin_ ? table_rows_spin_->value() : 100, 5000);
-  const vtkIdType rows = std::min<vtkIdType>(tuples, show_rows);
-
+  const int rows = std::min(table_model_->rowCount(), show_rows);
+  const int columns = table_model_->columnCount();
   QStringList headers;
-  headers << "Index";
-  for (int i = 0; i < comps; ++i) {
-    headers << QString("C%1").arg(i);
-  }
-  if (comps > 1) {
-    headers << "Magnitude";
-  }
-  table_view_->setColumnCount(headers.size());
-  table_view_->setHorizontalHeaderLabels(headers);
-  table_view_->setRowCount(static_cast<int>(rows));
-
-  for (vtkIdType i = 0; i < rows; ++i) {
-    const int row = static_cast<int>(i);
-    table_view_->setItem(row, 0,
-                         new QTableWidgetItem(QString::number(i)));
-    double m = 0.0;
-    if (comps > 1) {
-      m = ComputeMagnitude(array, i);
-    }
-    for (int c = 0; c < comps; ++c) {
-      table_view_->setItem(
-          row, c + 1,
-          new QTableWidgetItem(QString::number(array->GetComponent(i, c), 'g', 6)));
-    }
-    if (comps > 1) {
-      const int mag_col = static_cast<int>(headers.size()) - 1;
-      table_view_->setItem(row, mag_col,
-                           new QTableWidgetItem(QString::number(m, 'g', 6)));
-    }
+  for (int c = 0; c < columns; ++c) {
+    headers << table_model_->headerData(c, Qt::Horizontal).toString();
   }
-  table_view_->resizeColumnsToContents();
   QStringList text_rows;
   text_rows << QString("Array: %1").arg(key);
   text_rows << QString("Tuples: %1").arg(tuples);
   text_rows << QString("Showing rows: %1").arg(rows);
   text_rows << "";
   text_rows << headers.join('\t');
-  for (vtkIdType i = 0; i < rows; ++i) {
+  for (int row = 0; row < rows; ++row) {
     QStringList row_text;
-    row_text << QString::number(i);
-    for (int c = 0; c < table_view_->columnCount() - 1; ++c) {
-      auto* item = table_view_->item(static_cast<int>(i), c);
-      row_text << (item ? item->text() : QString());
+    for (int c = 0; c < columns; ++c) {
+      row_text << table_model_->data(table_model_->index(row, c)).toString();
     }
     text_rows << row_text.join('\t');
   }
@@ -2323,33 +3817,48 @@ void VtkViewer::update_table_view() {
   }
   cached_table_text_ = text_rows.join('\n');
   if (table_stats_) {
+    QString text = QString("tuples=%1, components=%2").arg(tuples).arg(comps);
     if (comps > 1) {
-      VectorStats stats = AnalyzeVectorArray(array);
+      const ArrayStats& stats = array_stats(array, key);
       if (stats.has_data) {
-        table_stats_->setText(
-            QString("mode=%1, tuples=%2, show=%3, %4")
-                .arg(mode_ == DataMode::Mesh ? "mesh" : "exodus")
-                .arg(tuples)
-                .arg(rows)
-                .arg(FormatVectorStatsText(stats)));
-      } else {
-        table_stats_->setText(
-            QString("tuples=%1, show=%2, components=%3")
-                .arg(tuples)
-                .arg(rows)
-                .arg(comps));
+        text = QString("mode=%1, tuples=%2, %3")
+                   .arg(mode_ == DataMode::Mesh ? "mesh" : "exodus")
+                   .arg(tuples)
+                   .arg(FormatVectorStatsText(stats));
       }
-    } else {
-      table_stats_->setText(
-          QString("tuples=%1, show=%2, components=%3")
-              .arg(tuples)
-              .arg(rows)
-              .arg(comps));
     }
+    if (table_model_->last_sort_ms() > 0.0) {
+      text += QString(", sort=%1 ms").arg(table_model_->last_sort_ms(), 0, 'f', 1);
+    }
+    table_stats_->setText(text);
   }
   cached_table_stats_ = table_stats_ ? table_stats_->text() : QString("No stats");
 }
 
+void VtkViewer::jump_to_table_extreme(bool maximum) {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!table_view_ || !table_model_ || !table_model_->array()) {
+    return;
+  }
+  const ArrayStats& stats =
+      array_stats(table_model_->array(), table_model_->key());
+  const vtkIdType tuple = maximum ? stats.arg_max : stats.arg_min;
+  const int row = table_model_->row_of(tuple);
+  if (row < 0) {
+    return;
+  }
+  const QModelIndex index = table_model_->index(row, 0);
+  table_view_->scrollTo(index, QAbstractItemView::PositionAtCenter);
+  table_view_->selectRow(row);
+  emit log_message(QString("Table: %1 %2 at tuple %3")
+                       .arg(table_model_->key())
+                       .arg(maximum ? "max" : "min")
+                       .arg(tuple));
+#else
+  Q_UNUSED(maximum);
+#endif
+}
+
 void VtkViewer::update_vector_list() {
 #ifdef GMP_ENABLE_VTK_VIEWER
   if (!deform_vector_) {
@@ -2384,6 +3893,19 @@ void VtkViewer::update_vector_list() {
   int best_index = -1;
   deform_vector_->blockSignals(true);
   deform_vector_->clear();
+  for (const ExodusArray& info : exodus_arrays_) {
+    if (!info.key.startsWith("P:") || info.components < 2) {
+      continue;
+    }
+    const QString label = info.key.mid(2);
+    const int idx = deform_vector_->count();
+    deform_vector_->addItem(label, label);
+    const QString lower = label.toLower();
+    if (best_index < 0 &&
+        (lower.contains("disp") || lower.contains("displacement"))) {
+      best_index = idx;
+    }
+  }
   for (int i = 0; i < pd->GetNumberOfArrays(); ++i) {
     vtkDataArray* arr = pd->GetArray(i);
     if (!arr) {
@@ -2397,6 +3919,9 @@ void VtkViewer::update_vector_list() {
       continue;
     }
     const QString label = QString::fromUtf8(name);
+    if (deform_vector_->findData(label) >= 0) {
+      continue;
+    }
     const int idx = deform_vector_->count();
     deform_vector_->addItem(label, label);
     const QString lower = label.toLower();
@@ -2429,17 +3954,18 @@ void VtkViewer::update_deformation_pipeline() {
   if (mode_ != DataMode::Exodus || !mapper_ || !geom_) {
     return;
   }
+  sync_exodus_array_status();
   const bool enabled = deform_enable_ && deform_enable_->isChecked();
   const QString vector_name =
       deform_vector_ ? deform_vector_->currentData().toString() : "";
   if (!enabled || vector_name.isEmpty()) {
-    mapper_->SetInputConnection(geom_->GetOutputPort());
+    mapper_->SetInputData(time_surface_);
     return;
   }
   if (!warp_filter_) {
     warp_filter_ = vtkSmartPointer<vtkWarpVector>::New();
   }
-  warp_filter_->SetInputConnection(geom_->GetOutputPort());
+  warp_filter_->SetInputData(time_surface_);
   warp_filter_->SetScaleFactor(
       deform_scale_ ? deform_scale_->value() : 1.0);
   warp_filter_->SetInputArrayToProcess(
@@ -2633,17 +4159,419 @@ void VtkViewer::refresh_time_only() {
   if (current_file_.isEmpty() || !pipeline_ready_) {
     return;
   }
-  if (!time_steps_.empty()) {
-    vtkInformation* info = reader_->GetOutputInformation(0);
-    if (info) {
-      const int idx = time_slider_->value();
-      const double t = time_steps_[idx];
-      info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), t);
+  load_time_step();
+  render_window_->Render();
+#endif
+}
+
+void VtkViewer::load_time_step() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!reader_ || !geom_ || !time_surface_) {
+    return;
+  }
+  if (time_steps_.empty()) {
+    {
+      std::lock_guard<std::mutex> io(ExodusIoMutex());
+      reader_->Update();
+      geom_->Update();
     }
+    time_surface_->ShallowCopy(geom_->GetOutput());
+    return;
+  }
+  const int idx = time_slider_->value();
+  vtkSmartPointer<vtkPolyData> surface = step_cache_->lookup(idx);
+  if (!surface) {
+    QElapsedTimer timer;
+    timer.start();
+    {
+      std::lock_guard<std::mutex> io(ExodusIoMutex());
+      vtkInformation* info = reader_->GetOutputInformation(0);
+      if (info) {
+        info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(),
+                  time_steps_[idx]);
+      }
+      reader_->Update();
+      geom_->Update();
+    }
+    surface = vtkSmartPointer<vtkPolyData>::New();
+    surface->ShallowCopy(geom_->GetOutput());
+    step_cache_->insert(idx, surface);
+    const double ms = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+    if (ms > 200.0) {
+      emit log_message(QString("Time step %1 read in %2 ms (cache miss)")
+                           .arg(idx)
+                           .arg(ms, 0, 'f', 1));
+    }
+  }
+  time_surface_->ShallowCopy(surface);
+
+  // Read ahead in the direction the slider last moved; playback wraps
+  // around but always moves forward.
+  const bool playing = play_timer_ && play_timer_->isActive();
+  const int direction =
+      playing ? 1
+              : (last_time_index_ < 0 ? 0
+                                      : (idx >= last_time_index_ ? 1 : -1));
+  last_time_index_ = idx;
+  step_cache_->prefetch(idx, direction);
+  update_step_cache_info();
+#endif
+}
+
+void VtkViewer::apply_exodus_selection() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!reader_) {
+    return;
+  }
+  // A selection saved for another model matches none of these blocks;
+  // fall back to the reader defaults then.
+  bool matches = false;
+  for (int i = 0;
+       i < reader_->GetNumberOfObjects(vtkExodusIIReader::ELEM_BLOCK); ++i) {
+    if (exodus_selection_.contains(
+            ExodusObjectKey(reader_, kExodusObjectKinds[0], i))) {
+      matches = true;
+      break;
+    }
+  }
+  for (const ExodusObjectKind& kind : kExodusObjectKinds) {
+    const int count = reader_->GetNumberOfObjects(kind.type);
+    for (int i = 0; i < count; ++i) {
+      const int status =
+          matches ? (exodus_selection_.contains(ExodusObjectKey(reader_, kind, i))
+                         ? 1
+                         : 0)
+                  : (kind.type == vtkExodusIIReader::ELEM_BLOCK ? 1 : 0);
+      reader_->SetObjectStatus(kind.type, i, status);
+    }
+  }
+  if (!matches) {
+    exodus_selection_.clear();
+  }
+#endif
+}
+
+void VtkViewer::update_block_list() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!block_list_) {
+    return;
+  }
+  block_list_->blockSignals(true);
+  block_list_->clear();
+  int blocks = 0;
+  int blocks_on = 0;
+  int sets_on = 0;
+  if (mode_ == DataMode::Exodus && reader_) {
+    for (const ExodusObjectKind& kind : kExodusObjectKinds) {
+      const int count = reader_->GetNumberOfObjects(kind.type);
+      for (int i = 0; i < count; ++i) {
+        const QString key = ExodusObjectKey(reader_, kind, i);
+        const bool on = reader_->GetObjectStatus(kind.type, i) != 0;
+        auto* item = new QListWidgetItem(
+            QString("%1: %2 (%3)")
+                .arg(kind.label)
+                .arg(key.mid(2))
+                .arg(reader_->GetNumberOfEntriesInObject(kind.type, i)),
+            block_list_);
+        item->setData(Qt::UserRole, key);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(on ? Qt::Checked : Qt::Unchecked);
+        if (kind.type == vtkExodusIIReader::ELEM_BLOCK) {
+          ++blocks;
+          blocks_on += on ? 1 : 0;
+        } else {
+          sets_on += on ? 1 : 0;
+        }
+      }
+    }
+  }
+  block_list_->blockSignals(false);
+  const bool enabled = block_list_->count() > 0;
+  block_list_->setEnabled(enabled);
+  block_all_->setEnabled(enabled);
+  block_none_->setEnabled(enabled);
+  block_info_->setText(
+      enabled ? QString("Blocks: %1 of %2 read, %3 sets").arg(blocks_on)
+                    .arg(blocks)
+                    .arg(sets_on)
+              : QString("Blocks: no Exodus file"));
+#endif
+}
+
+void VtkViewer::on_block_item_changed() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (mode_ != DataMode::Exodus || !reader_ || !block_list_) {
+    return;
+  }
+  QStringList selection;
+  bool changed = false;
+  int item_index = 0;
+  for (const ExodusObjectKind& kind : kExodusObjectKinds) {
+    const int count = reader_->GetNumberOfObjects(kind.type);
+    for (int i = 0; i < count && item_index < block_list_->count();
+         ++i, ++item_index) {
+      QListWidgetItem* item = block_list_->item(item_index);
+      const int status = item->checkState() == Qt::Checked ? 1 : 0;
+      if (status) {
+        selection << item->data(Qt::UserRole).toString();
+      }
+      if (reader_->GetObjectStatus(kind.type, i) != status) {
+        reader_->SetObjectStatus(kind.type, i, status);
+        changed = true;
+      }
+    }
+  }
+  exodus_selection_ = selection;
+  update_block_list();
+  if (!changed) {
+    return;
+  }
+  // Cached steps hold the old subset.
+  step_cache_->reset(ExodusReadSpec::Capture(reader_, current_file_),
+                     time_steps_);
+  last_time_index_ = -1;
+  QElapsedTimer timer;
+  timer.start();
+  load_time_step();
+  const vtkIdType cells =
+      time_surface_ ? time_surface_->GetNumberOfCells() : 0;
+  emit log_message(QString("Exodus subset: %1 surface cells, step read in "
+                           "%2 ms")
+                       .arg(cells)
+                       .arg(timer.elapsed()));
+  update_scene_extras();
+  if (render_window_) {
+    render_window_->Render();
+  }
+#endif
+}
+
+void VtkViewer::read_exodus_array_info() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  exodus_arrays_.clear();
+  if (!reader_) {
+    return;
+  }
+  for (const int type :
+       {int(vtkExodusIIReader::NODAL), int(vtkExodusIIReader::ELEM_BLOCK)}) {
+    const QString prefix = type == vtkExodusIIReader::NODAL ? "P:" : "C:";
+    const int count = reader_->GetNumberOfObjectArrays(type);
+    for (int i = 0; i < count; ++i) {
+      const char* name = reader_->GetObjectArrayName(type, i);
+      if (!name) {
+        continue;
+      }
+      ExodusArray info;
+      info.key = prefix + QString::fromUtf8(name);
+      info.type = type;
+      info.index = i;
+      info.components = reader_->GetObjectArrayNumberOfComponents(type, i);
+      exodus_arrays_.push_back(info);
+    }
+  }
+  update_history_sources();
+#endif
+}
+
+bool VtkViewer::sync_exodus_array_status() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (mode_ != DataMode::Exodus || !reader_ || exodus_arrays_.empty()) {
+    return false;
+  }
+  const bool load_all = !lazy_arrays_ || !lazy_arrays_->isChecked();
+  QSet<QString> wanted = pinned_arrays_;
+  if (array_combo_) {
+    wanted.insert(array_combo_->currentData().toString());
+  }
+  if (deform_enable_ && deform_enable_->isChecked() && deform_vector_) {
+    wanted.insert("P:" + deform_vector_->currentData().toString());
+  }
+  bool changed = false;
+  int loaded = 0;
+  for (const ExodusArray& info : exodus_arrays_) {
+    const int status = load_all || wanted.contains(info.key) ? 1 : 0;
+    loaded += status;
+    if (reader_->GetObjectArrayStatus(info.type, info.index) != status) {
+      reader_->SetObjectArrayStatus(info.type,
+                                    info.key.mid(2).toUtf8().constData(),
+                                    status);
+      changed = true;
+    }
+  }
+  if (!changed) {
+    return false;
+  }
+  // Cached steps lack the arrays just enabled.
+  step_cache_->reset(ExodusReadSpec::Capture(reader_, current_file_),
+                     time_steps_);
+  last_time_index_ = -1;
+  QElapsedTimer timer;
+  timer.start();
+  load_time_step();
+  emit log_message(QString("Exodus arrays loaded: %1 of %2, step read in %3 ms")
+                       .arg(loaded)
+                       .arg(exodus_arrays_.size())
+                       .arg(timer.elapsed()));
+  return true;
+#else
+  return false;
+#endif
+}
+
+void VtkViewer::set_playing(bool playing) {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!play_timer_) {
+    return;
+  }
+  const qint64 count = static_cast<qint64>(time_steps_.size());
+  if (playing) {
+    if (mode_ != DataMode::Exodus || count < 2) {
+      play_btn_->blockSignals(true);
+      play_btn_->setChecked(false);
+      play_btn_->blockSignals(false);
+      return;
+    }
+    if (!play_loop_->isChecked() && time_slider_->value() >= count - 1) {
+      time_slider_->setValue(0);
+    }
+    play_origin_ = time_slider_->value();
+    play_position_ = play_origin_;
+    play_shown_ = 0;
+    play_dropped_ = 0;
+    play_last_shown_ms_ = 0;
+    play_clock_.start();
+    play_btn_->setText("Pause");
+    // Tick at twice the frame rate so a late frame is caught up quickly.
+    play_timer_->start(
+        std::max(1, static_cast<int>(500.0 / play_fps_->value())));
+    return;
+  }
+  if (!play_timer_->isActive()) {
+    return;
+  }
+  play_timer_->stop();
+  play_btn_->setText("Play");
+  play_info_->setText(QString("Playback: stopped, %1 shown, %2 dropped")
+                          .arg(play_shown_)
+                          .arg(play_dropped_));
+  update_vector_tab();
+  if (plot_view_) {
+    update_plot_view();
+  }
+  if (table_view_) {
+    update_table_view();
+  }
+#else
+  Q_UNUSED(playing);
+#endif
+}
+
+void VtkViewer::on_play_tick() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  const qint64 count = static_cast<qint64>(time_steps_.size());
+  if (mode_ != DataMode::Exodus || count < 2) {
+    play_btn_->setChecked(false);
+    return;
+  }
+  const qint64 now_ms = play_clock_.elapsed();
+  const bool loop = play_loop_->isChecked();
+  qint64 due = play_origin_ +
+               static_cast<qint64>(static_cast<double>(now_ms) *
+                                   play_fps_->value() / 1000.0);
+  if (!loop) {
+    due = std::min(due, count - 1);
+  }
+  if (due <= play_position_) {
+    return;
+  }
+
+  // Show the newest frame that is already decoded and count the rest as
+  // dropped. Reading on this thread would stall the UI, so that only
+  // happens when nothing has been shown for a second, e.g. with the cache
+  // disabled or smaller than one step.
+  const bool cached = step_cache_mb_ && step_cache_mb_->value() > 0;
+  qint64 next = -1;
+  if (cached) {
+    const qint64 oldest = std::max(play_position_, due - count);
+    for (qint64 pos = due; pos > oldest; --pos) {
+      if (step_cache_->peek(static_cast<int>(pos % count))) {
+        next = pos;
+        break;
+      }
+    }
+  }
+  if (next < 0) {
+    if (cached && now_ms - play_last_shown_ms_ < 1000) {
+      step_cache_->prefetch(static_cast<int>(due % count), 1);
+      return;
+    }
+    next = due;
+  }
+  play_dropped_ += next - play_position_ - 1;
+  play_position_ = next;
+  ++play_shown_;
+  play_last_shown_ms_ = now_ms;
+  time_slider_->setValue(static_cast<int>(next % count));
+  const double actual =
+      now_ms > 0 ? 1000.0 * static_cast<double>(play_shown_) / now_ms : 0.0;
+  play_info_->setText(QString("Playing: %1 fps target, %2 fps actual, %3 dropped")
+                          .arg(play_fps_->value(), 0, 'f', 1)
+                          .arg(actual, 0, 'f', 1)
+                          .arg(play_dropped_));
+  if (!loop && next >= count - 1) {
+    play_btn_->setChecked(false);
+  }
+#endif
+}
+
+bool VtkViewer::export_frames(const QString& directory) {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (directory.isEmpty() || !exporter_ || exporter_->running()) {
+    return false;
+  }
+  if (mode_ != DataMode::Exodus || !reader_ || time_steps_.empty() ||
+      !render_window_ || !renderer_ || !mapper_) {
+    return false;
+  }
+  FrameExporter::Options options;
+  options.spec = ExodusReadSpec::Capture(reader_, current_file_);
+  options.times = time_steps_;
+  options.directory = directory;
+  options.prefix = QFileInfo(current_file_).completeBaseName();
+  if (deform_enable_ && deform_enable_->isChecked() && deform_vector_) {
+    options.warp_vector = deform_vector_->currentData().toString();
+    options.warp_scale = deform_scale_ ? deform_scale_->value() : 1.0;
+  }
+  const int* size = render_window_->GetSize();
+  options.width = size[0];
+  options.height = size[1];
+  // The read, warp and render stages take about three cores.
+  options.encoders = std::clamp(QThread::idealThreadCount() - 3, 1,
+                                FrameExporter::kMaxEncoders);
+  if (play_btn_) {
+    play_btn_->setChecked(false);
+  }
+  if (!exporter_->start(options, renderer_, mapper_, actor_, scalar_bar_,
+                        step_cache_)) {
+    emit log_message("Frame export could not start: " + directory);
+    return false;
+  }
+  export_btn_->setText("Cancel Export");
+  emit log_message(QString("Exporting %1 frames to %2")
+                       .arg(time_steps_.size())
+                       .arg(directory));
+  return true;
+#else
+  Q_UNUSED(directory);
+  return false;
+#endif
+}
+
+void VtkViewer::update_step_cache_info() {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (step_cache_info_ && step_cache_) {
+    step_cache_info_->setText(step_cache_->stats_text());
   }
-  reader_->Update();
-  geom_->Update();
-  render_window_->Render();
 #endif
 }
 
@@ -2653,7 +4581,11 @@ void VtkViewer::update_time_steps_from_reader(bool keep_index) {
     return;
   }
   const int prev_index = time_slider_->value();
-  reader_->UpdateInformation();
+  {
+    std::lock_guard<std::mutex> io(ExodusIoMutex());
+    reader_->UpdateInformation();
+  }
+  read_exodus_array_info();
 
   time_steps_.clear();
   vtkInformation* info = reader_->GetOutputInformation(0);
@@ -2665,6 +4597,11 @@ void VtkViewer::update_time_steps_from_reader(bool keep_index) {
       time_steps_.push_back(steps[i]);
     }
   }
+  // Steps already read stay valid when the file grows, but a rewrite may
+  // change them; start over either way.
+  step_cache_->reset(ExodusReadSpec::Capture(reader_, current_file_),
+                     time_steps_);
+  last_time_index_ = -1;
 
   if (time_steps_.empty()) {
     time_slider_->setRange(0, 0);
@@ -2739,6 +4676,9 @@ void VtkViewer::update_mesh_controls() {
   if (pick_mode_) {
     pick_mode_->setEnabled(mesh_mode);
   }
+  if (pick_hover_) {
+    pick_hover_->setEnabled(mesh_mode);
+  }
   if (pick_clear_) {
     pick_clear_->setEnabled(mesh_mode);
   }
@@ -2751,6 +4691,9 @@ void VtkViewer::update_mesh_controls() {
   if (probe_mode_) {
     probe_mode_->setEnabled(exodus_mode);
   }
+  if (probe_follow_) {
+    probe_follow_->setEnabled(exodus_mode);
+  }
   if (probe_clear_) {
     probe_clear_->setEnabled(exodus_mode);
   }
@@ -2760,6 +4703,9 @@ void VtkViewer::update_mesh_controls() {
   if (deform_enable_) {
     deform_enable_->setEnabled(exodus_mode);
   }
+  if (block_list_ && !exodus_mode) {
+    update_block_list();
+  }
   if (deform_vector_) {
     deform_vector_->setEnabled(exodus_mode);
   }
@@ -2907,20 +4853,8 @@ void VtkViewer::update_mesh_pipeline() {
   if (!mesh_geom_) {
     mesh_geom_ = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
   }
-  if (!mesh_dim_threshold_) {
-    mesh_dim_threshold_ = vtkSmartPointer<vtkThreshold>::New();
-  }
-  if (!mesh_group_threshold_) {
-    mesh_group_threshold_ = vtkSmartPointer<vtkThreshold>::New();
-  }
-  if (!mesh_type_threshold_) {
-    mesh_type_threshold_ = vtkSmartPointer<vtkThreshold>::New();
-  }
-  if (!mesh_entity_dim_threshold_) {
-    mesh_entity_dim_threshold_ = vtkSmartPointer<vtkThreshold>::New();
-  }
-  if (!mesh_entity_tag_threshold_) {
-    mesh_entity_tag_threshold_ = vtkSmartPointer<vtkThreshold>::New();
+  if (!mesh_extract_) {
+    mesh_extract_ = vtkSmartPointer<vtkExtractCells>::New();
   }
   if (!mesh_slice_plane_) {
     mesh_slice_plane_ = vtkSmartPointer<vtkPlane>::New();
@@ -3004,59 +4938,34 @@ void VtkViewer::update_mesh_pipeline() {
     selected_entity_tag_ = -1;
   }
 
-  vtkAlgorithmOutput* current_port = nullptr;
-  if (dim_filter >= 0) {
-    mesh_dim_threshold_->SetInputData(mesh_grid_);
-    mesh_dim_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "phys_dim");
-    mesh_dim_threshold_->SetLowerThreshold(dim_filter);
-    mesh_dim_threshold_->SetUpperThreshold(dim_filter);
-    current_port = mesh_dim_threshold_->GetOutputPort();
-  }
-
+  MeshSelectionIndex::Query query;
+  query.dim = dim_filter;
   if (group_index >= 0 && group_id >= 0) {
-    if (current_port) {
-      mesh_group_threshold_->SetInputConnection(current_port);
-    } else {
-      mesh_group_threshold_->SetInputData(mesh_grid_);
-    }
-    mesh_group_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "phys_id");
-    mesh_group_threshold_->SetLowerThreshold(group_id);
-    mesh_group_threshold_->SetUpperThreshold(group_id);
-    current_port = mesh_group_threshold_->GetOutputPort();
+    query.phys_id = group_id;
   }
-
   if (entity_index >= 0 && entity_tag >= 0 && entity_dim >= 0) {
-    if (current_port) {
-      mesh_entity_dim_threshold_->SetInputConnection(current_port);
-    } else {
-      mesh_entity_dim_threshold_->SetInputData(mesh_grid_);
-    }
-    mesh_entity_dim_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "entity_dim");
-    mesh_entity_dim_threshold_->SetLowerThreshold(entity_dim);
-    mesh_entity_dim_threshold_->SetUpperThreshold(entity_dim);
-    mesh_entity_tag_threshold_->SetInputConnection(
-        mesh_entity_dim_threshold_->GetOutputPort());
-    mesh_entity_tag_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "entity_tag");
-    mesh_entity_tag_threshold_->SetLowerThreshold(entity_tag);
-    mesh_entity_tag_threshold_->SetUpperThreshold(entity_tag);
-    current_port = mesh_entity_tag_threshold_->GetOutputPort();
-  }
-
-  if (type_filter >= 0) {
-    if (current_port) {
-      mesh_type_threshold_->SetInputConnection(current_port);
-    } else {
-      mesh_type_threshold_->SetInputData(mesh_grid_);
-    }
-    mesh_type_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "elem_type");
-    mesh_type_threshold_->SetLowerThreshold(type_filter);
-    mesh_type_threshold_->SetUpperThreshold(type_filter);
-    current_port = mesh_type_threshold_->GetOutputPort();
+    query.entity_dim = entity_dim;
+    query.entity_tag = entity_tag;
+  }
+  query.elem_type = type_filter;
+
+  vtkAlgorithmOutput* current_port = nullptr;
+  if (!query.unrestricted()) {
+    if (!mesh_filter_applied_ || query != mesh_filter_query_) {
+      QElapsedTimer timer;
+      timer.start();
+      const vtkIdType selected =
+          ExtractIndexedCells(mesh_index_, query, mesh_grid_, mesh_extract_);
+      mesh_filter_query_ = query;
+      mesh_filter_applied_ = true;
+      emit log_message(QString("Mesh filter: %1 of %2 cells selected in %3ms")
+                           .arg(selected)
+                           .arg(mesh_grid_->GetNumberOfCells())
+                           .arg(static_cast<double>(timer.nsecsElapsed()) /
+                                    1.0e6,
+                                0, 'f', 2));
+    }
+    current_port = mesh_extract_->GetOutputPort();
   }
 
   if (current_port) {
@@ -3227,22 +5136,13 @@ void VtkViewer::handle_pick(int x, int y) {
   if (!renderer_ || !mapper_) {
     return;
   }
-  if (!picker_) {
-    picker_ = vtkSmartPointer<vtkCellPicker>::New();
-    picker_->SetTolerance(0.0005);
-  }
 
   if (mode_ == DataMode::Mesh) {
     if (!pick_enable_ || !pick_enable_->isChecked()) {
       return;
     }
-    if (!picker_->Pick(x, y, 0, renderer_)) {
-      if (pick_info_) {
-        pick_info_->setText("Pick: none");
-      }
-      return;
-    }
-    vtkIdType cell_id = picker_->GetCellId();
+    double pick_pos[3] = {0.0, 0.0, 0.0};
+    vtkIdType cell_id = pick_cell(x, y, pick_pos);
     if (cell_id < 0) {
       if (pick_info_) {
         pick_info_->setText("Pick: none");
@@ -3366,13 +5266,20 @@ void VtkViewer::handle_pick(int x, int y) {
   if (!probe_enable_ || !probe_enable_->isChecked()) {
     return;
   }
-  if (!picker_->Pick(x, y, 0, renderer_)) {
-    if (probe_info_) {
-      probe_info_->setText("Probe: none");
-    }
+  probe_at(x, y);
+#else
+  Q_UNUSED(x);
+  Q_UNUSED(y);
+#endif
+}
+
+void VtkViewer::probe_at(int x, int y) {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (!renderer_ || !mapper_) {
     return;
   }
-
+  QElapsedTimer lookup_timer;
+  lookup_timer.start();
   vtkDataSet* data = vtkDataSet::SafeDownCast(mapper_->GetInput());
   if (!data && geom_) {
     geom_->Update();
@@ -3384,14 +5291,20 @@ void VtkViewer::handle_pick(int x, int y) {
 
   const int probe_mode = probe_mode_ ? probe_mode_->currentData().toInt() : 0;
   const bool want_point = (probe_mode == 0);
-  vtkIdType cell_id = picker_->GetCellId();
-  vtkIdType point_id = picker_->GetPointId();
   double pos[3] = {0.0, 0.0, 0.0};
-  picker_->GetPickPosition(pos);
-
-  if (want_point && point_id < 0) {
-    point_id = data->FindPoint(pos);
+  const vtkIdType cell_id = pick_cell(x, y, pos);
+  vtkIdType point_id = -1;
+  if (want_point && cell_id >= 0) {
+    if (locator_current()) {
+      point_id = point_locator_->FindClosestPoint(pos);
+    } else if (picker_ && picker_->GetPointId() >= 0) {
+      point_id = picker_->GetPointId();
+    } else {
+      point_id = data->FindPoint(pos);
+    }
   }
+  const double lookup_ms =
+      static_cast<double>(lookup_timer.nsecsElapsed()) / 1.0e6;
   if (want_point && point_id < 0) {
     if (probe_info_) {
       probe_info_->setText("Probe: none");
@@ -3462,130 +5375,158 @@ void VtkViewer::handle_pick(int x, int y) {
   const QString mode_label = want_point ? "Point" : "Cell";
   const QString label = array_name.isEmpty() ? "value" : array_name;
   if (probe_info_) {
-    probe_info_->setText(QString("Probe (%1): id=%2 pos=(%3, %4, %5) %6=%7")
-                             .arg(mode_label)
-                             .arg(id)
-                             .arg(pos[0], 0, 'g', 6)
-                             .arg(pos[1], 0, 'g', 6)
-                             .arg(pos[2], 0, 'g', 6)
-                             .arg(label)
-                             .arg(value));
+    probe_info_->setText(
+        QString("Probe (%1): id=%2 pos=(%3, %4, %5) %6=%7 | lookup %8 ms")
+            .arg(mode_label)
+            .arg(id)
+            .arg(pos[0], 0, 'g', 6)
+            .arg(pos[1], 0, 'g', 6)
+            .arg(pos[2], 0, 'g', 6)
+            .arg(label)
+            .arg(value)
+            .arg(lookup_ms, 0, 'f', 3));
+  }
+  if (array && !array_name.isEmpty()) {
+    probe_id_ = id;
+    probe_is_point_ = want_point;
+    probe_array_ = array_name;
+    if (plot_source_) {
+      plot_source_->setItemText(
+          0, QString("Probed %1 %2 (%3)")
+                 .arg(want_point ? "point" : "cell")
+                 .arg(id)
+                 .arg(array_name));
+    }
   }
+#else
+  Q_UNUSED(x);
+  Q_UNUSED(y);
 #endif
 }
 
 
 void VtkViewer::update_selection_pipeline() {
 #ifdef GMP_ENABLE_VTK_VIEWER
-  if (!renderer_ || !mesh_grid_) {
-    return;
-  }
-  if (!pick_enable_ || !pick_enable_->isChecked()) {
-    if (mesh_select_actor_) {
-      mesh_select_actor_->SetVisibility(false);
-    }
+  if (!renderer_) {
     return;
   }
-  if (mode_ != DataMode::Mesh) {
-    if (mesh_select_actor_) {
-      mesh_select_actor_->SetVisibility(false);
-    }
-    return;
+  const bool active = mode_ == DataMode::Mesh && pick_enable_ &&
+                      pick_enable_->isChecked();
+  MeshSelectionIndex::Query query;
+  if (active) {
+    const int mode = pick_mode_ ? pick_mode_->currentData().toInt() : 0;
+    if (mode == 2) {
+      query.cell = selected_cell_id_;
+    } else if (mode == 1) {
+      if (selected_entity_dim_ >= 0 && selected_entity_tag_ >= 0) {
+        query.entity_dim = selected_entity_dim_;
+        query.entity_tag = selected_entity_tag_;
+      }
+    } else if (selected_group_dim_ >= 0 && selected_group_id_ >= 0) {
+      query.dim = selected_group_dim_;
+      query.phys_id = selected_group_id_;
+    }
+  }
+  const bool hover = active && pick_hover_ && pick_hover_->isChecked();
+  bool changed = update_highlight(&mesh_select_, query, kSelectColor);
+  // The surface may have been rebuilt; re-mask the hover preview over it.
+  changed |= update_highlight(
+      &mesh_hover_,
+      hover ? mesh_hover_.query : MeshSelectionIndex::Query(), kHoverColor);
+  if (changed && render_window_) {
+    render_window_->Render();
   }
+#endif
+}
 
-  const int mode = pick_mode_ ? pick_mode_->currentData().toInt() : 0;
-  if (mode == 2 && selected_cell_id_ < 0) {
-    if (mesh_select_actor_) {
-      mesh_select_actor_->SetVisibility(false);
-    }
-    return;
+#ifdef GMP_ENABLE_VTK_VIEWER
+bool VtkViewer::update_highlight(MeshHighlight* highlight,
+                                 const MeshSelectionIndex::Query& query,
+                                 const double color[3]) {
+  vtkDataSet* surface = nullptr;
+  if (!query.unrestricted() && mapper_ && mode_ == DataMode::Mesh) {
+    if (auto* input = mapper_->GetInputAlgorithm()) {
+      input->Update();
+    }
+    surface = mapper_->GetInput();
+  }
+  if (!surface) {
+    const bool was_visible =
+        highlight->actor && highlight->actor->GetVisibility();
+    if (highlight->actor) {
+      highlight->actor->SetVisibility(false);
+    }
+    highlight->query = query;
+    highlight->masked = false;
+    return was_visible;
+  }
+
+  const bool new_source = surface != highlight->source ||
+                          surface->GetMTime() != highlight->source_mtime;
+  if (!new_source && highlight->masked && query == highlight->query) {
+    return false;
   }
-  if (mode == 1 && (selected_entity_tag_ < 0 || selected_entity_dim_ < 0)) {
-    if (mesh_select_actor_) {
-      mesh_select_actor_->SetVisibility(false);
-    }
+  if (!highlight->actor) {
+    highlight->mapper = vtkSmartPointer<vtkDataSetMapper>::New();
+    highlight->mapper->ScalarVisibilityOff();
+    highlight->mapper->SetResolveCoincidentTopologyToPolygonOffset();
+    highlight->mapper->SetRelativeCoincidentTopologyPolygonOffsetParameters(
+        -1.0, -1.0);
+    highlight->actor = vtkSmartPointer<vtkActor>::New();
+    highlight->actor->SetMapper(highlight->mapper);
+    highlight->actor->PickableOff();
+    highlight->actor->GetProperty()->SetColor(color[0], color[1], color[2]);
+    highlight->actor->GetProperty()->SetLineWidth(2.0);
+    highlight->actor->GetProperty()->SetEdgeVisibility(1);
+    highlight->actor->GetProperty()->SetRepresentationToSurface();
+    renderer_->AddActor(highlight->actor);
+  }
+  if (new_source || !highlight->data) {
+    highlight->data.TakeReference(surface->NewInstance());
+    highlight->data->ShallowCopy(surface);
+    highlight->source = surface;
+    highlight->source_mtime = surface->GetMTime();
+    highlight->mapper->SetInputData(highlight->data);
+  }
+  MaskHighlightCells(highlight->data, query);
+  highlight->query = query;
+  highlight->masked = true;
+  highlight->actor->SetVisibility(true);
+  return true;
+}
+#endif
+
+void VtkViewer::handle_hover(int x, int y) {
+#ifdef GMP_ENABLE_VTK_VIEWER
+  if (mode_ != DataMode::Mesh || !renderer_ || !mapper_ || !pick_enable_ ||
+      !pick_enable_->isChecked()) {
     return;
   }
-  if (mode == 0 && (selected_group_id_ < 0 || selected_group_dim_ < 0)) {
-    if (mesh_select_actor_) {
-      mesh_select_actor_->SetVisibility(false);
+  MeshSelectionIndex::Query query;
+  vtkDataSet* data = mapper_->GetInput();
+  double pos[3] = {0.0, 0.0, 0.0};
+  if (data) {
+    const vtkIdType cell = pick_cell(x, y, pos);
+    const int mode = pick_mode_ ? pick_mode_->currentData().toInt() : 0;
+    if (cell >= 0 && mode == 2) {
+      query.cell = CellArrayValue(data, "cell_id", cell);
+    } else if (cell >= 0 && mode == 1) {
+      query.entity_dim = CellArrayValue(data, "entity_dim", cell);
+      query.entity_tag = CellArrayValue(data, "entity_tag", cell);
+    } else if (cell >= 0) {
+      query.dim = CellArrayValue(data, "phys_dim", cell);
+      query.phys_id = CellArrayValue(data, "phys_id", cell);
+      if (query.dim < 0 || query.phys_id < 0) {
+        query = MeshSelectionIndex::Query();
+      }
     }
-    return;
-  }
-
-  if (!mesh_select_dim_threshold_) {
-    mesh_select_dim_threshold_ = vtkSmartPointer<vtkThreshold>::New();
-  }
-  if (!mesh_select_group_threshold_) {
-    mesh_select_group_threshold_ = vtkSmartPointer<vtkThreshold>::New();
-  }
-  if (!mesh_select_cell_threshold_) {
-    mesh_select_cell_threshold_ = vtkSmartPointer<vtkThreshold>::New();
-  }
-  if (!mesh_select_entity_dim_threshold_) {
-    mesh_select_entity_dim_threshold_ = vtkSmartPointer<vtkThreshold>::New();
-  }
-  if (!mesh_select_entity_tag_threshold_) {
-    mesh_select_entity_tag_threshold_ = vtkSmartPointer<vtkThreshold>::New();
   }
-  if (!mesh_select_geom_) {
-    mesh_select_geom_ = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
-  }
-  if (!mesh_select_mapper_) {
-    mesh_select_mapper_ = vtkSmartPointer<vtkDataSetMapper>::New();
-  }
-  if (!mesh_select_actor_) {
-    mesh_select_actor_ = vtkSmartPointer<vtkActor>::New();
-    mesh_select_actor_->SetMapper(mesh_select_mapper_);
-    mesh_select_actor_->GetProperty()->SetColor(1.0, 0.9, 0.2);
-    mesh_select_actor_->GetProperty()->SetLineWidth(2.0);
-    mesh_select_actor_->GetProperty()->SetEdgeVisibility(1);
-    mesh_select_actor_->GetProperty()->SetRepresentationToSurface();
-    renderer_->AddActor(mesh_select_actor_);
-  }
-
-  vtkAlgorithmOutput* current = nullptr;
-  if (mode == 2) {
-    mesh_select_cell_threshold_->SetInputData(mesh_grid_);
-    mesh_select_cell_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "cell_id");
-    mesh_select_cell_threshold_->SetLowerThreshold(selected_cell_id_);
-    mesh_select_cell_threshold_->SetUpperThreshold(selected_cell_id_);
-    current = mesh_select_cell_threshold_->GetOutputPort();
-  } else if (mode == 1) {
-    mesh_select_entity_dim_threshold_->SetInputData(mesh_grid_);
-    mesh_select_entity_dim_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "entity_dim");
-    mesh_select_entity_dim_threshold_->SetLowerThreshold(selected_entity_dim_);
-    mesh_select_entity_dim_threshold_->SetUpperThreshold(selected_entity_dim_);
-    mesh_select_entity_tag_threshold_->SetInputConnection(
-        mesh_select_entity_dim_threshold_->GetOutputPort());
-    mesh_select_entity_tag_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "entity_tag");
-    mesh_select_entity_tag_threshold_->SetLowerThreshold(selected_entity_tag_);
-    mesh_select_entity_tag_threshold_->SetUpperThreshold(selected_entity_tag_);
-    current = mesh_select_entity_tag_threshold_->GetOutputPort();
-  } else {
-    mesh_select_dim_threshold_->SetInputData(mesh_grid_);
-    mesh_select_dim_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "phys_dim");
-    mesh_select_dim_threshold_->SetLowerThreshold(selected_group_dim_);
-    mesh_select_dim_threshold_->SetUpperThreshold(selected_group_dim_);
-    mesh_select_group_threshold_->SetInputConnection(
-        mesh_select_dim_threshold_->GetOutputPort());
-    mesh_select_group_threshold_->SetInputArrayToProcess(
-        0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "phys_id");
-    mesh_select_group_threshold_->SetLowerThreshold(selected_group_id_);
-    mesh_select_group_threshold_->SetUpperThreshold(selected_group_id_);
-    current = mesh_select_group_threshold_->GetOutputPort();
-  }
-
-  mesh_select_geom_->SetInputConnection(current);
-  mesh_select_mapper_->SetInputConnection(mesh_select_geom_->GetOutputPort());
-  mesh_select_actor_->SetVisibility(true);
-  if (render_window_) {
+  if (update_highlight(&mesh_hover_, query, kHoverColor) && render_window_) {
     render_window_->Render();
   }
+#else
+  Q_UNUSED(x);
+  Q_UNUSED(y);
 #endif
 }
 